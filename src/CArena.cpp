@@ -0,0 +1,75 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <cstdlib>
+#include "CArena.h"
+using namespace sched::schedule;
+
+
+CArena::CArena(size_t blockSize) {
+	mBlockSize = blockSize;
+}
+
+CArena::~CArena() {
+	release();
+}
+
+void* CArena::allocateSlow(size_t size, size_t align) {
+
+	// header and alignment padding have to fit into the block
+	size_t needed = sizeof(SArenaBlock) + size + align;
+	size_t blockSize = mBlockSize;
+	if (blockSize < needed) {
+		blockSize = needed;
+	}
+
+	SArenaBlock* block = (SArenaBlock*) malloc(blockSize);
+	if (block == 0) {
+		throw std::bad_alloc();
+	}
+	block->next = mpBlocks;
+	block->size = blockSize - sizeof(SArenaBlock);
+	mpBlocks = block;
+	mAllocated += blockSize;
+
+	// following blocks grow until the upper limit is reached
+	if (mBlockSize < MAX_BLOCKSIZE) {
+		mBlockSize *= 2;
+	}
+
+	mpCurrent = (char*) (block + 1);
+	mpEnd = mpCurrent + block->size;
+	return allocate(size, align);
+}
+
+void CArena::release() {
+
+	SArenaBlock* block = mpBlocks;
+	while (block != 0) {
+		SArenaBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+	mpBlocks = 0;
+	mpCurrent = 0;
+	mpEnd = 0;
+	mAllocated = 0;
+
+}
+
+bool CArena::owns(const void* ptr) {
+
+	const char* cptr = (const char*) ptr;
+	for (SArenaBlock* block = mpBlocks; block != 0; block = block->next) {
+		const char* start = (const char*) (block + 1);
+		if (cptr >= start && cptr < start + block->size) {
+			return true;
+		}
+	}
+	return false;
+
+}
+
+size_t CArena::allocated() {
+	return mAllocated;
+}
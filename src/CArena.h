@@ -0,0 +1,98 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CARENA_H__
+#define __CARENA_H__
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+namespace sched {
+namespace schedule {
+
+	/// @brief Monotonic memory arena
+	///
+	/// Memory is taken from large blocks by bumping a pointer.
+	/// Single allocations can not be freed, all memory is released at once on destruction or release().
+	/// Destructors of objects inside the arena are never called, therefore only trivially destructible types can be created.
+	/// The arena is not thread-safe, it is meant to be filled by one thread at a time.
+	class CArena {
+
+		private:
+			/// @brief Header of a memory block, the usable memory follows the header
+			struct SArenaBlock {
+				SArenaBlock* next; ///< Previously allocated block
+				size_t size; ///< Usable size of the block
+			};
+
+			static const size_t MAX_BLOCKSIZE = 1024*1024; ///< Upper limit for the size of new blocks
+
+			SArenaBlock* mpBlocks = 0; ///< List of blocks, current block first
+			char* mpCurrent = 0; ///< Next free byte in current block
+			char* mpEnd = 0; ///< End of current block
+			size_t mBlockSize = 0; ///< Size of the next block
+			size_t mAllocated = 0; ///< Sum of allocated block sizes
+
+			/// @brief Allocates a new block and takes the memory from it
+			/// @param size Number of bytes
+			/// @param align Alignment, power of two
+			/// @return Pointer to memory
+			void* allocateSlow(size_t size, size_t align);
+
+		public:
+			/// @param blockSize Size of the first block
+			CArena(size_t blockSize = 16*1024);
+			~CArena();
+
+			CArena(const CArena&) = delete;
+			CArena& operator=(const CArena&) = delete;
+
+			/// @brief Returns uninitialized memory
+			/// @param size Number of bytes
+			/// @param align Alignment, power of two
+			/// @return Pointer to memory
+			inline void* allocate(size_t size, size_t align) {
+				uintptr_t ptr = ((uintptr_t) mpCurrent + align - 1) & ~((uintptr_t) align - 1);
+				if (mpCurrent != 0 && ptr + size <= (uintptr_t) mpEnd) {
+					mpCurrent = (char*) (ptr + size);
+					return (void*) ptr;
+				}
+				return allocateSlow(size, align);
+			}
+
+			/// @brief Creates a value-initialized object
+			/// @return Pointer to object
+			template<typename T>
+			T* create() {
+				static_assert(std::is_trivially_destructible<T>::value, "CArena can only hold trivially destructible types");
+				return new (allocate(sizeof(T), alignof(T))) T();
+			}
+
+			/// @brief Creates an array of value-initialized elements
+			/// @param num Number of elements
+			/// @return Pointer to first element
+			template<typename T>
+			T* createArray(size_t num) {
+				static_assert(std::is_trivially_destructible<T>::value, "CArena can only hold trivially destructible types");
+				T* array = (T*) allocate(sizeof(T) * (num > 0 ? num : 1), alignof(T));
+				for (size_t ix = 0; ix < num; ix++) {
+					new (&(array[ix])) T();
+				}
+				return array;
+			}
+
+			/// @brief Frees all blocks
+			/// All pointers into the arena become invalid.
+			void release();
+
+			/// @brief Checks if the memory belongs to the arena
+			/// @param ptr Pointer to check
+			/// @return True if the pointer points into one of the arena's blocks, else false
+			bool owns(const void* ptr);
+
+			/// @brief Returns the sum of allocated block sizes
+			size_t allocated();
+	};
+
+} }
+#endif
@@ -0,0 +1,121 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "CBatchPolicy.h"
+#include "CConfig.h"
+#include "CLogger.h"
+using namespace sched::schedule;
+
+
+CBatchPolicy::CBatchPolicy(){
+
+	CConfig* config = CConfig::getConfig();
+	int res = 0;
+
+	uint64_t window = 0;
+	res = config->conf->getUint64((char*)"computer_batch_window_ms", &window);
+	if (-1 == res) {
+		CLogger::mainlog->info("BatchPolicy: config key \"computer_batch_window_ms\" not found, using default: 0");
+		window = 0;
+	}
+	mWindow = std::chrono::milliseconds(window);
+
+	uint64_t maxPending = 0;
+	res = config->conf->getUint64((char*)"computer_batch_max_pending", &maxPending);
+	if (-1 == res) {
+		CLogger::mainlog->info("BatchPolicy: config key \"computer_batch_max_pending\" not found, using default: 0");
+		maxPending = 0;
+	}
+	mMaxPending = maxPending;
+
+	double alpha = 0.25;
+	res = config->conf->getDouble((char*)"computer_batch_alpha", &alpha);
+	if (-1 == res) {
+		CLogger::mainlog->info("BatchPolicy: config key \"computer_batch_alpha\" not found, using default: %lf", alpha);
+	}
+	if (alpha <= 0.0 || alpha > 1.0) {
+		CLogger::mainlog->warn("BatchPolicy: invalid \"computer_batch_alpha\" %lf, using default: 0.25", alpha);
+		alpha = 0.25;
+	}
+	mAlpha = alpha;
+
+	if (enabled() == true) {
+		CLogger::mainlog->info("BatchPolicy: batch window %lu ms, max pending %u, alpha %lf", windowMs(), mMaxPending, mAlpha);
+	}
+
+}
+
+bool CBatchPolicy::enabled(){
+
+	return mWindow > std::chrono::steady_clock::duration::zero();
+
+}
+
+unsigned long CBatchPolicy::windowMs(){
+
+	return std::chrono::duration_cast<std::chrono::milliseconds>(mWindow).count();
+
+}
+
+unsigned int CBatchPolicy::maxPending(){
+
+	return mMaxPending;
+
+}
+
+void CBatchPolicy::arrival(std::chrono::steady_clock::time_point now){
+
+	if (mPending == 0) {
+		mFirst = now;
+	}
+	mLast = now;
+	mPending++;
+
+}
+
+unsigned int CBatchPolicy::pending(){
+
+	return mPending;
+
+}
+
+std::chrono::steady_clock::time_point CBatchPolicy::due(){
+
+	if (mMaxPending > 0 && mPending >= mMaxPending) {
+		return mLast;
+	}
+	std::chrono::steady_clock::duration quiet = mWindow;
+	if (mPredicted >= 0.0) {
+		std::chrono::steady_clock::duration runtime = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(mPredicted));
+		if (runtime < quiet) {
+			quiet = runtime;
+		}
+	}
+	std::chrono::steady_clock::time_point quietEnd = mLast + quiet;
+	std::chrono::steady_clock::time_point windowEnd = mFirst + mWindow;
+	return quietEnd < windowEnd ? quietEnd : windowEnd;
+
+}
+
+void CBatchPolicy::start(){
+
+	mPending = 0;
+
+}
+
+void CBatchPolicy::observe(std::chrono::steady_clock::duration runtime){
+
+	double seconds = std::chrono::duration<double>(runtime).count();
+	if (mPredicted < 0.0) {
+		mPredicted = seconds;
+	} else {
+		mPredicted = mAlpha * seconds + (1.0 - mAlpha) * mPredicted;
+	}
+
+}
+
+double CBatchPolicy::predicted(){
+
+	return mPredicted;
+
+}
@@ -0,0 +1,65 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CBATCHPOLICY_H__
+#define __CBATCHPOLICY_H__
+#include <chrono>
+namespace sched {
+namespace schedule {
+
+	/// @brief Coalesces schedule update requests into one computation
+	///
+	/// Update requests (task arrivals) are pending until the computation is due.
+	/// The computation is due if no request arrived for the quiet period,
+	/// if the first pending request waited for the batch window,
+	/// or if the maximum number of pending requests is reached.
+	/// The quiet period is the predicted algorithm runtime, limited by the batch window,
+	/// before the first observed runtime it is the batch window.
+	/// Requests arriving further apart than the algorithm runtime do not interrupt each other's computation,
+	/// so longer waiting only delays the schedule.
+	/// The runtime is predicted by an exponentially weighted moving average (EWMA) of the observed runtimes.
+	///
+	/// The policy does not lock, the owner serializes the calls.
+	/// The times are passed by the caller, so the simulation applies the policy to simulated time.
+	class CBatchPolicy {
+
+		private:
+			std::chrono::steady_clock::duration mWindow; ///< Maximum delay of a pending request, zero if batching is disabled
+			unsigned int mMaxPending = 0; ///< Number of pending requests that are computed immediately, 0 if unlimited
+			double mAlpha = 0.25; ///< EWMA weight of the last observed runtime
+			double mPredicted = -1.0; ///< Predicted algorithm runtime in seconds, negative without observation
+			unsigned int mPending = 0; ///< Number of pending requests
+			std::chrono::steady_clock::time_point mFirst; ///< Time of the first pending request
+			std::chrono::steady_clock::time_point mLast; ///< Time of the last pending request
+
+		public:
+			/// @brief Loads the policy from the configuration
+			CBatchPolicy();
+
+			/// @brief Returns true if the update requests are batched
+			bool enabled();
+			/// @brief Returns the batch window in milliseconds
+			unsigned long windowMs();
+			/// @brief Returns the maximum number of pending requests
+			unsigned int maxPending();
+
+			/// @brief Notes an update request
+			/// @param now Time of the request
+			void arrival(std::chrono::steady_clock::time_point now);
+			/// @brief Returns the number of pending requests
+			unsigned int pending();
+			/// @brief Returns the time at which the computation for the pending requests is due
+			/// Only valid if requests are pending.
+			std::chrono::steady_clock::time_point due();
+			/// @brief Clears the pending requests at the start of a computation
+			void start();
+
+			/// @brief Adds an observed algorithm runtime to the prediction
+			/// @param runtime Duration of the schedule computation
+			void observe(std::chrono::steady_clock::duration runtime);
+			/// @brief Returns the predicted algorithm runtime in seconds, negative without observation
+			double predicted();
+	};
+
+} }
+#endif
@@ -0,0 +1,299 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <limits>
+#include "CCompletionQueue.h"
+#include "CTaskCopy.h"
+#include "CResource.h"
+#include "CEstimation.h"
+#include "CEstimationMatrix.h"
+#include "CScheduleExt.h"
+using namespace sched::algorithm;
+
+
+template <enum EQueueOrder Order, bool Running>
+CCompletionQueue<Order, Running>::CCompletionQueue(CScheduleExt* pSchedule, std::vector<CResource*>& rResources, std::vector<CTaskCopy>* pTasks, CEstimationMatrix* pMatrix, CEstimation* pEstimation)
+	: mrResources(rResources)
+{
+	mpSchedule = pSchedule;
+	mpTasks = pTasks;
+	mpMatrix = pMatrix;
+	mpEstimation = pEstimation;
+
+	int tasks = pTasks->size();
+	int machines = rResources.size();
+
+	mBest.assign(tasks, -1);
+	mSecond.assign(tasks, -1);
+	mBestComp.assign(tasks, 0.0);
+	mKey.assign(tasks, 0.0);
+	mHeapOf.assign(tasks, -1);
+	mHeapPos.assign(tasks, -1);
+	mVisit.assign(tasks, 0);
+	mHeaps.resize(Order == MAX_SUFFERAGE ? machines : 1);
+	mAffected.resize(machines);
+
+	// evaluate ready tasks
+	for (int tix = 0; tix<tasks; tix++) {
+		if (mpSchedule->taskLastPartMapped(tix) == true) {
+			continue;
+		}
+		if (mpSchedule->taskDependencySatisfied(tix) == false) {
+			continue;
+		}
+		evaluate(tix);
+	}
+}
+
+template <enum EQueueOrder Order, bool Running>
+CCompletionQueue<Order, Running>::~CCompletionQueue() {
+}
+
+template <enum EQueueOrder Order, bool Running>
+double CCompletionQueue<Order, Running>::completionTime(int tix, int mix) {
+
+	CResource* res = mrResources[mix];
+	double ready = 0.0;
+	double init = mpMatrix->taskTimeInit(tix, mix);
+
+	if (Running == true) {
+		// ready time for this task on this resource considering running tasks
+		ready = mpSchedule->taskReadyTimeResource(tix, res, mpEstimation);
+		if (mpSchedule->taskRunningResource(tix) == mix &&
+			mpSchedule->resourceTasks(mix) == 0) {
+			// task already running on resource and
+			// slot is first slot
+			init = 0.0;
+		}
+	} else {
+		double resourceReady = mpSchedule->resourceReadyTime(mix);
+		double depReady = mpSchedule->taskReadyTime(tix);
+		ready = (depReady > resourceReady ? depReady : resourceReady);
+	}
+
+	// completion time =
+	// ready time +
+	// init time +
+	// compute time +
+	// fini time
+	return ready +
+		init +
+		mpMatrix->taskTimeCompute(tix, mix) +
+		mpMatrix->taskTimeFini(tix, mix);
+}
+
+template <enum EQueueOrder Order, bool Running>
+void CCompletionQueue<Order, Running>::evaluate(int tix) {
+
+	CTaskCopy* task = &((*mpTasks)[tix]);
+	int machines = mrResources.size();
+	int best = -1;
+	int second = -1;
+	double bestComp = 0.0;
+	double secondComp = 0.0;
+
+	for (int mix = 0; mix<machines; mix++) {
+		if (task->validResource(mrResources[mix]) == false) {
+			continue;
+		}
+		double comp = completionTime(tix, mix);
+		if (best == -1 || comp < bestComp) {
+			second = best;
+			secondComp = bestComp;
+			best = mix;
+			bestComp = comp;
+		} else
+		if (second == -1 || comp < secondComp) {
+			second = mix;
+			secondComp = comp;
+		}
+	}
+	if (best == -1) {
+		// no compatible resource
+		best = 0;
+		bestComp = 0.0;
+	}
+
+	mBest[tix] = best;
+	mSecond[tix] = second;
+	mBestComp[tix] = bestComp;
+
+	// register for changes of the resources the key depends on
+	if (best < machines) {
+		mAffected[best].push_back(tix);
+	}
+
+	int hix = 0;
+	if (Order == MAX_SUFFERAGE) {
+		hix = best;
+		if (second != -1) {
+			mAffected[second].push_back(tix);
+			mKey[tix] = secondComp - bestComp;
+		} else {
+			// task can only run on one resource
+			mKey[tix] = std::numeric_limits<double>::max() - bestComp;
+		}
+	} else {
+		mKey[tix] = bestComp;
+	}
+
+	if (mHeapOf[tix] == hix) {
+		heapUp(hix, mHeapPos[tix]);
+		heapDown(hix, mHeapPos[tix]);
+		return;
+	}
+	if (mHeapOf[tix] != -1) {
+		heapRemove(tix);
+	}
+	if (hix < (int) mHeaps.size()) {
+		heapInsert(hix, tix);
+	}
+}
+
+template <enum EQueueOrder Order, bool Running>
+int CCompletionQueue<Order, Running>::top(int* pMix) {
+
+	if (mHeaps[0].size() == 0) {
+		return -1;
+	}
+	int tix = mHeaps[0][0];
+	*pMix = mBest[tix];
+	return tix;
+}
+
+template <enum EQueueOrder Order, bool Running>
+int CCompletionQueue<Order, Running>::topResource(int mix) {
+
+	if (mHeaps[mix].size() == 0) {
+		return -1;
+	}
+	return mHeaps[mix][0];
+}
+
+template <enum EQueueOrder Order, bool Running>
+double CCompletionQueue<Order, Running>::bestCompletionTime(int tix) {
+	return mBestComp[tix];
+}
+
+template <enum EQueueOrder Order, bool Running>
+void CCompletionQueue<Order, Running>::update(int tix, int mix) {
+
+	if (mHeapOf[tix] != -1) {
+		heapRemove(tix);
+	}
+	mUpdate++;
+
+	// recompute tasks whose best or second best resource changed
+	mScratch.swap(mAffected[mix]);
+	for (int atix : mScratch) {
+		if (mVisit[atix] == mUpdate || mHeapOf[atix] == -1) {
+			// already recomputed or no longer queued
+			continue;
+		}
+		if (mBest[atix] != mix &&
+			(Order != MAX_SUFFERAGE || mSecond[atix] != mix)) {
+			// stale entry
+			continue;
+		}
+		mVisit[atix] = mUpdate;
+		evaluate(atix);
+	}
+	mScratch.clear();
+
+	if (mpSchedule->taskLastPartMapped(tix) == false) {
+		return;
+	}
+
+	// add successors freed from their dependencies
+	CTaskCopy* task = &((*mpTasks)[tix]);
+	for (int six=0; six<task->mSuccessorNum; six++) {
+		int stix = mpSchedule->taskIndexById(task->mpSuccessorList[six]);
+		if (stix == -1 || mHeapOf[stix] != -1) {
+			continue;
+		}
+		if (mpSchedule->taskLastPartMapped(stix) == true) {
+			continue;
+		}
+		if (mpSchedule->taskDependencySatisfied(stix) == true) {
+			evaluate(stix);
+		}
+	}
+}
+
+template <enum EQueueOrder Order, bool Running>
+void CCompletionQueue<Order, Running>::heapSet(int hix, int pos, int tix) {
+	mHeaps[hix][pos] = tix;
+	mHeapPos[tix] = pos;
+}
+
+template <enum EQueueOrder Order, bool Running>
+void CCompletionQueue<Order, Running>::heapUp(int hix, int pos) {
+
+	std::vector<int>& heap = mHeaps[hix];
+	int tix = heap[pos];
+	while (pos > 0) {
+		int parent = (pos - 1) / 2;
+		if (before(tix, heap[parent]) == false) {
+			break;
+		}
+		heapSet(hix, pos, heap[parent]);
+		pos = parent;
+	}
+	heapSet(hix, pos, tix);
+}
+
+template <enum EQueueOrder Order, bool Running>
+void CCompletionQueue<Order, Running>::heapDown(int hix, int pos) {
+
+	std::vector<int>& heap = mHeaps[hix];
+	int size = heap.size();
+	int tix = heap[pos];
+	while (true) {
+		int child = 2 * pos + 1;
+		if (child >= size) {
+			break;
+		}
+		if (child + 1 < size && before(heap[child + 1], heap[child]) == true) {
+			child++;
+		}
+		if (before(heap[child], tix) == false) {
+			break;
+		}
+		heapSet(hix, pos, heap[child]);
+		pos = child;
+	}
+	heapSet(hix, pos, tix);
+}
+
+template <enum EQueueOrder Order, bool Running>
+void CCompletionQueue<Order, Running>::heapInsert(int hix, int tix) {
+
+	mHeaps[hix].push_back(tix);
+	mHeapOf[tix] = hix;
+	heapUp(hix, mHeaps[hix].size() - 1);
+}
+
+template <enum EQueueOrder Order, bool Running>
+void CCompletionQueue<Order, Running>::heapRemove(int tix) {
+
+	int hix = mHeapOf[tix];
+	int pos = mHeapPos[tix];
+	std::vector<int>& heap = mHeaps[hix];
+	int last = heap.back();
+	heap.pop_back();
+	mHeapOf[tix] = -1;
+	mHeapPos[tix] = -1;
+	if (pos < (int) heap.size()) {
+		heapSet(hix, pos, last);
+		heapUp(hix, pos);
+		heapDown(hix, mHeapPos[last]);
+	}
+}
+
+// instances used by the MinMin2, MaxMin2 and Sufferage2 algorithms and their Dyn variants
+template class sched::algorithm::CCompletionQueue<MIN_COMPLETION, false>;
+template class sched::algorithm::CCompletionQueue<MIN_COMPLETION, true>;
+template class sched::algorithm::CCompletionQueue<MAX_COMPLETION, false>;
+template class sched::algorithm::CCompletionQueue<MAX_COMPLETION, true>;
+template class sched::algorithm::CCompletionQueue<MAX_SUFFERAGE, false>;
+template class sched::algorithm::CCompletionQueue<MAX_SUFFERAGE, true>;
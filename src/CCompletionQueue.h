@@ -0,0 +1,138 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CCOMPLETIONQUEUE_H__
+#define __CCOMPLETIONQUEUE_H__
+#include <vector>
+namespace sched {
+namespace schedule {
+	class CResource;
+	class CScheduleExt;
+} }
+
+namespace sched {
+namespace task {
+	class CTaskCopy;
+} }
+
+namespace sched {
+namespace algorithm {
+
+	using sched::schedule::CResource;
+	using sched::schedule::CScheduleExt;
+	using sched::task::CTaskCopy;
+
+	class CEstimation;
+	class CEstimationMatrix;
+
+	/// @brief Order of a completion queue
+	enum EQueueOrder {
+		MIN_COMPLETION = 0, ///< Earliest best completion time first (MinMin)
+		MAX_COMPLETION = 1, ///< Latest best completion time first (MaxMin)
+		MAX_SUFFERAGE = 2 ///< Largest sufferage first, one heap per best resource (Sufferage)
+	};
+
+	/// @brief Incremental completion time queue for the MinMin, MaxMin and Sufferage heuristics
+	///
+	/// For every ready and unmapped task the best and second best completion time over its valid resources is kept.
+	/// MinMin and MaxMin order the tasks in one indexed binary heap by their best completion time,
+	/// Sufferage keeps one heap per resource with the tasks that complete earliest on this resource, ordered by their sufferage.
+	/// Completion times on a resource only change when a task is added to this resource and never decrease.
+	/// Therefore after an assignment only the tasks whose best or second best resource is the changed resource are recomputed,
+	/// all other tasks keep their keys.
+	/// Ties are broken by the smallest task index and the smallest resource index.
+	///
+	/// Queue order and running task handling are template parameters,
+	/// so the per evaluation checks are resolved at compile time.
+	/// The instances for all orders with and without running tasks are compiled in CCompletionQueue.cpp.
+	/// @tparam Order Queue order
+	/// @tparam Running If true, ready times consider running tasks and tasks continuing on their resource omit the init time
+	template <enum EQueueOrder Order, bool Running>
+	class CCompletionQueue {
+
+		private:
+			CScheduleExt* mpSchedule;
+			std::vector<CResource*>& mrResources; ///< List of resources
+			std::vector<CTaskCopy>* mpTasks; ///< List of tasks
+			CEstimationMatrix* mpMatrix;
+			CEstimation* mpEstimation;
+
+			std::vector<int> mBest; ///< Resource with best completion time, by task index
+			std::vector<int> mSecond; ///< Resource with second best completion time or -1, by task index
+			std::vector<double> mBestComp; ///< Best completion time, by task index
+			std::vector<double> mKey; ///< Heap key, by task index
+			std::vector<int> mHeapOf; ///< Heap containing the task or -1, by task index
+			std::vector<int> mHeapPos; ///< Position inside the heap, by task index
+			std::vector<unsigned int> mVisit; ///< Last update that recomputed the task, by task index
+			unsigned int mUpdate = 0; ///< Number of updates
+
+			std::vector<std::vector<int>> mHeaps; ///< Task indices in heap order, one heap or one per resource
+			std::vector<std::vector<int>> mAffected; ///< Tasks to recompute on change, by resource, may contain stale entries
+			std::vector<int> mScratch; ///< Affected list in process
+
+			/// @brief Computes the completion time of a task on a resource for the current schedule
+			/// @param tix Task index
+			/// @param mix Resource index
+			/// @return Completion time
+			double completionTime(int tix, int mix);
+
+			/// @brief Recomputes best and second best resource of a task and updates its heap position
+			/// @param tix Task index
+			void evaluate(int tix);
+
+			/// @brief Compares two tasks by heap order
+			/// @return True if task a has to be selected before task b
+			inline bool before(int a, int b) {
+				if (Order == MIN_COMPLETION) {
+					if (mKey[a] != mKey[b]) {
+						return mKey[a] < mKey[b];
+					}
+				} else {
+					if (mKey[a] != mKey[b]) {
+						return mKey[a] > mKey[b];
+					}
+				}
+				return a < b;
+			}
+
+			void heapInsert(int hix, int tix);
+			void heapRemove(int tix);
+			void heapUp(int hix, int pos);
+			void heapDown(int hix, int pos);
+			void heapSet(int hix, int pos, int tix);
+
+		public:
+			/// @brief Evaluates all ready tasks of the schedule
+			/// @param pSchedule Schedule to fill
+			/// @param rResources List of resources
+			/// @param pTasks List of tasks
+			/// @param pMatrix Estimation matrix for the task list
+			/// @param pEstimation Estimation object, used for ready times of running tasks
+			CCompletionQueue(CScheduleExt* pSchedule, std::vector<CResource*>& rResources, std::vector<CTaskCopy>* pTasks, CEstimationMatrix* pMatrix, CEstimation* pEstimation);
+			~CCompletionQueue();
+
+			/// @brief Returns the first task of the queue
+			/// Only for MIN_COMPLETION and MAX_COMPLETION.
+			/// @param[out] pMix Resource with the best completion time
+			/// @return Task index or -1 if no task is ready
+			int top(int* pMix);
+
+			/// @brief Returns the task with the largest sufferage among the tasks completing earliest on the resource
+			/// Only for MAX_SUFFERAGE.
+			/// @param mix Resource index
+			/// @return Task index or -1 if no task completes earliest on the resource
+			int topResource(int mix);
+
+			/// @brief Returns the best completion time of a queued task
+			/// @param tix Task index
+			double bestCompletionTime(int tix);
+
+			/// @brief Updates the queue after a task was added to the schedule
+			/// Removes the task, recomputes tasks affected by the changed resource and adds tasks freed from their dependencies.
+			/// @param tix Task index
+			/// @param mix Resource index
+			void update(int tix, int mix);
+	};
+
+} }
+#endif
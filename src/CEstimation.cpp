@@ -1,15 +1,78 @@
 // Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
 // SPDX-License-Identifier: BSD-2-Clause
 
+#include <cstring>
 #include "CEstimation.h"
 #include "CEstimationLinear.h"
+#include "CEstimationTable.h"
+#include "CEstimationRegression.h"
+#include "CEstimationFeedback.h"
+#include "CConfig.h"
+#include "CLogger.h"
 using namespace sched::algorithm;
 
 CEstimation::~CEstimation(){
 }
 
+unsigned int CEstimation::getGeneration(){
+	return 0;
+}
+
+unsigned int CEstimation::getGeneration(CTask* task, CResource* res){
+	return 0;
+}
+
+EEstimationType CEstimation::loadEstimationType(){
+
+	CConfig* config = CConfig::getConfig();
+	std::string* estimation_str = 0;
+	int res = config->conf->getString((char*)"estimation", &estimation_str);
+	if (-1 == res) {
+		CLogger::mainlog->info("Estimation: config key \"estimation\" not found, using default: table");
+		return ESTIMATION_TABLE;
+	}
+	const char* estimation = estimation_str->c_str();
+	if (strcmp(estimation, "linear") == 0) {
+		CLogger::mainlog->info("Estimation: use linear");
+		return ESTIMATION_LINEAR;
+	} else
+	if (strcmp(estimation, "table") == 0) {
+		CLogger::mainlog->info("Estimation: use table");
+		return ESTIMATION_TABLE;
+	} else
+	if (strcmp(estimation, "regression") == 0) {
+		CLogger::mainlog->info("Estimation: use regression");
+		return ESTIMATION_REGRESSION;
+	} else
+	if (strcmp(estimation, "feedback") == 0) {
+		CLogger::mainlog->info("Estimation: use feedback");
+		return ESTIMATION_FEEDBACK;
+	}
+	CLogger::mainlog->warn("Estimation: unknown estimation \"%s\", using default: table", estimation);
+	return ESTIMATION_TABLE;
+
+}
+
+EEstimationType CEstimation::getEstimationType(){
+
+	// config is read once, estimations are created for every schedule
+	static EEstimationType type = loadEstimationType();
+	return type;
+
+}
+
 CEstimation* CEstimation::getEstimation(){
 
-	return new CEstimationLinear();
+	switch (getEstimationType()) {
+		case ESTIMATION_LINEAR:
+			return new CEstimationLinear();
+		case ESTIMATION_REGRESSION:
+			return new CEstimationRegression();
+		case ESTIMATION_FEEDBACK:
+			return new CEstimationFeedback();
+		case ESTIMATION_TABLE:
+		default:
+			return new CEstimationTable();
+	}
 
 }
@@ -22,12 +22,24 @@ namespace algorithm {
 
 	using sched::schedule::CResource;
 
+	/// @brief Available estimation implementations
+	enum EEstimationType {
+		ESTIMATION_LINEAR, ///< CEstimationLinear
+		ESTIMATION_TABLE, ///< CEstimationTable
+		ESTIMATION_REGRESSION, ///< CEstimationRegression
+		ESTIMATION_FEEDBACK ///< CEstimationFeedback
+	};
+
 	/// @brief Estimates time and energy consumption of a task execution
 	///
 	/// To control task execution the scheduler has to estimate a task's resource consumption.
 	/// This interface declares the generic questions for this estimation.
 	class CEstimation {
 
+		private:
+			/// @brief Reads the configured estimation type
+			static EEstimationType loadEstimationType();
+
 		public:
 			/// @brief Estimation of the task's init phase duration
 			/// @param task The given task
@@ -88,11 +100,24 @@ namespace algorithm {
 			/// @param res The given resource
 			virtual double resourceIdlePower(CResource* res) = 0;
 
+			/// @brief Number of changes of the estimation model
+			/// Estimations cached outside of this class have to be recomputed if the number changes.
+			virtual unsigned int getGeneration();
+
+			/// @brief Generation of the last change of the estimations of the task on the resource
+			/// Estimations computed while getGeneration() returned this or a larger value are up to date.
+			/// @param task The given task
+			/// @param res The given resource
+			virtual unsigned int getGeneration(CTask* task, CResource* res);
+
 			virtual ~CEstimation();
 
 			/// @brief Returns configured estimation
 			static CEstimation* getEstimation();
 
+			/// @brief Returns configured estimation type
+			static EEstimationType getEstimationType();
+
 	};
 
 } }
@@ -0,0 +1,160 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <map>
+#include "CEstimationFeedback.h"
+#include "CTask.h"
+#include "CResource.h"
+#include "CConfig.h"
+#include "CLogger.h"
+using namespace sched::algorithm;
+
+std::atomic<unsigned int> CEstimationFeedback::sGeneration(0);
+std::atomic<int> CEstimationFeedback::sObserve(1);
+std::mutex CEstimationFeedback::sPendingMutex;
+std::vector<SMSFeedback*> CEstimationFeedback::sPending;
+
+CEstimationFeedback::~CEstimationFeedback(){
+}
+
+double CEstimationFeedback::loadAlpha(){
+
+	double alpha = 0.25;
+	CConfig* config = CConfig::getConfig();
+	int res = config->conf->getDouble((char*)"estimation_feedback_alpha", &alpha);
+	if (-1 == res) {
+		CLogger::mainlog->info("EstimationFeedback: config key \"estimation_feedback_alpha\" not found, using default: %lf", alpha);
+	}
+	if (alpha <= 0.0 || alpha > 1.0) {
+		CLogger::mainlog->warn("EstimationFeedback: invalid \"estimation_feedback_alpha\" %lf, using default: 0.25", alpha);
+		alpha = 0.25;
+	}
+	return alpha;
+
+}
+
+SMSFeedback* CEstimationFeedback::getFactor(CTask* task, CResource* res){
+
+	std::map<std::string, void*>::iterator itattr = task->mpAttributes->find(std::string("msfeedback"));
+	if (itattr == task->mpAttributes->end() || itattr->second == 0) {
+		return 0;
+	}
+	std::map<std::string, SMSFeedback*>* factormap = (std::map<std::string, SMSFeedback*>*) itattr->second;
+
+	std::map<std::string, SMSFeedback*>::iterator itres = factormap->find(res->mName);
+	if (itres == factormap->end()) {
+		return 0;
+	}
+
+	return itres->second;
+}
+
+double CEstimationFeedback::getCorrection(CTask* task, CResource* res){
+
+	SMSFeedback* factor = getFactor(task, res);
+	if (factor == 0) {
+		return 1.0;
+	}
+	return factor->factor.load(std::memory_order_relaxed);
+}
+
+double CEstimationFeedback::taskTimeInit(CTask* task, CResource* res){
+	return CEstimationLinear::taskTimeInit(task, res) * getCorrection(task, res);
+}
+
+double CEstimationFeedback::taskTimeCompute(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint){
+	return CEstimationLinear::taskTimeCompute(task, res, startCheckpoint, stopCheckpoint) * getCorrection(task, res);
+}
+
+double CEstimationFeedback::taskTimeFini(CTask* task, CResource* res){
+	return CEstimationLinear::taskTimeFini(task, res) * getCorrection(task, res);
+}
+
+int CEstimationFeedback::taskTimeComputeCheckpoint(CTask* task, CResource* res, int startCheckpoint, double sec){
+	// a slower task reaches fewer checkpoints in the same time
+	return CEstimationLinear::taskTimeComputeCheckpoint(task, res, startCheckpoint, sec / getCorrection(task, res));
+}
+
+unsigned int CEstimationFeedback::getGeneration(){
+	return sGeneration.load(std::memory_order_acquire);
+}
+
+unsigned int CEstimationFeedback::getGeneration(CTask* task, CResource* res){
+
+	SMSFeedback* factor = getFactor(task, res);
+	if (factor == 0) {
+		return 0;
+	}
+	return factor->generation.load(std::memory_order_acquire);
+}
+
+void CEstimationFeedback::applyObservations(){
+
+	std::lock_guard<std::mutex> lg(sPendingMutex);
+	if (sPending.empty() == true) {
+		return;
+	}
+
+	// an observation after the pending flag is cleared queues the factor again
+	unsigned int generation = sGeneration.load(std::memory_order_relaxed) + 1;
+	for (SMSFeedback* factor : sPending) {
+		factor->pending.store(false);
+		factor->factor.store(factor->observed.load(), std::memory_order_relaxed);
+		factor->generation.store(generation, std::memory_order_relaxed);
+	}
+	CLogger::mainlog->debug("EstimationFeedback: applied %lu factors, generation %u", sPending.size(), generation);
+	sPending.clear();
+	sGeneration.store(generation, std::memory_order_release);
+}
+
+void CEstimationFeedback::setObserve(int observe){
+	sObserve.store(observe, std::memory_order_relaxed);
+}
+
+void CEstimationFeedback::observe(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint, double sec){
+
+	static double alpha = loadAlpha();
+
+	if (sObserve.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+
+	SMSFeedback* factor = getFactor(task, res);
+	double* results = getResults(task, res);
+	if (factor == 0 || results == 0 || task->mCheckpoints == 0) {
+		return;
+	}
+
+	// uncorrected estimation of the observed execution
+	double estimated =
+		results[4] +
+		(results[5] / task->mCheckpoints) * (stopCheckpoint-startCheckpoint) +
+		results[6];
+	if (estimated <= 0.0 || sec <= 0.0) {
+		return;
+	}
+
+	// limit the influence of single outliers
+	double ratio = sec / estimated;
+	if (ratio < 0.1) {
+		ratio = 0.1;
+	}
+	if (ratio > 10.0) {
+		ratio = 10.0;
+	}
+
+	double oldFactor = factor->observed.load(std::memory_order_relaxed);
+	double newFactor = 0.0;
+	do {
+		newFactor = (1.0 - alpha) * oldFactor + alpha * ratio;
+	} while (factor->observed.compare_exchange_weak(oldFactor, newFactor, std::memory_order_relaxed) == false);
+
+	// the factor is applied before the next computation
+	if (factor->pending.exchange(true) == false) {
+		std::lock_guard<std::mutex> lg(sPendingMutex);
+		sPending.push_back(factor);
+	}
+
+	CLogger::mainlog->debug("EstimationFeedback: task %d %s(%ld) on %s checkpoints %d-%d observed %lf estimated %lf factor %lf",
+		task->mId, task->mpName->c_str(), task->mSize, res->mName.c_str(), startCheckpoint, stopCheckpoint, sec, estimated, newFactor);
+}
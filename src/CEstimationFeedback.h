@@ -0,0 +1,75 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CESTIMATIONFEEDBACK_H__
+#define __CESTIMATIONFEEDBACK_H__
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "CEstimationLinear.h"
+#include "CTaskLoaderMS.h"
+namespace sched {
+namespace algorithm {
+
+	using sched::task::SMSFeedback;
+
+	/// @brief Estimation class correcting the linear estimation with observed task durations
+	///
+	/// Keeps an exponentially weighted correction factor per task name, size and resource.
+	/// The factors are stored by CTaskLoaderMS and attached to the tasks as "msfeedback".
+	/// Resources report the observed duration of every task execution at any time.
+	/// Observations are collected and applied to the factors by applyObservations() between schedule computations,
+	/// so one computation uses the same factors throughout and corrections apply to later computations.
+	/// Every factor remembers the generation of its last change, so cached estimations of other tasks stay valid.
+	/// Only time estimations are corrected.
+	class CEstimationFeedback : public CEstimationLinear {
+
+		private:
+			static std::atomic<unsigned int> sGeneration; ///< Number of applications that changed factors, factors store the value of their last change
+			static std::atomic<int> sObserve; ///< 1 if observations are used
+			static std::mutex sPendingMutex; ///< Protects sPending
+			static std::vector<SMSFeedback*> sPending; ///< Factors with observations that are not applied yet
+
+			/// @brief Reads the configured weight of new observations
+			static double loadAlpha();
+
+			/// @brief Returns the correction factor of the task for the given resource
+			/// @param task The given task
+			/// @param res The given resource
+			/// @return Factor pointer or 0 if no factor is available
+			static SMSFeedback* getFactor(CTask* task, CResource* res);
+
+			/// @brief Returns the current correction of the task for the given resource
+			double getCorrection(CTask* task, CResource* res);
+
+		public:
+			~CEstimationFeedback();
+
+			double taskTimeInit(CTask* task, CResource* res);
+			double taskTimeCompute(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint);
+			double taskTimeFini(CTask* task, CResource* res);
+			int taskTimeComputeCheckpoint(CTask* task, CResource* res, int startCheckpoint, double sec);
+
+			unsigned int getGeneration();
+			unsigned int getGeneration(CTask* task, CResource* res);
+
+			/// @brief Updates the observed correction with a task execution
+			/// The correction is used by estimations after the next applyObservations().
+			/// @param task The executed task
+			/// @param res The resource the task ran on
+			/// @param startCheckpoint Checkpoint at the start of the execution
+			/// @param stopCheckpoint Checkpoint at the end of the execution
+			/// @param sec Observed duration including init and fini phase
+			static void observe(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint, double sec);
+
+			/// @brief Applies the observations since the last call to the correction factors
+			/// Called by the schedule computer before a computation, must not run concurrently with a computation.
+			static void applyObservations();
+
+			/// @brief Enables or disables observations
+			/// @param observe 1 to use observations, 0 to ignore them
+			static void setObserve(int observe);
+	};
+
+} }
+#endif
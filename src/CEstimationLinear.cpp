@@ -7,15 +7,28 @@
 #include "CResource.h"
 using namespace sched::algorithm;
 
-double CEstimationLinear::taskTimeInit(CTask* task, CResource* res) {
-	std::map<std::string, double*>* resmap = 0;
-	resmap = (std::map<std::string, double*>*) (*task->mpAttributes)[std::string("msresults")];
+double* CEstimationLinear::getResults(CTask* task, CResource* res, const char* attribute) {
 
-	if (resmap == 0) {
-		return 0.0;
+	std::map<std::string, void*>::iterator itattr = task->mpAttributes->find(std::string(attribute));
+	if (itattr == task->mpAttributes->end() || itattr->second == 0) {
+		return 0;
+	}
+	std::map<std::string, double*>* resmap = (std::map<std::string, double*>*) itattr->second;
+
+	std::map<std::string, double*>::iterator itres = resmap->find(res->mName);
+	if (itres == resmap->end()) {
+		return 0;
 	}
 
-	double* results = (*resmap)[res->mName];
+	return itres->second;
+}
+
+double* CEstimationLinear::findResults(CTask* task, CResource* res) {
+	return getResults(task, res);
+}
+
+double CEstimationLinear::taskTimeInit(CTask* task, CResource* res) {
+	double* results = findResults(task, res);
 	if (results == 0) {
 		return 0.0;
 	}
@@ -25,14 +38,7 @@ double CEstimationLinear::taskTimeInit(CTask* task, CResource* res) {
 
 double CEstimationLinear::taskTimeCompute(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint) {
 
-	std::map<std::string, double*>* resmap = 0;
-	resmap = (std::map<std::string, double*>*) (*task->mpAttributes)[std::string("msresults")];
-
-	if (resmap == 0) {
-		return 0.0;
-	}
-
-	double* results = (*resmap)[res->mName];
+	double* results = findResults(task, res);
 	if (results == 0) {
 		return 0.0;
 	}
@@ -42,14 +48,7 @@ double CEstimationLinear::taskTimeCompute(CTask* task, CResource* res, int start
 
 double CEstimationLinear::taskTimeFini(CTask* task, CResource* res) {
 
-	std::map<std::string, double*>* resmap = 0;
-	resmap = (std::map<std::string, double*>*) (*task->mpAttributes)[std::string("msresults")];
-
-	if (resmap == 0) {
-		return 0.0;
-	}
-
-	double* results = (*resmap)[res->mName];
+	double* results = findResults(task, res);
 	if (results == 0) {
 		return 0.0;
 	}
@@ -60,14 +59,7 @@ double CEstimationLinear::taskTimeFini(CTask* task, CResource* res) {
 
 int CEstimationLinear::taskTimeComputeCheckpoint(CTask* task, CResource* res, int startCheckpoint, double sec) {
 
-	std::map<std::string, double*>* resmap = 0;
-	resmap = (std::map<std::string, double*>*) (*task->mpAttributes)[std::string("msresults")];
-
-	if (resmap == 0) {
-		return 0;
-	}
-
-	double* results = (*resmap)[res->mName];
+	double* results = findResults(task, res);
 	if (results == 0) {
 		return 0;
 	}
@@ -87,14 +79,7 @@ double CEstimationLinear::taskEnergyInit(CTask* task, CResource* res) {
 
 double CEstimationLinear::taskEnergyCompute(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint) {
 
-	std::map<std::string, double*>* resmap = 0;
-	resmap = (std::map<std::string, double*>*) (*task->mpAttributes)[std::string("msresults")];
-
-	if (resmap == 0) {
-		return 0.0;
-	}
-
-	double* results = (*resmap)[res->mName];
+	double* results = findResults(task, res);
 	if (results == 0) {
 		return 0.0;
 	}
@@ -110,14 +95,7 @@ double CEstimationLinear::taskEnergyFini(CTask* task, CResource* res) {
 
 int CEstimationLinear::taskEnergyComputeCheckpoint(CTask* task, CResource* res, int startCheckpoint, double energy) {
 
-	std::map<std::string, double*>* resmap = 0;
-	resmap = (std::map<std::string, double*>*) (*task->mpAttributes)[std::string("msresults")];
-
-	if (resmap == 0) {
-		return 0;
-	}
-
-	double* results = (*resmap)[res->mName];
+	double* results = findResults(task, res);
 	if (results == 0) {
 		return 0;
 	}
@@ -13,6 +13,20 @@ namespace algorithm {
 	/// For partial execution of tasks linear interpolation is used to calculate the fraction of time or energy.
 	class CEstimationLinear : public CEstimation {
 
+		protected:
+			/// @brief Looks up the measurement results of the task for the given resource
+			/// @param task The given task
+			/// @param res The resource the task will run on
+			/// @param attribute Task attribute holding the results by resource name
+			/// @return Array of measurement results or 0 if none are available
+			static double* getResults(CTask* task, CResource* res, const char* attribute = "msresults");
+
+			/// @brief Returns the results the estimations are based on
+			/// @param task The given task
+			/// @param res The resource the task will run on
+			/// @return Array of measurement results or 0 if none are available
+			virtual double* findResults(CTask* task, CResource* res);
+
 		public:
 			~CEstimationLinear();
 
@@ -0,0 +1,142 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "CEstimationMatrix.h"
+#include "CEstimation.h"
+#include "CTaskCopy.h"
+#include "CResource.h"
+#include "CLogger.h"
+using namespace sched::algorithm;
+
+
+CEstimationMatrix::CEstimationMatrix(std::vector<CResource*>& rResources):
+	mrResources(rResources)
+{
+	mpEstimation = CEstimation::getEstimation();
+}
+
+CEstimationMatrix::~CEstimationMatrix() {
+
+	clear();
+	delete mpEstimation;
+	mpEstimation = 0;
+
+}
+
+void CEstimationMatrix::clear() {
+
+	std::unordered_map<int, SEstimationMatrixRow*>::iterator it = mRows.begin();
+	for (; it != mRows.end(); it++) {
+		delete[] it->second->values;
+		delete it->second;
+	}
+	mRows.clear();
+	mView.clear();
+
+}
+
+void CEstimationMatrix::computeRow(SEstimationMatrixRow* row, CTaskCopy* task) {
+
+	int machines = mrResources.size();
+
+	row->progress = task->mProgress;
+	row->estimationGeneration = mEstimationGeneration;
+	for (int mix = 0; mix < machines; mix++) {
+		CResource* res = mrResources[mix];
+		double* values = &(row->values[mix * ESTIMATIONMATRIX_FIELDS]);
+
+		if (task->validResource(res) == false) {
+			for (int fix = 0; fix < ESTIMATIONMATRIX_FIELDS; fix++) {
+				values[fix] = 0.0;
+			}
+			continue;
+		}
+
+		values[FIELD_TIMEINIT] = mpEstimation->taskTimeInit(task, res);
+		values[FIELD_TIMECOMPUTE] = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
+		values[FIELD_TIMEFINI] = mpEstimation->taskTimeFini(task, res);
+		values[FIELD_TIME] =
+			values[FIELD_TIMEINIT] +
+			values[FIELD_TIMECOMPUTE] +
+			values[FIELD_TIMEFINI];
+		values[FIELD_ENERGYINIT] = mpEstimation->taskEnergyInit(task, res);
+		values[FIELD_ENERGYCOMPUTE] = mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints);
+		values[FIELD_ENERGYFINI] = mpEstimation->taskEnergyFini(task, res);
+		values[FIELD_ENERGY] =
+			values[FIELD_ENERGYINIT] +
+			values[FIELD_ENERGYCOMPUTE] +
+			values[FIELD_ENERGYFINI];
+	}
+
+}
+
+bool CEstimationMatrix::outdatedRow(SEstimationMatrixRow* row, CTaskCopy* task) {
+
+	int machines = mrResources.size();
+
+	for (int mix = 0; mix < machines; mix++) {
+		CResource* res = mrResources[mix];
+		// factors only change between computations, the row holds the values of its generation
+		if (task->validResource(res) == true && mpEstimation->getGeneration(task, res) > row->estimationGeneration) {
+			return true;
+		}
+	}
+	return false;
+
+}
+
+void CEstimationMatrix::update(std::vector<CTaskCopy>* pTasks) {
+
+	int tasks = pTasks->size();
+	int machines = mrResources.size();
+	int computed = 0;
+
+	// estimations of unchanged tasks may have changed
+	unsigned int estimationGeneration = mpEstimation->getGeneration();
+	bool estimationChanged = (estimationGeneration != mEstimationGeneration);
+	mEstimationGeneration = estimationGeneration;
+
+	mGeneration++;
+	mView.resize(tasks);
+
+	for (int tix = 0; tix < tasks; tix++) {
+		CTaskCopy* task = &((*pTasks)[tix]);
+		SEstimationMatrixRow* row = 0;
+
+		std::unordered_map<int, SEstimationMatrixRow*>::iterator it = mRows.find(task->mId);
+		if (it == mRows.end()) {
+			// new task
+			row = new SEstimationMatrixRow();
+			row->values = new double[machines * ESTIMATIONMATRIX_FIELDS]();
+			mRows[task->mId] = row;
+			computeRow(row, task);
+			computed++;
+		} else {
+			row = it->second;
+			if (row->progress != task->mProgress || (estimationChanged == true && outdatedRow(row, task) == true)) {
+				// task progressed or estimation changed since last update
+				computeRow(row, task);
+				computed++;
+			}
+		}
+		row->generation = mGeneration;
+		mView[tix] = row;
+	}
+
+	// remove rows of finished tasks
+	int removed = 0;
+	std::unordered_map<int, SEstimationMatrixRow*>::iterator it = mRows.begin();
+	while (it != mRows.end()) {
+		if (it->second->generation != mGeneration) {
+			delete[] it->second->values;
+			delete it->second;
+			it = mRows.erase(it);
+			removed++;
+		} else {
+			it++;
+		}
+	}
+
+	CLogger::mainlog->debug("EstimationMatrix: %d tasks, %d rows computed, %d rows removed", tasks, computed, removed);
+
+}
@@ -0,0 +1,134 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CESTIMATIONMATRIX_H__
+#define __CESTIMATIONMATRIX_H__
+#include <vector>
+#include <unordered_map>
+namespace sched {
+namespace schedule {
+	class CResource;
+} }
+
+
+namespace sched {
+namespace task {
+	class CTaskCopy;
+} }
+
+
+namespace sched {
+namespace algorithm {
+
+	using sched::schedule::CResource;
+
+	using sched::task::CTaskCopy;
+
+	class CEstimation;
+
+	/// @brief Estimations of the remaining work of one task on all resources
+	struct SEstimationMatrixRow {
+		long progress = 0; ///< Task progress the estimations were computed for
+		unsigned int generation = 0; ///< Last update the task was part of
+		unsigned int estimationGeneration = 0; ///< Estimation model generation the values were computed with
+		double* values = 0; ///< Estimations, ESTIMATIONMATRIX_FIELDS values per resource
+	};
+
+	/// @brief Cached execution time (ETC) and energy matrix of the unfinished tasks
+	///
+	/// Estimates the time and energy for the remaining checkpoints of every task on every resource.
+	/// Rows are stored by task id and survive between schedule computations.
+	/// An update only computes rows for new tasks and tasks whose progress changed,
+	/// rows of tasks that are no longer part of the task list (finished tasks) are dropped.
+	/// If the estimation model changed since the last update, rows are recomputed if the estimation
+	/// of their task changed on any resource.
+	/// After an update the matrix can be accessed by task index and resource index of the given task list.
+	/// Entries of incompatible task/resource combinations are 0.
+	class CEstimationMatrix {
+
+		private:
+			/// @brief Field offsets within the values of one resource
+			enum EEstimationMatrixField {
+				FIELD_TIMEINIT = 0,
+				FIELD_TIMECOMPUTE = 1,
+				FIELD_TIMEFINI = 2,
+				FIELD_TIME = 3,
+				FIELD_ENERGYINIT = 4,
+				FIELD_ENERGYCOMPUTE = 5,
+				FIELD_ENERGYFINI = 6,
+				FIELD_ENERGY = 7,
+				ESTIMATIONMATRIX_FIELDS = 8
+			};
+
+			std::vector<CResource*>& mrResources; ///< List of resources
+			CEstimation* mpEstimation = 0;
+			std::unordered_map<int, SEstimationMatrixRow*> mRows; ///< Rows by task id
+			std::vector<SEstimationMatrixRow*> mView; ///< Rows by task index of the last update
+			unsigned int mGeneration = 0; ///< Number of updates
+			unsigned int mEstimationGeneration = 0; ///< Estimation model generation of the last update
+
+			/// @brief Computes estimations for the remaining work of a task
+			/// @param row Destination row
+			/// @param task The given task
+			void computeRow(SEstimationMatrixRow* row, CTaskCopy* task);
+
+			/// @brief Returns if the estimation of the task changed since the row was computed
+			/// @param row Row of the task
+			/// @param task The given task
+			bool outdatedRow(SEstimationMatrixRow* row, CTaskCopy* task);
+
+		public:
+			/// @param rResources List of resources
+			CEstimationMatrix(std::vector<CResource*>& rResources);
+			~CEstimationMatrix();
+
+			/// @brief Synchronizes the matrix with the given task list
+			/// @param pTasks List of current tasks
+			void update(std::vector<CTaskCopy>* pTasks);
+
+			/// @brief Removes all rows
+			void clear();
+
+			/// @brief Init time of task on resource
+			inline double taskTimeInit(int tix, int mix) {
+				return mView[tix]->values[mix * ESTIMATIONMATRIX_FIELDS + FIELD_TIMEINIT];
+			}
+
+			/// @brief Compute time of the remaining checkpoints of task on resource
+			inline double taskTimeCompute(int tix, int mix) {
+				return mView[tix]->values[mix * ESTIMATIONMATRIX_FIELDS + FIELD_TIMECOMPUTE];
+			}
+
+			/// @brief Fini time of task on resource
+			inline double taskTimeFini(int tix, int mix) {
+				return mView[tix]->values[mix * ESTIMATIONMATRIX_FIELDS + FIELD_TIMEFINI];
+			}
+
+			/// @brief Sum of init, compute and fini time of task on resource
+			inline double taskTime(int tix, int mix) {
+				return mView[tix]->values[mix * ESTIMATIONMATRIX_FIELDS + FIELD_TIME];
+			}
+
+			/// @brief Init energy of task on resource
+			inline double taskEnergyInit(int tix, int mix) {
+				return mView[tix]->values[mix * ESTIMATIONMATRIX_FIELDS + FIELD_ENERGYINIT];
+			}
+
+			/// @brief Compute energy of the remaining checkpoints of task on resource
+			inline double taskEnergyCompute(int tix, int mix) {
+				return mView[tix]->values[mix * ESTIMATIONMATRIX_FIELDS + FIELD_ENERGYCOMPUTE];
+			}
+
+			/// @brief Fini energy of task on resource
+			inline double taskEnergyFini(int tix, int mix) {
+				return mView[tix]->values[mix * ESTIMATIONMATRIX_FIELDS + FIELD_ENERGYFINI];
+			}
+
+			/// @brief Sum of init, compute and fini energy of task on resource
+			inline double taskEnergy(int tix, int mix) {
+				return mView[tix]->values[mix * ESTIMATIONMATRIX_FIELDS + FIELD_ENERGY];
+			}
+	};
+
+} }
+#endif
@@ -0,0 +1,19 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "CEstimationRegression.h"
+using namespace sched::algorithm;
+
+CEstimationRegression::~CEstimationRegression(){
+}
+
+double* CEstimationRegression::findResults(CTask* task, CResource* res) {
+
+	double* results = getResults(task, res);
+	if (results != 0) {
+		return results;
+	}
+
+	// no measurement for this size, use evaluated regression models
+	return getResults(task, res, "msregression");
+}
@@ -0,0 +1,26 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CESTIMATIONREGRESSION_H__
+#define __CESTIMATIONREGRESSION_H__
+#include "CEstimationTable.h"
+namespace sched {
+namespace algorithm {
+
+	/// @brief Estimation class using regression models for unmeasured problem sizes
+	///
+	/// Uses the measurement results if the task's size was measured.
+	/// Otherwise the results of the regression models fitted by CTaskLoaderMS are used,
+	/// which are evaluated once per task size when the task is registered.
+	/// Lookups are cached in the flat table of CEstimationTable.
+	class CEstimationRegression : public CEstimationTable {
+
+		protected:
+			double* findResults(CTask* task, CResource* res);
+
+		public:
+			~CEstimationRegression();
+	};
+
+} }
+#endif
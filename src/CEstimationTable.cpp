@@ -0,0 +1,223 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <cstdlib>
+#include <cstring>
+#include "CEstimationTable.h"
+#include "CLogger.h"
+using namespace sched::algorithm;
+
+CEstimationTable::CEstimationTable() {
+
+	for (int i=0; i<BLOCKS; i++) {
+		mBlocks[i].store(0, std::memory_order_relaxed);
+	}
+
+}
+
+CEstimationTable::~CEstimationTable() {
+
+	for (int i=0; i<BLOCKS; i++) {
+		std::atomic<SEstimationRow*>* block = mBlocks[i].load(std::memory_order_acquire);
+		if (block == 0) {
+			continue;
+		}
+		for (int j=0; j<ROWS_PER_BLOCK; j++) {
+			SEstimationRow* row = block[j].load(std::memory_order_acquire);
+			if (row != 0) {
+				free(row->entries);
+				delete row;
+			}
+		}
+		delete[] block;
+	}
+	for (unsigned int i=0; i<mRetiredRows.size(); i++) {
+		free(mRetiredRows[i]->entries);
+		delete mRetiredRows[i];
+	}
+	mRetiredRows.clear();
+
+}
+
+SEstimationRow* CEstimationTable::createRow(CTask* task, CResource* res, SEstimationRow* oldrow) {
+
+	// row covers all resources of the task and the requested resource
+	int columns = mColumns;
+	if (res->mId + 1 > columns) {
+		columns = res->mId + 1;
+	}
+	if (task->mpResources != 0) {
+		for (unsigned int i=0; i<task->mpResources->size(); i++) {
+			int id = (*task->mpResources)[i]->mId;
+			if (id + 1 > columns) {
+				columns = id + 1;
+			}
+		}
+	}
+	mColumns = columns;
+
+	void* mem = 0;
+	if (posix_memalign(&mem, sizeof(SEstimationEntry), columns * sizeof(SEstimationEntry)) != 0) {
+		CLogger::mainlog->error("EstimationTable: failed to allocate row for task %d", task->mId);
+		return 0;
+	}
+	memset(mem, 0, columns * sizeof(SEstimationEntry));
+
+	SEstimationRow* row = new SEstimationRow();
+	row->columns = columns;
+	row->entries = (SEstimationEntry*) mem;
+	for (int i=0; i<columns; i++) {
+		row->entries[i].valid = -1;
+	}
+
+	if (oldrow != 0) {
+		// keep already resolved entries
+		memcpy(row->entries, oldrow->entries, oldrow->columns * sizeof(SEstimationEntry));
+	} else
+	if (task->mpResources != 0) {
+		// resolve compatible resources
+		for (unsigned int i=0; i<task->mpResources->size(); i++) {
+			CResource* taskres = (*task->mpResources)[i];
+			if (taskres->mId >= 0) {
+				resolveEntry(&(row->entries[taskres->mId]), task, taskres);
+			}
+		}
+	}
+
+	// resolve requested resource, it is not necessarily compatible
+	if (row->entries[res->mId].valid == -1) {
+		resolveEntry(&(row->entries[res->mId]), task, res);
+	}
+
+	return row;
+}
+
+void CEstimationTable::resolveEntry(SEstimationEntry* entry, CTask* task, CResource* res) {
+
+	double* results = findResults(task, res);
+	if (results != 0) {
+		memcpy(entry->results, results, 7 * sizeof(double));
+		entry->valid = 1;
+	} else {
+		entry->valid = 0;
+	}
+}
+
+SEstimationEntry* CEstimationTable::getEntrySlow(CTask* task, CResource* res) {
+
+	int id = task->mId;
+	if (id < 0 || id >= ROWS_PER_BLOCK * BLOCKS || res->mId < 0) {
+		// task or resource can not be stored in the table
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lg(mTableMutex);
+
+	std::atomic<SEstimationRow*>* block = mBlocks[id / ROWS_PER_BLOCK].load(std::memory_order_acquire);
+	if (block == 0) {
+		block = new std::atomic<SEstimationRow*>[ROWS_PER_BLOCK];
+		for (int i=0; i<ROWS_PER_BLOCK; i++) {
+			block[i].store(0, std::memory_order_relaxed);
+		}
+		mBlocks[id / ROWS_PER_BLOCK].store(block, std::memory_order_release);
+	}
+
+	SEstimationRow* row = block[id % ROWS_PER_BLOCK].load(std::memory_order_acquire);
+	if (row == 0 || res->mId >= row->columns || row->entries[res->mId].valid == -1) {
+		// row missing, too narrow or entry not resolved yet
+		// rows are not modified after publication, readers may still use the old row
+		SEstimationRow* newrow = createRow(task, res, row);
+		if (newrow == 0) {
+			return 0;
+		}
+		if (row != 0) {
+			mRetiredRows.push_back(row);
+		}
+		row = newrow;
+		block[id % ROWS_PER_BLOCK].store(row, std::memory_order_release);
+	}
+
+	return &(row->entries[res->mId]);
+}
+
+double CEstimationTable::taskTimeInit(CTask* task, CResource* res) {
+
+	SEstimationEntry* entry = getEntry(task, res);
+	if (entry == 0) {
+		return CEstimationLinear::taskTimeInit(task, res);
+	}
+	if (entry->valid == 0) {
+		return 0.0;
+	}
+
+	return entry->results[4];
+}
+
+double CEstimationTable::taskTimeCompute(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint) {
+
+	SEstimationEntry* entry = getEntry(task, res);
+	if (entry == 0) {
+		return CEstimationLinear::taskTimeCompute(task, res, startCheckpoint, stopCheckpoint);
+	}
+	if (entry->valid == 0) {
+		return 0.0;
+	}
+
+	return (entry->results[5] / task->mCheckpoints) * (stopCheckpoint-startCheckpoint);
+}
+
+double CEstimationTable::taskTimeFini(CTask* task, CResource* res) {
+
+	SEstimationEntry* entry = getEntry(task, res);
+	if (entry == 0) {
+		return CEstimationLinear::taskTimeFini(task, res);
+	}
+	if (entry->valid == 0) {
+		return 0.0;
+	}
+
+	return entry->results[6];
+}
+
+int CEstimationTable::taskTimeComputeCheckpoint(CTask* task, CResource* res, int startCheckpoint, double sec) {
+
+	SEstimationEntry* entry = getEntry(task, res);
+	if (entry == 0) {
+		return CEstimationLinear::taskTimeComputeCheckpoint(task, res, startCheckpoint, sec);
+	}
+	if (entry->valid == 0) {
+		return 0;
+	}
+
+	// elapsed time in seconds / time for one compute checkpoint
+	// return number of reached checkpoints
+	return (int)(sec / (entry->results[5] / task->mCheckpoints));
+}
+
+double CEstimationTable::taskEnergyCompute(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint) {
+
+	SEstimationEntry* entry = getEntry(task, res);
+	if (entry == 0) {
+		return CEstimationLinear::taskEnergyCompute(task, res, startCheckpoint, stopCheckpoint);
+	}
+	if (entry->valid == 0) {
+		return 0.0;
+	}
+
+	// dynamic energy per checkpoint / number of checkpoints
+	return (entry->results[2] / task->mCheckpoints) * (stopCheckpoint-startCheckpoint);
+}
+
+int CEstimationTable::taskEnergyComputeCheckpoint(CTask* task, CResource* res, int startCheckpoint, double energy) {
+
+	SEstimationEntry* entry = getEntry(task, res);
+	if (entry == 0) {
+		return CEstimationLinear::taskEnergyComputeCheckpoint(task, res, startCheckpoint, energy);
+	}
+	if (entry->valid == 0) {
+		return 0;
+	}
+
+	// dynamic energy per checkpoint / number of checkpoints
+	return (int)(energy / (entry->results[2] / task->mCheckpoints));
+}
@@ -0,0 +1,103 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CESTIMATIONTABLE_H__
+#define __CESTIMATIONTABLE_H__
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "CEstimationLinear.h"
+#include "CTask.h"
+#include "CResource.h"
+namespace sched {
+namespace algorithm {
+
+	/// @brief Cached measurement results for one task and resource pair
+	///
+	/// One entry fills exactly one cache line.
+	struct alignas(64) SEstimationEntry {
+		double results[7]; ///< Copy of the egysched measurement results (see CTaskLoaderMS)
+		int valid; ///< 1 if results were found for this pair, 0 if not, -1 if not resolved yet
+	};
+
+	/// @brief Row of the estimation table
+	///
+	/// A row holds the entries of one task for all resources, indexed by CResource::mId.
+	struct SEstimationRow {
+		int columns; ///< Number of entries in this row
+		SEstimationEntry* entries; ///< Entries, aligned to cache lines
+	};
+
+	/// @brief Estimation class using linear interpolation and a flat result table
+	///
+	/// Computes the same estimations as CEstimationLinear.
+	/// Instead of looking up the measurement results in the task attributes on every call,
+	/// each task and resource pair is resolved once and copied into a dense table.
+	/// The table is indexed by task id and resource id.
+	/// Rows are created on first access and never modified afterwards,
+	/// so lookups of already resolved tasks do not need locking.
+	class CEstimationTable : public CEstimationLinear {
+
+		private:
+			static const int ROWS_PER_BLOCK = 1024; ///< Rows per block of the row directory
+			static const int BLOCKS = 1024; ///< Number of blocks, limits the task ids handled by the table
+
+			/// @brief Two-level row directory, blocks of row pointers indexed by task id
+			std::atomic<std::atomic<SEstimationRow*>*> mBlocks[BLOCKS];
+			std::mutex mTableMutex; ///< Serializes row creation
+			std::vector<SEstimationRow*> mRetiredRows; ///< Rows replaced by wider rows, freed on destruction
+			int mColumns = 0; ///< Largest row width created so far
+
+			/// @brief Creates the table row for the given task
+			/// @param task The given task
+			/// @param res Resource that has to be resolved in the row
+			/// @param oldrow Previous row of the task whose entries are copied, or 0
+			/// @return Row pointer or 0 if the allocation failed
+			SEstimationRow* createRow(CTask* task, CResource* res, SEstimationRow* oldrow);
+
+			/// @brief Copies the measurement results of a task and resource pair into an entry
+			/// @param entry Destination entry
+			/// @param task The given task
+			/// @param res The given resource
+			void resolveEntry(SEstimationEntry* entry, CTask* task, CResource* res);
+
+			/// @brief Returns the table entry for the given task and resource
+			/// @param task The given task
+			/// @param res The given resource
+			/// @return Entry pointer, 0 if the pair can not be stored in the table
+			inline SEstimationEntry* getEntry(CTask* task, CResource* res) {
+				int id = task->mId;
+				if (id >= 0 && id < ROWS_PER_BLOCK * BLOCKS) {
+					std::atomic<SEstimationRow*>* block = mBlocks[id / ROWS_PER_BLOCK].load(std::memory_order_acquire);
+					if (block != 0) {
+						SEstimationRow* row = block[id % ROWS_PER_BLOCK].load(std::memory_order_acquire);
+						if (row != 0 && res->mId >= 0 && res->mId < row->columns &&
+							row->entries[res->mId].valid != -1) {
+							return &(row->entries[res->mId]);
+						}
+					}
+				}
+				return getEntrySlow(task, res);
+			}
+
+			/// @brief Resolves entry for tasks and resources not yet in the table
+			/// @param task The given task
+			/// @param res The given resource
+			/// @return Entry pointer, 0 if the pair can not be stored in the table
+			SEstimationEntry* getEntrySlow(CTask* task, CResource* res);
+
+		public:
+			CEstimationTable();
+			~CEstimationTable();
+
+			double taskTimeInit(CTask* task, CResource* res);
+			double taskTimeCompute(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint);
+			double taskTimeFini(CTask* task, CResource* res);
+			int taskTimeComputeCheckpoint(CTask* task, CResource* res, int startCheckpoint, double sec);
+
+			double taskEnergyCompute(CTask* task, CResource* res, int startCheckpoint, int stopCheckpoint);
+			int taskEnergyComputeCheckpoint(CTask* task, CResource* res, int startCheckpoint, double energy);
+	};
+
+} }
+#endif
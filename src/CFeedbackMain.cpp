@@ -1,7 +1,9 @@
 // Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
 // SPDX-License-Identifier: BSD-2-Clause
 
+#include <sstream>
 #include "CFeedbackMain.h"
+#include "CConfig.h"
 #include "CLogger.h"
 #include "CResource.h"
 using namespace sched::schedule;
@@ -12,18 +14,38 @@ CFeedbackMain::CFeedbackMain(std::vector<CResource*>& rResources):
 {
 
 	mpProgressTrack = new bool[mrResources.size()];
+	mPending.assign(mrResources.size(), false);
+	mRequestTime.resize(mrResources.size());
+	mLatency.assign(mrResources.size(), std::vector<uint64_t>(sLatencyBuckets, 0));
 
 	for (unsigned int i=0; i<mrResources.size(); i++) {
 		mrResources[i]->setFeedback(this);
 	}
 
+	CConfig* config = CConfig::getConfig();
+	uint64_t timeout = 0;
+	int res = config->conf->getUint64((char*)"feedback_progress_timeout_ms", &timeout);
+	if (-1 == res) {
+		CLogger::mainlog->info("Feedback: config key \"feedback_progress_timeout_ms\" not found, using default: 0");
+		timeout = 0;
+	}
+	mTimeoutMs = timeout;
+	if (mTimeoutMs > 0) {
+		CLogger::mainlog->info("Feedback: progress timeout %lu ms", mTimeoutMs);
+	}
+
 }
 
 CFeedbackMain::~CFeedbackMain(){
 
-	mStopFeedback = true;
+	{
+		std::lock_guard<std::mutex> lg(mProgressMutex);
+		mStopFeedback = true;
+	}
 	mProgressCondVar.notify_one();
 
+	logLatencyHistograms();
+
 	if (mpProgressTrack != 0) {
 		delete [] mpProgressTrack;
 		mpProgressTrack = 0;
@@ -32,44 +54,89 @@ CFeedbackMain::~CFeedbackMain(){
 
 }
 
+int CFeedbackMain::latencyBucket(std::chrono::steady_clock::duration latency){
+
+	long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+	int bucket = 0;
+	while (ms > 0 && bucket < sLatencyBuckets-1) {
+		ms >>= 1;
+		bucket++;
+	}
+	return bucket;
+
+}
+
 int CFeedbackMain::getProgress(){
 
 	CLogger::eventlog->info("\"event\":\"FEEDBACK_GETPROGRESS\"");
 	unsigned int resourceCount = mrResources.size();
 	for (unsigned int i=0; i<resourceCount; i++) {
 		CResource* resource = mrResources[i];
-		mpProgressTrack[i] = false;
+		{
+			std::lock_guard<std::mutex> lg(mProgressMutex);
+			mpProgressTrack[i] = false;
+			if (mPending[i] == true) {
+				// response to an earlier request is late, wait for it instead of a new request
+				CLogger::mainlog->debug("Feedback: res %d progress still pending", i);
+				continue;
+			}
+			mPending[i] = true;
+			mRequestTime[i] = std::chrono::steady_clock::now();
+		}
 		int ret = resource->requestProgress();
 		if (ret == 1) {
+			std::lock_guard<std::mutex> lg(mProgressMutex);
+			mPending[i] = false;
 			mpProgressTrack[i] = true;
 			CLogger::mainlog->debug("Feedback: res %d progress done", i);
 		}
 	}
-	unsigned int progressCount = 0;
-	for (unsigned int i=0; i<resourceCount; i++) {
-		if (mpProgressTrack[i] == true) {
-			progressCount++;
-		}
-	}
 
 	// wait for resource progress response
+	std::vector<CResource*> late;
 	{
 
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(mTimeoutMs);
 		std::unique_lock<std::mutex> ul(mProgressMutex);
-		while (progressCount < resourceCount) {
-			mProgressCondVar.wait(ul);
+		while (true) {
 			if (mStopFeedback == true) {
 				return 0;
 			}
-			progressCount = 0;
+			unsigned int progressCount = 0;
 			for (unsigned int i=0; i<resourceCount; i++) {
 				if (mpProgressTrack[i] == true) {
 					progressCount++;
 				}
 			}
+			if (progressCount == resourceCount) {
+				break;
+			}
+			if (mTimeoutMs == 0) {
+				mProgressCondVar.wait(ul);
+			} else
+			if (mProgressCondVar.wait_until(ul, deadline) == std::cv_status::timeout) {
+				for (unsigned int i=0; i<resourceCount; i++) {
+					if (mpProgressTrack[i] == false) {
+						late.push_back(mrResources[i]);
+					}
+				}
+				break;
+			}
+		}
+	}
+
+	// extrapolate progress of late resources
+	// without the feedback lock, resources call gotProgress() while holding their own lock
+	if (late.size() > 0) {
+		std::stringstream ss;
+		for (unsigned int i=0; i<late.size(); i++) {
+			int progress = late[i]->extrapolateProgress();
+			CLogger::mainlog->debug("Feedback: res %d progress late, extrapolated %d", late[i]->mId, progress);
+			ss << (i == 0 ? "" : ",") << "{\"res\":\"" << late[i]->mName << "\",\"progress\":" << progress << "}";
 		}
+		CLogger::eventlog->info("\"event\":\"FEEDBACK_PROGRESS_TIMEOUT\",\"late\":[%s]", ss.str().c_str());
 	}
-	
+
 	CLogger::eventlog->info("\"event\":\"FEEDBACK_GOTPROGRESS\"");
 	CLogger::mainlog->debug("Feedback: progress done");
 
@@ -81,9 +148,33 @@ void CFeedbackMain::gotProgress(CResource& res){
 
 	{
 		std::lock_guard<std::mutex> lg(mProgressMutex);
+		if (mPending[res.mId] == true) {
+			mPending[res.mId] = false;
+			mLatency[res.mId][latencyBucket(std::chrono::steady_clock::now() - mRequestTime[res.mId])]++;
+		}
 		mpProgressTrack[res.mId] = true;
 		CLogger::mainlog->debug("Feedback: res %d progress done", res.mId);
 	}
 	mProgressCondVar.notify_one();
 
 }
+
+void CFeedbackMain::getLatencyHistogram(int res, std::vector<uint64_t>& histogram){
+
+	std::lock_guard<std::mutex> lg(mProgressMutex);
+	histogram = mLatency[res];
+
+}
+
+void CFeedbackMain::logLatencyHistograms(){
+
+	std::lock_guard<std::mutex> lg(mProgressMutex);
+	for (unsigned int i=0; i<mrResources.size(); i++) {
+		std::stringstream ss;
+		for (int b=0; b<sLatencyBuckets; b++) {
+			ss << (b == 0 ? "" : ",") << mLatency[i][b];
+		}
+		CLogger::eventlog->info("\"event\":\"FEEDBACK_LATENCY\",\"res\":\"%s\",\"histogram_ms_log2\":[%s]", mrResources[i]->mName.c_str(), ss.str().c_str());
+	}
+
+}
@@ -5,7 +5,9 @@
 #define __CFEEDBACKMAIN_H__
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
 #include <vector>
+#include <cstdint>
 #include "CFeedback.h"
 
 namespace sched {
@@ -21,14 +23,31 @@ namespace schedule {
 	/// The call to getProgress() waits until progress for all resources is up-to-date.
 	/// Resources call gotProgress() for arriving progress information or finished tasks.
 	/// After all progress values were updated getProgress() returns.
+	///
+	/// With a progress timeout getProgress() returns at the latest after the timeout.
+	/// The progress of resources without response is extrapolated from their schedule entries.
+	/// Their requests stay pending, late responses update the progress for the next computation.
 	class CFeedbackMain : public CFeedback {
 
+		public:
+			static const int sLatencyBuckets = 16; ///< Number of buckets of the latency histograms
+
 		private:
 			bool mStopFeedback = false;
 			bool* mpProgressTrack;
 			std::mutex mProgressMutex;
 			std::condition_variable mProgressCondVar;
 			std::vector<CResource*>& mrResources;
+			uint64_t mTimeoutMs = 0; ///< Progress timeout in milliseconds, 0 waits for all responses
+			std::vector<bool> mPending; ///< Request sent, response outstanding, by resource id
+			std::vector<std::chrono::steady_clock::time_point> mRequestTime; ///< Time of the pending request, by resource id
+			std::vector<std::vector<uint64_t>> mLatency; ///< Response latency histogram, by resource id
+
+		private:
+			/// @brief Returns the histogram bucket for a response latency
+			/// Bucket 0 counts latencies below 1 ms, bucket b latencies in [2^(b-1), 2^b) ms.
+			/// The last bucket is unbounded.
+			static int latencyBucket(std::chrono::steady_clock::duration latency);
 
 		public:
 			CFeedbackMain(std::vector<CResource*>& rResources);
@@ -37,6 +56,12 @@ namespace schedule {
 			int getProgress();
 			/// @brief Notes the task's progress for the given resource as up-to-date.
 			void gotProgress(CResource& res);
+			/// @brief Copies the response latency histogram of a resource
+			/// @param res Resource id
+			/// @param[out] histogram Response count by bucket, see latencyBucket()
+			void getLatencyHistogram(int res, std::vector<uint64_t>& histogram);
+			/// @brief Writes the response latency histograms of all resources to the event log
+			void logLatencyHistograms();
 
 	};
 
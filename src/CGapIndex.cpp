@@ -0,0 +1,301 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include "CGapIndex.h"
+using namespace sched::schedule;
+
+
+void CGapIndex::update(int node) {
+
+	SNode& n = mNodes[node];
+	n.size = 1;
+	n.maxGap = n.gap;
+	if (n.left >= 0) {
+		n.size += mNodes[n.left].size;
+		if (mNodes[n.left].maxGap > n.maxGap) {
+			n.maxGap = mNodes[n.left].maxGap;
+		}
+	}
+	if (n.right >= 0) {
+		n.size += mNodes[n.right].size;
+		if (mNodes[n.right].maxGap > n.maxGap) {
+			n.maxGap = mNodes[n.right].maxGap;
+		}
+	}
+
+}
+
+void CGapIndex::split(int node, int count, int* left, int* right) {
+
+	if (node < 0) {
+		*left = -1;
+		*right = -1;
+		return;
+	}
+	int leftSize = size(mNodes[node].left);
+	if (count <= leftSize) {
+		// split point inside left subtree
+		int l = -1;
+		int r = -1;
+		split(mNodes[node].left, count, &l, &r);
+		mNodes[node].left = r;
+		update(node);
+		*left = l;
+		*right = node;
+	} else {
+		// split point inside right subtree
+		int l = -1;
+		int r = -1;
+		split(mNodes[node].right, count - leftSize - 1, &l, &r);
+		mNodes[node].right = l;
+		update(node);
+		*left = node;
+		*right = r;
+	}
+
+}
+
+int CGapIndex::merge(int left, int right) {
+
+	if (left < 0) {
+		return right;
+	}
+	if (right < 0) {
+		return left;
+	}
+	if (mNodes[left].prio > mNodes[right].prio) {
+		mNodes[left].right = merge(mNodes[left].right, right);
+		update(left);
+		return left;
+	}
+	mNodes[right].left = merge(left, mNodes[right].left);
+	update(right);
+	return right;
+
+}
+
+int CGapIndex::newNode(double gap) {
+
+	// xorshift32
+	mSeed ^= mSeed << 13;
+	mSeed ^= mSeed >> 17;
+	mSeed ^= mSeed << 5;
+	SNode node;
+	node.left = -1;
+	node.right = -1;
+	node.prio = mSeed;
+	node.size = 1;
+	node.gap = gap;
+	node.maxGap = gap;
+	mNodes.push_back(node);
+	if (gap < 0.0) {
+		mNegative++;
+	}
+	return mNodes.size() - 1;
+
+}
+
+void CGapIndex::clear() {
+
+	mNodes.clear();
+	mRoot = -1;
+	mNegative = 0;
+	mBuilt = false;
+
+}
+
+void CGapIndex::build(const std::vector<double>& ready, const std::vector<double>& finish) {
+
+	clear();
+	mNodes.reserve(ready.size());
+	for (unsigned int ix=0; ix<ready.size(); ix++) {
+		double gap = (ix == 0 ? 0.0 : ready[ix] - finish[ix-1]);
+		mRoot = merge(mRoot, newNode(gap));
+	}
+	mBuilt = true;
+
+}
+
+void CGapIndex::insert(int pos, double gap) {
+
+	int left = -1;
+	int right = -1;
+	split(mRoot, pos, &left, &right);
+	mRoot = merge(merge(left, newNode(gap)), right);
+
+}
+
+void CGapIndex::set(int node, int pos, double gap) {
+
+	int leftSize = size(mNodes[node].left);
+	if (pos < leftSize) {
+		set(mNodes[node].left, pos, gap);
+	} else
+	if (pos > leftSize) {
+		set(mNodes[node].right, pos - leftSize - 1, gap);
+	} else {
+		if (mNodes[node].gap < 0.0) {
+			mNegative--;
+		}
+		if (gap < 0.0) {
+			mNegative++;
+		}
+		mNodes[node].gap = gap;
+	}
+	update(node);
+
+}
+
+void CGapIndex::set(int pos, double gap) {
+
+	if (pos < 0 || pos >= size(mRoot)) {
+		return;
+	}
+	set(mRoot, pos, gap);
+
+}
+
+int CGapIndex::find(int node, int offset, int from, double dur) {
+
+	if (node < 0) {
+		return -1;
+	}
+	SNode& n = mNodes[node];
+	if (n.maxGap < dur || offset + n.size <= from) {
+		// no large enough gap or subtree ends before the first position
+		return -1;
+	}
+	int pos = find(n.left, offset, from, dur);
+	if (pos != -1) {
+		return pos;
+	}
+	pos = offset + size(n.left);
+	if (pos >= from && n.gap >= dur) {
+		return pos;
+	}
+	return find(n.right, pos + 1, from, dur);
+
+}
+
+int CGapIndex::find(int from, double dur) {
+
+	return find(mRoot, 0, from, dur);
+
+}
+
+int CGapIndex::findSlot(const std::vector<double>& ready, const std::vector<double>& finish, double dur, double start, int startSlot, double* slotStartOut) {
+
+	int entries = ready.size();
+	if (entries == 0) {
+		// queue is empty
+		*slotStartOut = start;
+		return 0;
+	}
+
+	// first entry that ends after start time
+	int first = std::upper_bound(finish.begin() + startSlot, finish.end(), start) - finish.begin();
+
+	int slot = -1;
+	double slotStart = 0.0;
+	if (first < entries) {
+		if (first == 0) {
+			// task fits before first entry, unless the first entry starts immediately
+			if (ready[0] != 0.0 && ready[0]-start >= dur) {
+				slot = 0;
+				slotStart = start;
+			}
+		} else {
+			double newstart = finish[first-1];
+			if (newstart < start) {
+				newstart = start;
+			}
+			if (ready[first]-newstart >= dur) {
+				slot = first;
+				slotStart = newstart;
+			}
+		}
+		if (slot == -1) {
+			// all following entries end after start time,
+			// so the breaks inbetween are independent of the start time
+			int gap = find(first + 1, dur);
+			if (gap != -1) {
+				slot = gap;
+				slotStart = finish[gap-1];
+				if (slotStart < start) {
+					slotStart = start;
+				}
+			}
+		}
+	}
+	if (slot == -1) {
+		// no slot before machine ready time
+		slot = entries;
+		slotStart = finish[entries-1];
+		if (slotStart < start) {
+			slotStart = start;
+		}
+	}
+	*slotStartOut = slotStart;
+	return slot;
+
+}
+
+int CGapIndex::findSlotLinear(const std::vector<double>& ready, const std::vector<double>& finish, double dur, double start, int startSlot, double* slotStartOut) {
+
+	unsigned int entries = ready.size();
+	int slot = -1;
+	double slotStart = 0.0;
+	double lastFinish = 0.0;
+	if (startSlot > 0) {
+		lastFinish = finish[startSlot - 1];
+	}
+	for (unsigned int ix=startSlot; ix<entries; ix++) {
+		double entryFinish = finish[ix];
+		double entryReady = ready[ix];
+		if (entryFinish <= start) {
+			// entry ends before start time
+			// no slot before this entry,
+			// a task without duration would otherwise be placed in front of a predecessor without duration
+			lastFinish = entryFinish;
+			continue;
+		}
+		if (ix == 0) {
+			// first entry
+			if (entryReady == 0.0) {
+				// no slot before first entry
+				lastFinish = entryFinish;
+				continue;
+			}
+			if (entryReady-start >= dur) {
+				// task fits before first slot
+				slot = 0;
+				slotStart = start;
+				break;
+			}
+		} else {
+			// other entry
+			double newstart = lastFinish;
+			if (newstart < start) {
+				newstart = start;
+			}
+			if (entryReady-newstart >= dur) {
+				slotStart = newstart;
+				slot = ix;
+				break;
+			}
+		}
+		lastFinish = entryFinish;
+	}
+	if (slot == -1) {
+		// no slot before machine ready time
+		slot = entries;
+		slotStart = lastFinish;
+		if (slotStart < start) {
+			slotStart = start;
+		}
+	}
+	*slotStartOut = slotStart;
+	return slot;
+
+}
@@ -0,0 +1,115 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CGAPINDEX_H__
+#define __CGAPINDEX_H__
+#include <vector>
+namespace sched {
+namespace schedule {
+
+	/// @brief Index over the idle gaps of one resource queue
+	///
+	/// Position ix holds the gap in front of queue entry ix, i.e. the ready time of entry ix minus the finish time of entry ix-1.
+	/// The gaps are kept in an implicit treap ordered by queue position, every node stores the largest gap of its subtree.
+	/// Inserting an entry, changing a gap and searching the first gap of a minimum length after a given position
+	/// take O(log n) expected time.
+	class CGapIndex {
+
+		private:
+			struct SNode {
+				int left;
+				int right;
+				unsigned int prio;
+				int size; ///< Number of nodes in the subtree
+				double gap; ///< Gap in front of the entry
+				double maxGap; ///< Largest gap in the subtree
+			};
+
+			std::vector<SNode> mNodes;
+			int mRoot = -1;
+			unsigned int mSeed = 2463534242u; ///< Priority generator state, fixed so the tree shape is reproducible
+			int mNegative = 0; ///< Number of negative gaps, i.e. overlapping entries
+			bool mBuilt = false;
+
+			inline int size(int node) {
+				return (node < 0 ? 0 : mNodes[node].size);
+			}
+
+			/// @brief Updates size and maximum gap of a node from its children
+			void update(int node);
+
+			/// @brief Splits a subtree into the first count positions and the rest
+			void split(int node, int count, int* left, int* right);
+
+			/// @brief Joins two subtrees, all positions of left come before right
+			int merge(int left, int right);
+
+			int newNode(double gap);
+
+			void set(int node, int pos, double gap);
+
+			int find(int node, int offset, int from, double dur);
+
+		public:
+			/// @brief Removes all gaps and marks the index as not built
+			void clear();
+
+			/// @brief Rebuilds the index from the timing data of a queue
+			/// @param ready Entry ready times
+			/// @param finish Entry finish times
+			void build(const std::vector<double>& ready, const std::vector<double>& finish);
+
+			/// @brief Returns if the index reflects the queue
+			inline bool built() {
+				return mBuilt;
+			}
+
+			/// @brief Returns the number of overlapping entries
+			/// Finish times are only ordered along the queue if no gap is negative.
+			inline int negativeGaps() {
+				return mNegative;
+			}
+
+			/// @brief Inserts a gap, the following positions move back by one
+			/// @param pos Position of the new gap
+			/// @param gap Gap length
+			void insert(int pos, double gap);
+
+			/// @brief Changes the gap at a position
+			/// @param pos Position
+			/// @param gap Gap length
+			void set(int pos, double gap);
+
+			/// @brief Finds the first position of a gap with at least the given length
+			/// @param from First position to check
+			/// @param dur Minimum gap length
+			/// @return Position or -1 if there is no such gap
+			int find(int from, double dur);
+
+			/// @brief Finds the first slot of a queue that fits a new entry
+			/// The first entry that finishes after the start time is found by binary search,
+			/// the following breaks are looked up in the index.
+			/// The index has to be built from the queue and must not contain negative gaps.
+			/// @param ready Entry ready times
+			/// @param finish Entry finish times
+			/// @param dur Duration of the new entry
+			/// @param start Ready time of the new entry, slot can't start before this time
+			/// @param startSlot First slot to check
+			/// @param[out] slotStartOut Start time of the found slot
+			/// @return Slot index, 0 is the slot before the first entry, length of the queue is the slot after all entries
+			int findSlot(const std::vector<double>& ready, const std::vector<double>& finish, double dur, double start, int startSlot, double* slotStartOut);
+
+			/// @brief Finds the first slot of a queue that fits a new entry by checking every entry
+			/// Works without index and for overlapping entries, same result as findSlot() otherwise.
+			/// @param ready Entry ready times
+			/// @param finish Entry finish times
+			/// @param dur Duration of the new entry
+			/// @param start Ready time of the new entry, slot can't start before this time
+			/// @param startSlot First slot to check
+			/// @param[out] slotStartOut Start time of the found slot
+			/// @return Slot index, 0 is the slot before the first entry, length of the queue is the slot after all entries
+			static int findSlotLinear(const std::vector<double>& ready, const std::vector<double>& finish, double dur, double start, int startSlot, double* slotStartOut);
+	};
+
+} }
+#endif
@@ -0,0 +1,962 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <sstream>
+#include "CLPSolver.h"
+using namespace sched::algorithm;
+
+/// @brief Values at or beyond this magnitude are infinite, as in lp_solve
+static const double LP_INF = 1e30;
+/// Artificial bound relative to the largest finite bound of the model
+static const double LP_BOX = 1e6;
+
+namespace {
+
+	enum ETokenType {
+		TOKEN_NUM,
+		TOKEN_ID,
+		TOKEN_OP, ///< relational operator, text is one of "<=", ">=", "="
+		TOKEN_SIGN, ///< text is "+" or "-"
+		TOKEN_STAR,
+		TOKEN_COLON,
+		TOKEN_COMMA
+	};
+
+	struct SToken {
+		ETokenType type;
+		std::string text;
+		double num;
+	};
+
+	/// @brief Linear expression sum coef*var + constant
+	struct SExpr {
+		std::vector<int> var;
+		std::vector<double> coef;
+		double constant = 0.0;
+		int terms = 0;
+	};
+
+	bool isIdentStart(char c) {
+		return std::isalpha((unsigned char)c) || c == '_' || c == '[' || c == ']' || c == '{' || c == '}' || c == '/' || c == '.' || c == '&' || c == '#' || c == '$' || c == '%' || c == '~' || c == '\'' || c == '@' || c == '^';
+	}
+
+	bool isIdentChar(char c) {
+		return isIdentStart(c) || std::isdigit((unsigned char)c);
+	}
+
+	/// @brief Splits one statement into tokens
+	/// @return 0 on success, -1 on unknown characters
+	int tokenize(const std::string& text, std::vector<SToken>& tokens) {
+		size_t pos = 0;
+		size_t len = text.size();
+		while (pos < len) {
+			char c = text[pos];
+			if (std::isspace((unsigned char)c)) {
+				pos++;
+				continue;
+			}
+			SToken token;
+			token.num = 0.0;
+			if (std::isdigit((unsigned char)c) || (c == '.' && pos+1 < len && std::isdigit((unsigned char)text[pos+1]))) {
+				char* end = 0;
+				token.type = TOKEN_NUM;
+				token.num = strtod(text.c_str()+pos, &end);
+				pos = end - text.c_str();
+			} else if (isIdentStart(c)) {
+				size_t start = pos;
+				while (pos < len && isIdentChar(text[pos])) {
+					pos++;
+				}
+				token.type = TOKEN_ID;
+				token.text = text.substr(start, pos-start);
+			} else if (c == '<' || c == '>' || c == '=') {
+				// <, <=, =<, >, >=, =>, =, ==
+				char d = (pos+1 < len ? text[pos+1] : 0);
+				token.type = TOKEN_OP;
+				if (c == '<' || (c == '=' && d == '<')) {
+					token.text = "<=";
+				} else if (c == '>' || (c == '=' && d == '>')) {
+					token.text = ">=";
+				} else {
+					token.text = "=";
+				}
+				pos++;
+				if (d == '=' || (c == '=' && (d == '<' || d == '>'))) {
+					pos++;
+				}
+			} else if (c == '+' || c == '-') {
+				token.type = TOKEN_SIGN;
+				token.text = c;
+				pos++;
+			} else if (c == '*') {
+				token.type = TOKEN_STAR;
+				pos++;
+			} else if (c == ':') {
+				token.type = TOKEN_COLON;
+				pos++;
+			} else if (c == ',') {
+				token.type = TOKEN_COMMA;
+				pos++;
+			} else {
+				return -1;
+			}
+			tokens.push_back(token);
+		}
+		return 0;
+	}
+
+	/// @brief Removes the comments of a model text
+	std::string stripComments(const std::string& text) {
+		std::string out;
+		out.reserve(text.size());
+		size_t pos = 0;
+		while (pos < text.size()) {
+			if (text.compare(pos, 2, "/*") == 0) {
+				size_t end = text.find("*/", pos+2);
+				pos = (end == std::string::npos ? text.size() : end+2);
+				out += ' ';
+			} else if (text.compare(pos, 2, "//") == 0) {
+				size_t end = text.find('\n', pos+2);
+				pos = (end == std::string::npos ? text.size() : end);
+			} else {
+				out += text[pos];
+				pos++;
+			}
+		}
+		return out;
+	}
+
+	/// @brief Returns the operator with swapped sides, a <= b is b >= a
+	std::string swapOp(const std::string& op) {
+		if (op == "<=") {
+			return ">=";
+		} else if (op == ">=") {
+			return "<=";
+		}
+		return op;
+	}
+
+	/// @brief Applies expr op rhs to a lower and upper bound
+	void applyOp(const std::string& op, double rhs, double* lower, double* upper, bool* haveLower, bool* haveUpper) {
+		if (op == "<=" || op == "=") {
+			*upper = (rhs >= LP_INF ? LP_INF : (rhs <= -LP_INF ? -LP_INF : rhs));
+			*haveUpper = true;
+		}
+		if (op == ">=" || op == "=") {
+			*lower = (rhs <= -LP_INF ? -LP_INF : (rhs >= LP_INF ? LP_INF : rhs));
+			*haveLower = true;
+		}
+	}
+
+}
+
+CLPSolver::CLPSolver() {
+}
+
+CLPSolver::~CLPSolver() {
+}
+
+void CLPSolver::clear() {
+	mNames.clear();
+	mIndex.clear();
+	mLower.clear();
+	mUpper.clear();
+	mCost.clear();
+	mInteger.clear();
+	mRows.clear();
+	mSense = 1.0;
+	mObjectiveConstant = 0.0;
+	mSolution.clear();
+	mObjective = 0.0;
+}
+
+int CLPSolver::variable(const std::string& name) {
+	auto it = mIndex.find(name);
+	if (it != mIndex.end()) {
+		return it->second;
+	}
+	int ix = mNames.size();
+	mIndex[name] = ix;
+	mNames.push_back(name);
+	mLower.push_back(0.0);
+	mUpper.push_back(LP_INF);
+	mCost.push_back(0.0);
+	mInteger.push_back(false);
+	return ix;
+}
+
+int CLPSolver::read(std::istream& in) {
+	clear();
+	std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	text = stripComments(text);
+
+	bool haveObjective = false;
+	size_t start = 0;
+	while (start < text.size()) {
+		size_t end = text.find(';', start);
+		if (end == std::string::npos) {
+			end = text.size();
+		}
+		std::vector<SToken> tokens;
+		if (tokenize(text.substr(start, end-start), tokens) == -1) {
+			return -1;
+		}
+		start = end+1;
+		if (tokens.size() == 0) {
+			continue;
+		}
+
+		size_t t = 0;
+		size_t count = tokens.size();
+
+		// declarations
+		if (tokens[0].type == TOKEN_ID && (tokens[0].text == "int" || tokens[0].text == "bin") && (count == 1 || (tokens[1].type != TOKEN_COLON && tokens[1].type != TOKEN_OP))) {
+			bool binary = (tokens[0].text == "bin");
+			for (t = 1; t < count; t++) {
+				if (tokens[t].type == TOKEN_COMMA) {
+					continue;
+				}
+				if (tokens[t].type != TOKEN_ID) {
+					return -1;
+				}
+				int v = variable(tokens[t].text);
+				mInteger[v] = true;
+				if (binary == true) {
+					mLower[v] = 0.0;
+					mUpper[v] = 1.0;
+				}
+			}
+			continue;
+		}
+
+		// objective, the first statement, optionally prefixed by min: or max:
+		bool isObjective = false;
+		if (tokens[0].type == TOKEN_ID && count > 1 && tokens[1].type == TOKEN_COLON) {
+			const std::string& word = tokens[0].text;
+			if (word == "min" || word == "minimize" || word == "minimise") {
+				mSense = 1.0;
+				isObjective = true;
+				t = 2;
+			} else if (word == "max" || word == "maximize" || word == "maximise") {
+				mSense = -1.0;
+				isObjective = true;
+				t = 2;
+			}
+		}
+		if (isObjective == false && haveObjective == false) {
+			bool relation = false;
+			for (SToken& token : tokens) {
+				if (token.type == TOKEN_OP) {
+					relation = true;
+				}
+			}
+			isObjective = !relation;
+		}
+
+		// constraint label
+		bool labeled = false;
+		if (isObjective == false && count > 1 && tokens[0].type == TOKEN_ID && tokens[1].type == TOKEN_COLON) {
+			labeled = true;
+			t = 2;
+		}
+
+		// up to three expressions separated by relational operators
+		std::vector<SExpr> exprs(1);
+		std::vector<std::string> ops;
+		while (t < count) {
+			if (tokens[t].type == TOKEN_OP) {
+				if (exprs.back().terms == 0) {
+					return -1;
+				}
+				ops.push_back(tokens[t].text);
+				exprs.push_back(SExpr());
+				t++;
+				continue;
+			}
+			// [sign]... [number] [*] [variable]
+			double sign = 1.0;
+			while (t < count && tokens[t].type == TOKEN_SIGN) {
+				if (tokens[t].text == "-") {
+					sign = -sign;
+				}
+				t++;
+			}
+			double coef = 1.0;
+			bool haveNum = false;
+			if (t < count && tokens[t].type == TOKEN_NUM) {
+				coef = tokens[t].num;
+				haveNum = true;
+				t++;
+				if (t < count && tokens[t].type == TOKEN_STAR) {
+					t++;
+					if (t >= count || tokens[t].type != TOKEN_ID) {
+						return -1;
+					}
+				}
+			}
+			if (t < count && tokens[t].type == TOKEN_ID) {
+				SExpr& expr = exprs.back();
+				expr.var.push_back(variable(tokens[t].text));
+				expr.coef.push_back(sign*coef);
+				t++;
+			} else if (haveNum == true) {
+				exprs.back().constant += sign*coef;
+			} else {
+				return -1;
+			}
+			exprs.back().terms++;
+		}
+
+		if (isObjective == true) {
+			if (ops.size() > 0) {
+				return -1;
+			}
+			SExpr& expr = exprs[0];
+			for (unsigned int i = 0; i < expr.var.size(); i++) {
+				mCost[expr.var[i]] += mSense*expr.coef[i];
+			}
+			mObjectiveConstant += expr.constant;
+			haveObjective = true;
+			continue;
+		}
+		haveObjective = true;
+
+		if (ops.size() == 0 || ops.size() > 2) {
+			return -1;
+		}
+
+		// bring the relation to the form lower <= sum coef*var <= upper
+		SExpr lhs;
+		double lower = -LP_INF;
+		double upper = LP_INF;
+		bool haveLower = false;
+		bool haveUpper = false;
+		if (ops.size() == 1) {
+			lhs = exprs[0];
+			for (unsigned int i = 0; i < exprs[1].var.size(); i++) {
+				lhs.var.push_back(exprs[1].var[i]);
+				lhs.coef.push_back(-exprs[1].coef[i]);
+			}
+			applyOp(ops[0], exprs[1].constant - lhs.constant, &lower, &upper, &haveLower, &haveUpper);
+		} else {
+			// range, the outer expressions have to be constant
+			if (exprs[0].var.size() > 0 || exprs[2].var.size() > 0) {
+				return -1;
+			}
+			lhs = exprs[1];
+			applyOp(swapOp(ops[0]), exprs[0].constant - lhs.constant, &lower, &upper, &haveLower, &haveUpper);
+			applyOp(ops[1], exprs[2].constant - lhs.constant, &lower, &upper, &haveLower, &haveUpper);
+		}
+		lhs.constant = 0.0;
+
+		// merge repeated variables
+		SRow row;
+		row.lower = lower;
+		row.upper = upper;
+		for (unsigned int i = 0; i < lhs.var.size(); i++) {
+			bool found = false;
+			for (unsigned int j = 0; j < row.var.size(); j++) {
+				if (row.var[j] == lhs.var[i]) {
+					row.coef[j] += lhs.coef[i];
+					found = true;
+					break;
+				}
+			}
+			if (found == false) {
+				row.var.push_back(lhs.var[i]);
+				row.coef.push_back(lhs.coef[i]);
+			}
+		}
+
+		if (row.var.size() == 1 && labeled == false) {
+			// single variable relation is a bound, an explicit -1e30 makes the variable free
+			int v = row.var[0];
+			double a = row.coef[0];
+			if (a == 0.0) {
+				continue;
+			}
+			if (a < 0.0) {
+				double tmp = lower;
+				lower = -upper;
+				upper = -tmp;
+				bool haveTmp = haveLower;
+				haveLower = haveUpper;
+				haveUpper = haveTmp;
+				a = -a;
+			}
+			if (haveLower == true) {
+				mLower[v] = (lower <= -LP_INF ? -LP_INF : lower / a);
+			}
+			if (haveUpper == true) {
+				mUpper[v] = (upper >= LP_INF ? LP_INF : upper / a);
+			}
+			continue;
+		}
+		mRows.push_back(row);
+	}
+	return 0;
+}
+
+void CLPSolver::write(std::ostream& out) {
+	char buf[64];
+	out << "/* Objective function */" << std::endl;
+	out << (mSense > 0.0 ? "min:" : "max:");
+	if (mObjectiveConstant != 0.0) {
+		snprintf(buf, sizeof(buf), " %+.12g", mObjectiveConstant);
+		out << buf;
+	}
+	for (unsigned int v = 0; v < mNames.size(); v++) {
+		if (mCost[v] != 0.0) {
+			snprintf(buf, sizeof(buf), " %+.12g ", mSense*mCost[v]);
+			out << buf << mNames[v];
+		}
+	}
+	out << ";" << std::endl << std::endl;
+	out << "/* Constraints */" << std::endl;
+	for (unsigned int r = 0; r < mRows.size(); r++) {
+		SRow& row = mRows[r];
+		out << "R" << (r+1) << ": ";
+		if (row.lower > -LP_INF && row.upper < LP_INF && row.lower != row.upper) {
+			snprintf(buf, sizeof(buf), "%.12g <=", row.lower);
+			out << buf;
+		}
+		for (unsigned int i = 0; i < row.var.size(); i++) {
+			snprintf(buf, sizeof(buf), " %+.12g ", row.coef[i]);
+			out << buf << mNames[row.var[i]];
+		}
+		if (row.lower == row.upper) {
+			snprintf(buf, sizeof(buf), " = %.12g", row.upper);
+		} else if (row.upper < LP_INF) {
+			snprintf(buf, sizeof(buf), " <= %.12g", row.upper);
+		} else if (row.lower > -LP_INF) {
+			snprintf(buf, sizeof(buf), " >= %.12g", row.lower);
+		} else {
+			snprintf(buf, sizeof(buf), " >= -1e30");
+		}
+		out << buf << ";" << std::endl;
+	}
+	out << std::endl;
+	bool declare = false;
+	for (unsigned int v = 0; v < mNames.size(); v++) {
+		if (mLower[v] != 0.0) {
+			snprintf(buf, sizeof(buf), " >= %.12g;", (mLower[v] <= -LP_INF ? -LP_INF : mLower[v]));
+			out << mNames[v] << buf << std::endl;
+		}
+		if (mUpper[v] < LP_INF) {
+			snprintf(buf, sizeof(buf), " <= %.12g;", mUpper[v]);
+			out << mNames[v] << buf << std::endl;
+		}
+		if (mInteger[v] == true) {
+			declare = true;
+		}
+	}
+	if (declare == true) {
+		out << std::endl << "int";
+		bool first = true;
+		for (unsigned int v = 0; v < mNames.size(); v++) {
+			if (mInteger[v] == true) {
+				out << (first == true ? " " : ",") << mNames[v];
+				first = false;
+			}
+		}
+		out << ";" << std::endl;
+	}
+}
+
+void CLPSolver::setTimeout(unsigned long ms) {
+	mTimeoutMs = ms;
+}
+
+bool CLPSolver::timeout() {
+	if (mTimeoutMs == 0) {
+		return false;
+	}
+	return std::chrono::steady_clock::now() >= mStop;
+}
+
+int CLPSolver::initTableau() {
+	int n = mNames.size();
+	int m = mRows.size();
+	mColNum = n;
+	mRowNum = m;
+	mT.assign((size_t)m*n, 0.0);
+	mBasic.resize(m);
+	mNonbasic.resize(n);
+	mAtUpper.assign(n, false);
+	mColOf.assign(n+m, -1);
+	mD.resize(n);
+	mBeta.assign(m, 0.0);
+	mLo.resize(n+m);
+	mUp.resize(n+m);
+	mBoxedLo.assign(n, false);
+	mBoxedUp.assign(n, false);
+
+	double scale = 1.0;
+	for (int v = 0; v < n; v++) {
+		if (mLower[v] > -LP_INF) {
+			scale = std::max(scale, std::fabs(mLower[v]));
+		}
+		if (mUpper[v] < LP_INF) {
+			scale = std::max(scale, std::fabs(mUpper[v]));
+		}
+	}
+	for (int r = 0; r < m; r++) {
+		if (mRows[r].lower > -LP_INF) {
+			scale = std::max(scale, std::fabs(mRows[r].lower));
+		}
+		if (mRows[r].upper < LP_INF) {
+			scale = std::max(scale, std::fabs(mRows[r].upper));
+		}
+	}
+	double box = LP_BOX * scale;
+
+	for (int v = 0; v < n; v++) {
+		mLo[v] = (mLower[v] <= -LP_INF ? -LP_INF : mLower[v]);
+		mUp[v] = (mUpper[v] >= LP_INF ? LP_INF : mUpper[v]);
+		if (mLo[v] > mUp[v]) {
+			return LP_INFEASIBLE;
+		}
+	}
+	for (int r = 0; r < m; r++) {
+		SRow& row = mRows[r];
+		mLo[n+r] = (row.lower <= -LP_INF ? -LP_INF : row.lower);
+		mUp[n+r] = (row.upper >= LP_INF ? LP_INF : row.upper);
+		if (mLo[n+r] > mUp[n+r]) {
+			return LP_INFEASIBLE;
+		}
+		mBasic[r] = n+r;
+		for (unsigned int i = 0; i < row.var.size(); i++) {
+			mT[(size_t)r*n + row.var[i]] = row.coef[i];
+		}
+	}
+
+	// start dual feasible, every nonbasic variable at the bound its cost prefers,
+	// an infinite preferred bound is replaced by an artificial bound (big-M box)
+	for (int k = 0; k < n; k++) {
+		mNonbasic[k] = k;
+		mColOf[k] = k;
+		mD[k] = mCost[k];
+		if (mD[k] > 0.0 || (mD[k] == 0.0 && mLo[k] > -LP_INF)) {
+			if (mLo[k] <= -LP_INF) {
+				mLo[k] = std::min(-box, mUp[k] - box);
+				mBoxedLo[k] = true;
+			}
+			mAtUpper[k] = false;
+		} else {
+			if (mUp[k] >= LP_INF) {
+				mUp[k] = std::max(box, mLo[k] + box);
+				mBoxedUp[k] = true;
+			}
+			mAtUpper[k] = true;
+		}
+	}
+	for (int r = 0; r < m; r++) {
+		double* row = &mT[(size_t)r*n];
+		double b = 0.0;
+		for (int k = 0; k < n; k++) {
+			if (row[k] != 0.0) {
+				b += row[k] * nonbasicValue(k);
+			}
+		}
+		mBeta[r] = b;
+	}
+	return 0;
+}
+
+void CLPSolver::pivot(int row, int col) {
+	int n = mColNum;
+	double* rowr = &mT[(size_t)row*n];
+	double p = rowr[col];
+	double ip = 1.0 / p;
+
+	mRowIx.clear();
+	for (int l = 0; l < n; l++) {
+		if (l != col && rowr[l] != 0.0) {
+			mRowIx.push_back(l);
+		}
+	}
+
+	// pivot row expresses the entering variable by the leaving one
+	for (int l : mRowIx) {
+		rowr[l] = -rowr[l] * ip;
+	}
+	rowr[col] = ip;
+
+	for (int i = 0; i < mRowNum; i++) {
+		if (i == row) {
+			continue;
+		}
+		double* rowi = &mT[(size_t)i*n];
+		double f = rowi[col];
+		if (f == 0.0) {
+			continue;
+		}
+		for (int l : mRowIx) {
+			double val = rowi[l] + f * rowr[l];
+			rowi[l] = (std::fabs(val) < 1e-13 ? 0.0 : val);
+		}
+		rowi[col] = f * ip;
+	}
+
+	double dq = mD[col];
+	if (dq != 0.0) {
+		for (int l : mRowIx) {
+			mD[l] += dq * rowr[l];
+		}
+	}
+	mD[col] = dq * ip;
+
+	int enter = mNonbasic[col];
+	int leave = mBasic[row];
+	mBasic[row] = enter;
+	mNonbasic[col] = leave;
+	mColOf[enter] = -1;
+	mColOf[leave] = col;
+	mPivots++;
+}
+
+int CLPSolver::dualSimplex() {
+	const double primalTol = 1e-7;
+	const double pivotTol = 1e-9;
+	int n = mColNum;
+	int m = mRowNum;
+	int limit = 50*(n+m) + 1000;
+
+	for (int it = 0; ; it++) {
+		if ((it & 63) == 63 && timeout() == true) {
+			return LP_TIMEOUT;
+		}
+		if (it > limit) {
+			return LP_NUMFAILURE;
+		}
+
+		// leaving row with the largest bound violation
+		int r = -1;
+		int dir = 0;
+		double worst = 0.0;
+		for (int i = 0; i < m; i++) {
+			int var = mBasic[i];
+			double b = mBeta[i];
+			double lo = mLo[var];
+			double up = mUp[var];
+			if (lo > -LP_INF && b < lo - primalTol*(1.0+std::fabs(lo))) {
+				if (lo - b > worst) {
+					worst = lo - b;
+					r = i;
+					dir = 1;
+				}
+			} else if (up < LP_INF && b > up + primalTol*(1.0+std::fabs(up))) {
+				if (b - up > worst) {
+					worst = b - up;
+					r = i;
+					dir = -1;
+				}
+			}
+		}
+		if (r == -1) {
+			return LP_OPTIMAL;
+		}
+
+		// entering column by the dual ratio test, ties broken by the larger pivot
+		double* rowr = &mT[(size_t)r*n];
+		int q = -1;
+		double best = 0.0;
+		double bestPivot = 0.0;
+		for (int k = 0; k < n; k++) {
+			double a = rowr[k];
+			double absA = std::fabs(a);
+			if (absA <= pivotTol) {
+				continue;
+			}
+			int var = mNonbasic[k];
+			if (mLo[var] == mUp[var]) {
+				continue;
+			}
+			double s = a * dir;
+			if (mAtUpper[k] == true ? s >= 0.0 : s <= 0.0) {
+				continue;
+			}
+			double ratio = std::fabs(mD[k]) / absA;
+			if (q == -1 || ratio < best - 1e-12 || (ratio <= best + 1e-12 && absA > bestPivot)) {
+				q = k;
+				best = ratio;
+				bestPivot = absA;
+			}
+		}
+		if (q == -1) {
+			return LP_INFEASIBLE;
+		}
+
+		int leave = mBasic[r];
+		double target = (dir > 0 ? mLo[leave] : mUp[leave]);
+		double theta = (target - mBeta[r]) / rowr[q];
+		double enterValue = nonbasicValue(q) + theta;
+		for (int i = 0; i < m; i++) {
+			double f = mT[(size_t)i*n + q];
+			if (f != 0.0) {
+				mBeta[i] += f * theta;
+			}
+		}
+		pivot(r, q);
+		mBeta[r] = enterValue;
+		mAtUpper[q] = (dir < 0);
+	}
+}
+
+void CLPSolver::setBounds(int var, double lo, double up, bool chooseSide) {
+	int col = mColOf[var];
+	double old = (col == -1 ? 0.0 : nonbasicValue(col));
+	mLo[var] = lo;
+	mUp[var] = up;
+	if (col == -1) {
+		return;
+	}
+	bool upper = mAtUpper[col];
+	if (chooseSide == true) {
+		if (mD[col] > 0.0) {
+			upper = false;
+		} else if (mD[col] < 0.0) {
+			upper = true;
+		}
+	}
+	if (upper == true && up >= LP_INF) {
+		upper = false;
+	}
+	if (upper == false && lo <= -LP_INF) {
+		upper = true;
+	}
+	mAtUpper[col] = upper;
+	double delta = nonbasicValue(col) - old;
+	if (delta != 0.0) {
+		int n = mColNum;
+		for (int i = 0; i < mRowNum; i++) {
+			double f = mT[(size_t)i*n + col];
+			if (f != 0.0) {
+				mBeta[i] += f * delta;
+			}
+		}
+	}
+}
+
+void CLPSolver::values(std::vector<double>& x) {
+	int n = mColNum;
+	x.resize(n);
+	for (int k = 0; k < n; k++) {
+		int var = mNonbasic[k];
+		if (var < n) {
+			x[var] = nonbasicValue(k);
+		}
+	}
+	for (int i = 0; i < mRowNum; i++) {
+		int var = mBasic[i];
+		if (var < n) {
+			x[var] = mBeta[i];
+		}
+	}
+}
+
+void CLPSolver::branch() {
+	mNodes++;
+	if (timeout() == true) {
+		mTimedOut = true;
+		return;
+	}
+	int status = dualSimplex();
+	if (mNodes == 1) {
+		mRootStatus = status;
+	}
+	if (status == LP_TIMEOUT) {
+		mTimedOut = true;
+		return;
+	}
+	if (status != LP_OPTIMAL) {
+		return;
+	}
+
+	int n = mColNum;
+	std::vector<double> x;
+	values(x);
+	double z = 0.0;
+	for (int v = 0; v < n; v++) {
+		z += mCost[v] * x[v];
+	}
+	if (mHaveIncumbent == true && z >= mIncumbent - 1e-9*(1.0+std::fabs(mIncumbent))) {
+		return;
+	}
+
+	// most fractional integer variable
+	int j = -1;
+	double bestFrac = 1e-6;
+	for (int v = 0; v < n; v++) {
+		if (mInteger[v] == false) {
+			continue;
+		}
+		double f = x[v] - std::floor(x[v]);
+		double frac = (f < 1.0-f ? f : 1.0-f);
+		if (frac > bestFrac) {
+			bestFrac = frac;
+			j = v;
+		}
+	}
+	if (j == -1) {
+		mIncumbent = z;
+		mSolution = x;
+		mHaveIncumbent = true;
+		return;
+	}
+
+	double lo = mLo[j];
+	double up = mUp[j];
+	double down = std::floor(x[j]);
+	bool upFirst = (x[j] - down >= 0.5);
+	auto it = mStart.find(mNames[j]);
+	if (it != mStart.end()) {
+		upFirst = (it->second >= down + 1.0);
+	}
+	for (int side = 0; side < 2; side++) {
+		bool upBranch = (side == 0 ? upFirst : !upFirst);
+		if (upBranch == true) {
+			setBounds(j, down + 1.0, up, false);
+		} else {
+			setBounds(j, lo, down, false);
+		}
+		branch();
+		setBounds(j, lo, up, true);
+		if (mTimedOut == true) {
+			return;
+		}
+	}
+}
+
+int CLPSolver::solve() {
+	mSolution.clear();
+	mObjective = 0.0;
+	mHaveIncumbent = false;
+	mTimedOut = false;
+	mNodes = 0;
+	mPivots = 0;
+	mRootStatus = LP_OPTIMAL;
+	mStop = std::chrono::steady_clock::now() + std::chrono::milliseconds(mTimeoutMs);
+
+	int status = initTableau();
+	if (status != 0) {
+		return status;
+	}
+	branch();
+
+	if (mHaveIncumbent == false) {
+		if (mTimedOut == true) {
+			return LP_TIMEOUT;
+		}
+		return (mRootStatus == LP_NUMFAILURE ? LP_NUMFAILURE : LP_INFEASIBLE);
+	}
+
+	// recompute the continuous variables from a fresh tableau with the integer variables fixed,
+	// removes the rounding and the error accumulated by the pivots of the search
+	int n = mColNum;
+	std::vector<double> lower = mLower;
+	std::vector<double> upper = mUpper;
+	for (int v = 0; v < n; v++) {
+		if (mInteger[v] == true) {
+			mLower[v] = std::round(mSolution[v]);
+			mUpper[v] = mLower[v];
+		}
+	}
+	unsigned long timeoutMs = mTimeoutMs;
+	mTimeoutMs = 0;
+	if (initTableau() == 0 && dualSimplex() == LP_OPTIMAL) {
+		values(mSolution);
+		mIncumbent = 0.0;
+		for (int v = 0; v < n; v++) {
+			mIncumbent += mCost[v] * mSolution[v];
+		}
+	}
+	mTimeoutMs = timeoutMs;
+	mLower.swap(lower);
+	mUpper.swap(upper);
+
+	// a solution on an artificial bound improves with a larger box,
+	// only the replaced side is checked, the other bound may be finite and the optimum
+	for (int v = 0; v < n; v++) {
+		if ((mBoxedLo[v] == true && mSolution[v] <= mLo[v] + 1e-6*std::fabs(mLo[v]))
+				|| (mBoxedUp[v] == true && mSolution[v] >= mUp[v] - 1e-6*std::fabs(mUp[v]))) {
+			mSolution.clear();
+			return LP_UNBOUNDED;
+		}
+	}
+
+	// check the solution against the original model
+	for (int v = 0; v < n; v++) {
+		double tol = 1e-6*(1.0+std::fabs(mSolution[v]));
+		if (mSolution[v] < mLower[v] - tol || mSolution[v] > mUpper[v] + tol) {
+			return LP_NUMFAILURE;
+		}
+		if (mInteger[v] == true) {
+			mSolution[v] = std::round(mSolution[v]);
+		}
+	}
+	for (SRow& row : mRows) {
+		double act = 0.0;
+		double mag = 1.0;
+		for (unsigned int i = 0; i < row.var.size(); i++) {
+			act += row.coef[i] * mSolution[row.var[i]];
+			mag += std::fabs(row.coef[i] * mSolution[row.var[i]]);
+		}
+		if ((row.lower > -LP_INF && act < row.lower - 1e-6*mag) || (row.upper < LP_INF && act > row.upper + 1e-6*mag)) {
+			return LP_NUMFAILURE;
+		}
+	}
+
+	mObjective = mSense * mIncumbent + mObjectiveConstant;
+	mStart.clear();
+	for (int v = 0; v < n; v++) {
+		if (mInteger[v] == true) {
+			mStart[mNames[v]] = mSolution[v];
+		}
+	}
+	return (mTimedOut == true ? LP_SUBOPTIMAL : LP_OPTIMAL);
+}
+
+double CLPSolver::getObjective() {
+	return mObjective;
+}
+
+double CLPSolver::getValue(const std::string& name) {
+	auto it = mIndex.find(name);
+	if (it == mIndex.end() || it->second >= (int)mSolution.size()) {
+		return 0.0;
+	}
+	return mSolution[it->second];
+}
+
+void CLPSolver::writeSolution(std::ostream& out) {
+	char buf[512];
+	snprintf(buf, sizeof(buf), "\nValue of objective function: %.8f\n\nActual values of the variables:\n", mObjective);
+	out << buf;
+	for (unsigned int v = 0; v < mNames.size(); v++) {
+		double val = (v < mSolution.size() ? mSolution[v] : 0.0);
+		if (std::fabs(val) < 1e-11) {
+			val = 0.0;
+		}
+		snprintf(buf, sizeof(buf), "%-24s %.12g\n", mNames[v].c_str(), val);
+		out << buf;
+	}
+}
+
+int CLPSolver::solveModel(const std::string& model, std::ostream& solution, unsigned long timeoutMs) {
+	static thread_local CLPSolver solver;
+	std::istringstream in(model);
+	if (solver.read(in) == -1) {
+		return LP_NUMFAILURE;
+	}
+	solver.setTimeout(timeoutMs);
+	int status = solver.solve();
+	solver.writeSolution(solution);
+	return status;
+}
@@ -0,0 +1,174 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CLPSOLVER_H__
+#define __CLPSOLVER_H__
+#include <chrono>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+namespace sched {
+namespace algorithm {
+
+	/// @brief In-process solver for small mixed integer linear programs
+	///
+	/// The model is read from the lp_solve LP format subset written by the GeneticMigSolverLP algorithms:
+	/// objective, linear constraints with optional ranges, single variable bounds and bin/int declarations.
+	/// As in lp_solve, relations with a single variable are bounds and variables are non-negative by default.
+	///
+	/// The LP relaxation is solved with a dual simplex on a dense condensed tableau,
+	/// integer variables with depth-first branch and bound.
+	/// Variables unbounded in the direction of their cost get a large artificial bound for the dual feasible start,
+	/// a solution on such a bound is reported as unbounded.
+	/// The search dives towards the values of the previous solution first,
+	/// so a sequence of similar models is warm-started.
+	/// Return codes and the solution output follow lp_solve.
+	class CLPSolver {
+
+		public:
+			/// @brief Solver result, same values as lp_solve
+			enum ELPStatus {
+				LP_OPTIMAL = 0,
+				LP_SUBOPTIMAL = 1, ///< Integer solution found, search stopped by timeout
+				LP_INFEASIBLE = 2,
+				LP_UNBOUNDED = 3,
+				LP_NUMFAILURE = 5, ///< Numerical problems or unsupported model
+				LP_TIMEOUT = 7 ///< No integer solution found before timeout
+			};
+
+		private:
+			/// @brief Constraint lower <= sum coef*var <= upper
+			struct SRow {
+				std::vector<int> var;
+				std::vector<double> coef;
+				double lower;
+				double upper;
+			};
+
+			// model
+			std::vector<std::string> mNames; ///< Variable names
+			std::unordered_map<std::string,int> mIndex; ///< Variable index by name
+			std::vector<double> mLower; ///< Variable lower bounds
+			std::vector<double> mUpper; ///< Variable upper bounds
+			std::vector<double> mCost; ///< Objective coefficients, minimization
+			std::vector<bool> mInteger; ///< Integer variables
+			std::vector<SRow> mRows; ///< Constraints
+			double mSense = 1.0; ///< 1.0 to minimize, -1.0 to maximize
+			double mObjectiveConstant = 0.0; ///< Constant term of the objective
+
+			// result
+			std::vector<double> mSolution; ///< Variable values of the best solution
+			double mObjective = 0.0; ///< Objective value of the best solution
+			std::unordered_map<std::string,double> mStart; ///< Integer values of the previous solution by name
+
+			unsigned long mTimeoutMs = 1000; ///< Time limit per solve
+			std::chrono::steady_clock::time_point mStop; ///< End of the running solve
+			bool mTimedOut = false;
+
+			// simplex state, variables 0..n-1 are structural, n..n+m-1 are row activities
+			int mRowNum = 0;
+			int mColNum = 0;
+			std::vector<double> mT; ///< Condensed tableau, basic = sum T[row][col] * nonbasic
+			std::vector<int> mBasic; ///< Basic variable by row
+			std::vector<int> mNonbasic; ///< Nonbasic variable by column
+			std::vector<bool> mAtUpper; ///< Nonbasic variable is at its upper bound, by column
+			std::vector<int> mColOf; ///< Column of a nonbasic variable or -1, by variable
+			std::vector<double> mD; ///< Reduced costs by column
+			std::vector<double> mBeta; ///< Basic variable values by row
+			std::vector<double> mLo; ///< Working lower bounds by variable
+			std::vector<double> mUp; ///< Working upper bounds by variable
+			std::vector<bool> mBoxedLo; ///< Working lower bound of the structural variable is artificial
+			std::vector<bool> mBoxedUp; ///< Working upper bound of the structural variable is artificial
+			std::vector<int> mRowIx; ///< Scratch list of nonzero tableau indices
+			int mPivots = 0;
+			int mNodes = 0;
+
+			double mIncumbent = 0.0; ///< Objective of the best integer solution, minimization
+			bool mHaveIncumbent = false;
+			int mRootStatus = 0; ///< Simplex result of the root node
+
+			/// @brief Value of the nonbasic variable in a column
+			inline double nonbasicValue(int col) {
+				int var = mNonbasic[col];
+				return (mAtUpper[col] == true ? mUp[var] : mLo[var]);
+			}
+
+			/// @brief Sets up the slack basis
+			/// Infinite bounds preferred by the cost are replaced by large artificial bounds to start dual feasible.
+			/// @return 0 or LP_INFEASIBLE if bounds contradict
+			int initTableau();
+
+			/// @brief Runs the dual simplex until the basis is primal feasible
+			/// @return LP_OPTIMAL, LP_INFEASIBLE, LP_NUMFAILURE or LP_TIMEOUT
+			int dualSimplex();
+
+			/// @brief Exchanges a basic and a nonbasic variable
+			void pivot(int row, int col);
+
+			/// @brief Changes the working bounds of a variable
+			/// A nonbasic variable moves to its new bound and the basic values are updated.
+			/// @param var Variable
+			/// @param lo Lower bound
+			/// @param up Upper bound
+			/// @param chooseSide Select the bound of a nonbasic variable by the sign of its reduced cost
+			void setBounds(int var, double lo, double up, bool chooseSide);
+
+			/// @brief Returns the current values of the structural variables
+			void values(std::vector<double>& x);
+
+			/// @brief Solves the subproblem of one branch and bound node
+			void branch();
+
+			/// @brief Checks the time limit
+			bool timeout();
+
+		public:
+			CLPSolver();
+			~CLPSolver();
+
+			/// @brief Removes the model, keeps the previous solution for warm-starting
+			void clear();
+
+			/// @brief Returns the index of a variable, creates the variable if needed
+			int variable(const std::string& name);
+
+			/// @brief Reads a model in LP format
+			/// @param in Input stream
+			/// @return 0 on success, -1 on syntax error
+			int read(std::istream& in);
+
+			/// @brief Writes the model in LP format
+			void write(std::ostream& out);
+
+			/// @brief Set time limit per solve
+			/// @param ms Milliseconds, 0 for no limit
+			void setTimeout(unsigned long ms);
+
+			/// @brief Solves the model
+			/// @return ELPStatus
+			int solve();
+
+			/// @brief Returns the objective value of the solution
+			double getObjective();
+
+			/// @brief Returns the value of a variable in the solution
+			/// @param name Variable name
+			/// @return Value or 0.0 if the variable does not exist
+			double getValue(const std::string& name);
+
+			/// @brief Writes the solution in the format of the lp_solve command line tool
+			void writeSolution(std::ostream& out);
+
+			/// @brief Solves a model with the solver instance of the calling thread
+			/// The instance keeps the previous solution of the thread as start for the next model.
+			/// @param model Model in LP format
+			/// @param[out] solution Solution in the format of the lp_solve command line tool
+			/// @param timeoutMs Time limit in milliseconds, 0 for no limit
+			/// @return ELPStatus, LP_NUMFAILURE on syntax errors
+			static int solveModel(const std::string& model, std::ostream& solution, unsigned long timeoutMs);
+	};
+
+} }
+#endif
@@ -0,0 +1,126 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <cmath>
+#include <algorithm>
+#include "CRegressionModel.h"
+using namespace sched::task;
+
+
+CRegressionModel::CRegressionModel(ERegressionType type, std::map<int, double*>& rPoints){
+
+	mType = type;
+	mPoints = rPoints.size();
+	mpSizes = new double[mPoints];
+	mpValues = new double[mPoints * RESULTS];
+
+	// std::map is ordered, sizes are ascending
+	int pix = 0;
+	std::map<int, double*>::iterator it = rPoints.begin();
+	for (; it != rPoints.end(); it++) {
+		mpSizes[pix] = it->first;
+		for (int vix = 0; vix < RESULTS; vix++) {
+			mpValues[pix * RESULTS + vix] = it->second[vix];
+		}
+		pix++;
+	}
+
+	if (mType == REGRESSION_POWERLAW) {
+		fitPowerLaw();
+	}
+}
+
+CRegressionModel::~CRegressionModel(){
+
+	delete[] mpSizes;
+	delete[] mpValues;
+
+}
+
+void CRegressionModel::fitPowerLaw(){
+
+	// y = factor * x^exponent
+	// log(y) = log(factor) + exponent * log(x)
+	// only points with positive size and value can be used
+	for (int vix = 0; vix < RESULTS; vix++) {
+		int num = 0;
+		double meanX = 0.0;
+		double meanY = 0.0;
+		for (int pix = 0; pix < mPoints; pix++) {
+			double y = mpValues[pix * RESULTS + vix];
+			if (mpSizes[pix] <= 0.0 || y <= 0.0) {
+				continue;
+			}
+			meanX += log(mpSizes[pix]);
+			meanY += log(y);
+			num++;
+		}
+		if (num == 0) {
+			// value is always zero
+			mFactor[vix] = 0.0;
+			mExponent[vix] = 0.0;
+			continue;
+		}
+		meanX /= num;
+		meanY /= num;
+
+		double sxy = 0.0;
+		double sxx = 0.0;
+		for (int pix = 0; pix < mPoints; pix++) {
+			double y = mpValues[pix * RESULTS + vix];
+			if (mpSizes[pix] <= 0.0 || y <= 0.0) {
+				continue;
+			}
+			double dx = log(mpSizes[pix]) - meanX;
+			sxy += dx * (log(y) - meanY);
+			sxx += dx * dx;
+		}
+
+		// single size: constant model
+		mExponent[vix] = (sxx > 0.0 ? sxy / sxx : 0.0);
+		mFactor[vix] = exp(meanY - mExponent[vix] * meanX);
+	}
+
+}
+
+void CRegressionModel::evaluate(int size, double* results){
+
+	double x = size;
+
+	if (mType == REGRESSION_POWERLAW) {
+		for (int vix = 0; vix < RESULTS; vix++) {
+			if (mFactor[vix] == 0.0) {
+				results[vix] = 0.0;
+			} else {
+				results[vix] = mFactor[vix] * pow(x, mExponent[vix]);
+			}
+		}
+		return;
+	}
+
+	// piecewise linear
+	if (mPoints == 1) {
+		for (int vix = 0; vix < RESULTS; vix++) {
+			results[vix] = mpValues[vix];
+		}
+		return;
+	}
+
+	// segment [lo, lo+1] containing x, outer segments are extrapolated
+	int lo = std::upper_bound(mpSizes, mpSizes + mPoints, x) - mpSizes - 1;
+	if (lo < 0) {
+		lo = 0;
+	}
+	if (lo > mPoints - 2) {
+		lo = mPoints - 2;
+	}
+	double t = (x - mpSizes[lo]) / (mpSizes[lo+1] - mpSizes[lo]);
+	for (int vix = 0; vix < RESULTS; vix++) {
+		double y0 = mpValues[lo * RESULTS + vix];
+		double y1 = mpValues[(lo+1) * RESULTS + vix];
+		double y = y0 + t * (y1 - y0);
+		// extrapolation must not produce negative costs
+		results[vix] = (y < 0.0 ? 0.0 : y);
+	}
+
+}
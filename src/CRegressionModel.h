@@ -0,0 +1,49 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CREGRESSIONMODEL_H__
+#define __CREGRESSIONMODEL_H__
+#include <map>
+namespace sched {
+namespace task {
+
+	/// @brief Available regression models
+	enum ERegressionType {
+		REGRESSION_PIECEWISE, ///< Piecewise linear interpolation between measured sizes
+		REGRESSION_POWERLAW ///< Least-squares fit of factor * size^exponent
+	};
+
+	/// @brief Model of the measurement results of one task on one resource over the problem size
+	///
+	/// Each of the measurement values (see CTaskLoaderMS) is modelled independently.
+	/// The model is fitted once on construction.
+	class CRegressionModel {
+
+		public:
+			static const int RESULTS = 7; ///< Number of values per measurement
+
+		private:
+			ERegressionType mType;
+			int mPoints = 0; ///< Number of measured sizes
+			double* mpSizes = 0; ///< Measured sizes in ascending order
+			double* mpValues = 0; ///< Measurement values, RESULTS values per measured size
+			double mFactor[RESULTS] = {}; ///< Power law factor per value
+			double mExponent[RESULTS] = {}; ///< Power law exponent per value
+
+			/// @brief Fits the power law parameters in log-log space
+			void fitPowerLaw();
+
+		public:
+			/// @param type Regression model
+			/// @param rPoints Measurement values by size
+			CRegressionModel(ERegressionType type, std::map<int, double*>& rPoints);
+			~CRegressionModel();
+
+			/// @brief Evaluates the model
+			/// @param size Problem size
+			/// @param results Destination array for RESULTS values
+			void evaluate(int size, double* results);
+	};
+
+} }
+#endif
@@ -12,11 +12,14 @@
 #include "CSchedule.h"
 #include "ETaskOnEnd.h"
 #include "CEstimation.h"
+#include "CEstimationFeedback.h"
 #include "CMeasure.h"
 using namespace sched::schedule;
 using sched::task::ETaskState;
 using sched::task::ETaskOnEnd;
 using sched::measure::CMeasure;
+using sched::algorithm::CEstimation;
+using sched::algorithm::CEstimationFeedback;
 
 CResource::ETaskRunUntil CResource::sTaskRunUntil = ETaskRunUntil::PROGRESS_SUSPEND;
 
@@ -132,6 +135,8 @@ void CResource::startTask(STaskEntry* taskentry){
 				// task start sent
 				mpTaskEntry = taskentry;
 				mpTask = task;
+				mTaskStart = std::chrono::steady_clock::now();
+				mTaskStartProgress = task->mProgress;
 				if (sTaskRunUntil == ETaskRunUntil::ESTIMATION_TIMER) {
 					if (taskentry->durTotal != std::chrono::steady_clock::duration::zero()) {
 						mProgressTimer.set(taskentry->durTotal, mProgressTimedOutCall);
@@ -281,6 +286,37 @@ int CResource::requestProgress(){
 	return 1;
 }
 
+int CResource::extrapolateProgress(){
+
+	{
+		std::lock_guard<std::mutex> lg(mResourceMutex);
+
+		if (mpTaskEntry == 0 || mpTask == 0 || mpTask->mState != ETaskState::RUNNING) {
+			return -1;
+		}
+		long progress = mpTask->mProgress;
+		long target = mpTaskEntry->stopProgress;
+		long planned = target - (long) mpTaskEntry->startProgress;
+		if (mpTaskEntry->durCompute > std::chrono::steady_clock::duration::zero() && planned > 0) {
+			// compute phase at the planned rate of the entry
+			std::chrono::steady_clock::duration compute = std::chrono::steady_clock::now() - mTaskStart - mpTaskEntry->durInit;
+			double fraction = (double) compute.count() / (double) mpTaskEntry->durCompute.count();
+			long estimate = mTaskStartProgress + (long) (fraction * planned);
+			if (estimate > target - 1) {
+				estimate = target - 1;
+			}
+			if (estimate > progress) {
+				progress = estimate;
+			}
+		}
+		CLogger::mainlog->debug("Resource %s: extrapolated progress %ld for task %d", mName.c_str(), progress, mpTask->mId);
+		// the reported progress stays unchanged, only copies for the schedule computation use the estimate
+		mpTask->mExtrapolatedProgress = progress;
+		return progress;
+	}
+
+}
+
 void CResource::taskAborted(CTaskWrapper& task){
 
 	{
@@ -356,6 +392,7 @@ void CResource::taskSuspended(CTaskWrapper& task, int progress){
 			}
 
 
+			observeTask(progress);
 			mpTask->suspended(progress);
 			if ((long) mpTaskEntry->stopProgress <= progress) {
 				mpTaskEntry->state = ETaskEntryState::DONE;
@@ -412,6 +449,7 @@ void CResource::taskFinished(CTaskWrapper& task){
 			// task end hook
 			execTaskEndHook();
 
+			observeTask(mpTask->mCheckpoints);
 			mpTaskEntry->state = ETaskEntryState::DONE;
 			mpTask->finished();
 			mpTaskEntry = 0;
@@ -457,6 +495,17 @@ void CResource::clientDisconnected(CTaskWrapper& task){
 	}
 }
 
+void CResource::observeTask(int progress) {
+
+	if (CEstimation::getEstimationType() != sched::algorithm::ESTIMATION_FEEDBACK) {
+		return;
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mTaskStart;
+	CEstimationFeedback::observe(mpTask, this, mTaskStartProgress, progress, elapsed.count());
+
+}
+
 void CResource::execSuspendTask() {
 
 	int suspended = mpTask->suspend();
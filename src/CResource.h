@@ -56,6 +56,8 @@ namespace schedule {
 			int mSuspendOnceRunning = 0; ///< Suspend tasks once it started
 			STaskEntry* mpTaskEntry = 0; ///< Current task's schedule entry
 			CTaskWrapper* mpTask = 0; ///< Current task
+			std::chrono::steady_clock::time_point mTaskStart; ///< Start time of the current task
+			long mTaskStartProgress = 0; ///< Progress of the current task at its start
 
 			// hooks
 			CExternalHook* mpTaskEndHook = 0;
@@ -69,6 +71,9 @@ namespace schedule {
 		private:
 			void execSuspendTask();
 			void execTaskEndHook();
+			/// @brief Reports the observed duration of the current task to the estimation
+			/// @param progress Progress of the current task at its end
+			void observeTask(int progress);
 
 		public:
 			CResource(CTaskDatabase& rTaskDatabase);
@@ -88,6 +93,12 @@ namespace schedule {
 			/// @brief Request current task progress
 			/// @return Returns 1 if no progress can be returned, elsethe task was messaged and 0 is returned
 			int requestProgress();
+			/// @brief Extrapolates the progress of the current task from its schedule entry
+			/// Used if the task did not respond to requestProgress() in time.
+			/// The extrapolated progress stays below the entry's target progress and is stored apart from the reported progress.
+			/// Task copies for the schedule computation use it until the next response.
+			/// @return Returns the task's progress, -1 if no task is running
+			int extrapolateProgress();
 			/// @brief Update task parameters
 			/// @param task
 			/// @param schedule
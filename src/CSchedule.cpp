@@ -80,10 +80,8 @@ CSchedule::CSchedule(int tasks, int resources, std::vector<CResource*>& rResourc
 
 CSchedule::~CSchedule() {
 	if (mpTasks != 0) {
+		// entries are part of mArena
 		for (unsigned int i = 0; i<mpTasks->size(); i++) {
-			for (unsigned int j = 0; j<(*mpTasks)[i]->size(); j++) {
-				delete (*((*mpTasks)[i]))[j];
-			}
 			delete (*mpTasks)[i];
 		}
 		delete mpTasks;
@@ -104,36 +102,31 @@ CSchedule::~CSchedule() {
 
 void CSchedule::setRunningTasks(std::vector<CTaskCopy*>* runningTasks) {
 	mRunningTasks.assign(runningTasks->begin(), runningTasks->end());
+	// reverse index, the first resource wins if a task is listed twice
+	mRunningResource.clear();
+	for (unsigned int mix=0; mix<mrResources.size() && mix<mRunningTasks.size(); mix++) {
+		if (mRunningTasks[mix] != 0 && mRunningResource.count(mRunningTasks[mix]->mId) == 0) {
+			mRunningResource[mRunningTasks[mix]->mId] = mix;
+		}
+	}
 }
 
 int CSchedule::taskRunningResource(int tix) {
 
 	CTaskCopy* task = &((*mpOTasks)[tix]);
-	int taskid = task->mId;
-	int runningMix = -1;
-
-	// find out if task is already running
-	for (unsigned int mix=0; mix<mrResources.size() && mix<mRunningTasks.size(); mix++) {
-		if (mRunningTasks[mix] != 0 && mRunningTasks[mix]->mId == taskid) {
-			runningMix = mix;
-			break;
-		}
-	}
-	return runningMix;
+	return taskRunningResourceTid(task->mId);
 }
 
 int CSchedule::taskRunningResourceTid(int tid) {
 
-	int runningMix = -1;
-
-	// find out if task is already running
-	for (unsigned int mix=0; mix<mrResources.size() && mix<mRunningTasks.size(); mix++) {
-		if (mRunningTasks[mix] != 0 && mRunningTasks[mix]->mId == tid) {
-			runningMix = mix;
-			break;
-		}
+	if (mRunningResource.size() == 0) {
+		return -1;
+	}
+	std::unordered_map<int,int>::const_iterator it = mRunningResource.find(tid);
+	if (it == mRunningResource.end()) {
+		return -1;
 	}
-	return runningMix;
+	return it->second;
 }
 
 
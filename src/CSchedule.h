@@ -6,6 +6,8 @@
 #include <vector>
 #include <chrono>
 #include <ostream>
+#include <unordered_map>
+#include "CArena.h"
 
 namespace sched {
 namespace algorithm {
@@ -58,6 +60,7 @@ namespace schedule {
 		std::chrono::steady_clock::duration durTotal; ///< Expected total duration
 		// task energy
 		double energy; ///< Expected energy consumption (dynamic energy)
+		STaskEntry* nextPart = 0; ///< Next entry of the same task in the schedule, used by CScheduleExt
 	};
 
 	/// @brief Base schedule class
@@ -70,7 +73,9 @@ namespace schedule {
 			std::vector<CResource*>& mrResources;
 			std::vector<CTaskCopy>* mpOTasks = 0;
 			std::vector<std::vector<STaskEntry*>*>* mpTasks = 0;
+			CArena mArena; ///< Memory for entries and scratch buffers of the schedule computation, released with the schedule
 			std::vector<CTaskCopy*> mRunningTasks; ///< previously assigned tasks
+			std::unordered_map<int,int> mRunningResource; ///< resource index by task id of previously assigned tasks
 			int mTaskNum = 0;
 			int mResourceNum = 0;
 			int mId = -1;
@@ -93,6 +98,20 @@ namespace schedule {
 			CSchedule(int tasks, int resources, std::vector<CResource*>& rResources);
 			virtual ~CSchedule();
 
+			/// @brief Creates a new entry inside the schedule's arena
+			/// The entry is freed together with the schedule and must not be deleted.
+			/// @return New entry
+			inline STaskEntry* newEntry() {
+				return mArena.create<STaskEntry>();
+			}
+
+			/// @brief Checks if the entry belongs to this schedule
+			/// @param entry Entry created with newEntry()
+			/// @return True if the entry is part of the schedule's arena, else false
+			inline bool ownsEntry(STaskEntry* entry) {
+				return mArena.owns(entry);
+			}
+
 			/// @brief Returns the resource the task is running on, if at all
 			/// Before starting schedule creation it is checked if tasks are running on the resources.
 			/// The list of running tasks is passed to the scheduling algorithm.
@@ -111,7 +130,7 @@ namespace schedule {
 			void setRunningTasks(std::vector<CTaskCopy*>* runningTasks);
 
 			/// @brief Update timing information in STaskEntry structs
-			void computeTimes();
+			virtual void computeTimes();
 
 			/// @brief Update execution times in given task entry
 			/// @param entry TaskEntry to update
@@ -1,8 +1,19 @@
 // Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
 // SPDX-License-Identifier: BSD-2-Clause
 
+#include <deque>
 #include "CScheduleAlgorithm.h"
+#include "CEstimation.h"
+#include "CEstimationMatrix.h"
+#include "CThreadPool.h"
+#include "CTaskCopy.h"
+#include "CResource.h"
+#include "CSchedule.h"
+#include "CScheduleExt.h"
+#include "CLogger.h"
+#include "CConfig.h"
 using namespace sched::algorithm;
+using sched::schedule::STaskEntry;
 
 
 CScheduleAlgorithm::CScheduleAlgorithm(std::vector<CResource*>& rResources):
@@ -12,4 +23,246 @@ CScheduleAlgorithm::CScheduleAlgorithm(std::vector<CResource*>& rResources):
 
 
 CScheduleAlgorithm::~CScheduleAlgorithm(){
+
+	if (mOwnEstimationMatrix == 1) {
+		delete mpEstimationMatrix;
+	}
+	mpEstimationMatrix = 0;
+
+}
+
+void CScheduleAlgorithm::setEstimationMatrix(CEstimationMatrix* pEstimationMatrix){
+
+	if (mOwnEstimationMatrix == 1) {
+		delete mpEstimationMatrix;
+		mOwnEstimationMatrix = 0;
+	}
+	mpEstimationMatrix = pEstimationMatrix;
+
+}
+
+CEstimationMatrix* CScheduleAlgorithm::getEstimationMatrix(std::vector<CTaskCopy>* pTasks){
+
+	if (mpEstimationMatrix == 0) {
+		mpEstimationMatrix = new CEstimationMatrix(mrResources);
+		mOwnEstimationMatrix = 1;
+	}
+	mpEstimationMatrix->update(pTasks);
+	return mpEstimationMatrix;
+
+}
+
+bool CScheduleAlgorithm::loadValidate(const char* name){
+
+	bool validate = false;
+	CConfig* config = CConfig::getConfig();
+	int ret = config->conf->getBool((char*)"genetic_validate", &validate);
+	if (-1 == ret) {
+		validate = false;
+		CLogger::mainlog->info("%s: config key \"genetic_validate\" not found, using default: false", name);
+	}
+	CLogger::mainlog->info("%s: genetic_validate: %s", name, validate == true ? "true" : "false");
+	CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"genetic_validate\",\"value\":%s", validate == true ? "true" : "false");
+	return validate;
+
+}
+
+void CScheduleAlgorithm::setThreadPool(CThreadPool* pThreadPool){
+
+	mpThreadPool = pThreadPool;
+
+}
+
+unsigned int CScheduleAlgorithm::getThreads(){
+
+	if (mpThreadPool == 0) {
+		return 1;
+	}
+	return mpThreadPool->getThreads();
+
+}
+
+void CScheduleAlgorithm::parallelFor(int num, std::function<void(int, unsigned int)> function){
+
+	if (mpThreadPool == 0) {
+		for (int ix=0; ix<num; ix++) {
+			function(ix, 0);
+		}
+		return;
+	}
+	mpThreadPool->parallelFor(num, function);
+
+}
+
+void CScheduleAlgorithm::setDeadline(unsigned long ms){
+
+	mDeadlineMs = ms;
+
+}
+
+void CScheduleAlgorithm::startDeadline(std::chrono::steady_clock::time_point start){
+
+	mDeadline = start + std::chrono::milliseconds(mDeadlineMs);
+
+}
+
+void CScheduleAlgorithm::shareDeadline(CScheduleAlgorithm* pAlgorithm){
+
+	pAlgorithm->mDeadlineMs = mDeadlineMs;
+	pAlgorithm->mDeadline = mDeadline;
+
+}
+
+CScheduleAlgorithm::EComputeState CScheduleAlgorithm::computeState(volatile int* interrupt){
+
+	if (mDeadlineMs == 0) {
+		return (*interrupt == 1 ? COMPUTE_ABORT : COMPUTE_CONTINUE);
+	}
+	if (*interrupt == 1 || std::chrono::steady_clock::now() >= mDeadline) {
+		return COMPUTE_STOP;
+	}
+	return COMPUTE_CONTINUE;
+
+}
+
+int CScheduleAlgorithm::completeMCT(CScheduleExt* pSchedule, std::vector<CTaskCopy>* pTasks, CEstimationMatrix* pMatrix, CEstimation* pEstimation, bool running){
+
+	int tasks = pTasks->size();
+	int machines = mrResources.size();
+	int mapped = 0;
+
+	// unmapped ready tasks in task order
+	std::deque<int> ready;
+	for (int tix=0; tix<tasks; tix++) {
+		if (pSchedule->taskLastPartMapped(tix) == false &&
+			pSchedule->taskDependencySatisfied(tix) == true) {
+			ready.push_back(tix);
+		}
+	}
+
+	while (ready.empty() == false) {
+		int tix = ready.front();
+		ready.pop_front();
+		if (pSchedule->taskLastPartMapped(tix) == true) {
+			continue;
+		}
+		CTaskCopy* task = &((*pTasks)[tix]);
+
+		// resource with earliest completion time
+		int best = -1;
+		double bestComp = 0.0;
+		for (int mix=0; mix<machines; mix++) {
+			CResource* res = mrResources[mix];
+			if (task->validResource(res) == false) {
+				continue;
+			}
+			double ready = 0.0;
+			double init = pMatrix->taskTimeInit(tix, mix);
+			if (running == true) {
+				ready = pSchedule->taskReadyTimeResource(tix, res, pEstimation);
+				if (pSchedule->taskRunningResource(tix) == mix &&
+					pSchedule->resourceTasks(mix) == 0) {
+					// task continues running on resource
+					init = 0.0;
+				}
+			} else {
+				double resourceReady = pSchedule->resourceReadyTime(mix);
+				double depReady = pSchedule->taskReadyTime(tix);
+				ready = (depReady > resourceReady ? depReady : resourceReady);
+			}
+			double comp = ready +
+				init +
+				pMatrix->taskTimeCompute(tix, mix) +
+				pMatrix->taskTimeFini(tix, mix);
+			if (best == -1 || comp < bestComp) {
+				best = mix;
+				bestComp = comp;
+			}
+		}
+		if (best == -1) {
+			// no compatible resource
+			best = 0;
+		}
+
+		STaskEntry* entry = pSchedule->newEntry();
+		entry->taskcopy = task;
+		entry->taskid = entry->taskcopy->mId;
+		entry->startProgress = entry->taskcopy->mProgress;
+		entry->stopProgress = entry->taskcopy->mCheckpoints;
+		pSchedule->computeExecutionTime(entry, mrResources[best]);
+		pSchedule->addEntry(entry, mrResources[best], -1);
+		mapped++;
+
+		// successors freed from their dependencies
+		for (int six=0; six<task->mSuccessorNum; six++) {
+			int stix = pSchedule->taskIndexById(task->mpSuccessorList[six]);
+			if (stix == -1 || pSchedule->taskLastPartMapped(stix) == true) {
+				continue;
+			}
+			if (pSchedule->taskDependencySatisfied(stix) == true) {
+				ready.push_back(stix);
+			}
+		}
+	}
+
+	return mapped;
+
+}
+
+CSchedule* CScheduleAlgorithm::patch(CSchedule* pSchedule, std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, int updated){
+
+	int tasks = pTasks->size();
+	CScheduleExt* sched = new CScheduleExt(tasks, mrResources.size(), mrResources, pTasks);
+	sched->setRunningTasks(runningTasks);
+	sched->copyEntries(pSchedule, updated);
+
+	// a schedule computed ahead may expect more progress than was made,
+	// the first remaining part covers the difference
+	for (int tix=0; tix<tasks; tix++) {
+		STaskEntry* first = 0;
+		for (STaskEntry* entry = sched->mTaskParts[tix]; entry != 0; entry = entry->nextPart) {
+			if (first == 0 || entry->startProgress < first->startProgress) {
+				first = entry;
+			}
+		}
+		CTaskCopy* task = &((*pTasks)[tix]);
+		if (first != 0 && first->startProgress > task->mProgress) {
+			first->startProgress = task->mProgress;
+		}
+	}
+
+	// running tasks the schedule expected to be finished continue first on their resource
+	bool continued = false;
+	for (unsigned int mix=0; mix<runningTasks->size(); mix++) {
+		CTaskCopy* running = (*runningTasks)[mix];
+		if (running == 0) {
+			continue;
+		}
+		int tix = sched->taskIndexById(running->mId);
+		if (tix == -1 || sched->mTaskParts[tix] != 0) {
+			continue;
+		}
+		STaskEntry* entry = sched->newEntry();
+		entry->taskcopy = &((*pTasks)[tix]);
+		entry->taskid = entry->taskcopy->mId;
+		entry->startProgress = entry->taskcopy->mProgress;
+		entry->stopProgress = entry->taskcopy->mCheckpoints;
+		sched->addEntry(entry, mrResources[mix], 0);
+		CLogger::mainlog->debug("ScheduleAlgorithm: patch continues running task %d on resource %u", entry->taskid, mix);
+		continued = true;
+	}
+	if (continued == true) {
+		// entries behind the inserted parts start later
+		sched->computeTimes();
+	}
+
+	// new tasks
+	CEstimation* estimation = CEstimation::getEstimation();
+	completeMCT(sched, pTasks, getEstimationMatrix(pTasks), estimation, true);
+	delete estimation;
+
+	sched->computeTimes();
+
+	return sched;
+
 }
@@ -5,9 +5,12 @@
 #define __CSCHEDULEALGORITHM_H__
 #include <vector>
 #include <mutex>
+#include <functional>
+#include <chrono>
 namespace sched {
 namespace schedule {
 	class CSchedule;
+	class CScheduleExt;
 	class CResource;
 } }
 
@@ -22,22 +25,98 @@ namespace sched {
 namespace algorithm {
 
 	using sched::schedule::CSchedule;
+	using sched::schedule::CScheduleExt;
 	using sched::schedule::CResource;
 
 	using sched::task::CTaskCopy;
 
+	class CEstimation;
+	class CEstimationMatrix;
+	class CThreadPool;
+
 	/// @brief Algorithm that computes a new schedule
 	class CScheduleAlgorithm {
 
+		public:
+			/// @brief State of a running schedule computation
+			enum EComputeState {
+				COMPUTE_CONTINUE = 0, ///< Continue the computation
+				COMPUTE_STOP = 1, ///< Stop and return the best schedule found so far
+				COMPUTE_ABORT = 2 ///< Abort and return no schedule
+			};
+
 		protected:
 			std::vector<CResource*>& mrResources; ///< List of resources
 
+			/// @brief Returns the estimation matrix updated for the given task list
+			/// If no shared matrix was set, the algorithm creates its own matrix.
+			/// @param pTasks List of current tasks
+			/// @return Estimation matrix indexed by task index and resource index of pTasks
+			CEstimationMatrix* getEstimationMatrix(std::vector<CTaskCopy>* pTasks);
+
+			/// @brief Returns the number of threads used by parallelFor()
+			unsigned int getThreads();
+
+			/// @brief Calls the function for all indices in [0,num) using the thread pool
+			/// Without thread pool the calls run serially on the current thread with thread index 0.
+			/// @param num Number of indices
+			/// @param function Loop body, called with the loop index and a thread index in [0,getThreads())
+			void parallelFor(int num, std::function<void(int, unsigned int)> function);
+
+			/// @brief Returns if the running computation has to stop
+			/// Without time budget an interrupt aborts the computation.
+			/// With time budget the algorithm runs in anytime mode,
+			/// an interrupt or the end of the budget stop the computation with the best schedule found so far.
+			/// Can be called from the threads of parallelFor().
+			/// @param interrupt Interrupt variable passed to compute()
+			/// @return Computation state
+			EComputeState computeState(volatile int* interrupt);
+
+			/// @brief Maps the remaining tasks of a partial schedule by minimum completion time
+			/// Used by list heuristics to complete their mapping when stopped in anytime mode.
+			/// Ready tasks are mapped in task order, freed successors are appended to the ready tasks.
+			/// @param pSchedule Partial schedule, every task is either completely mapped or not mapped
+			/// @param pTasks List of tasks
+			/// @param pMatrix Estimation matrix for the task list
+			/// @param pEstimation Estimation object, used for ready times of running tasks
+			/// @param running If true, ready times consider running tasks and tasks continuing on their resource omit the init time
+			/// @return Number of mapped tasks
+			int completeMCT(CScheduleExt* pSchedule, std::vector<CTaskCopy>* pTasks, CEstimationMatrix* pMatrix, CEstimation* pEstimation, bool running);
+
+			/// @brief Reads the "genetic_validate" option of the genetic and simulated annealing algorithms
+			/// @param name Algorithm name used as log prefix
+			/// @return True if schedules are checked after every genetic operation
+			static bool loadValidate(const char* name);
+
+			/// @brief Passes the time budget of the running computation to another algorithm
+			/// @param pAlgorithm Algorithm that computes on behalf of this algorithm
+			void shareDeadline(CScheduleAlgorithm* pAlgorithm);
+
+		private:
+			CEstimationMatrix* mpEstimationMatrix = 0; ///< Estimation matrix
+			int mOwnEstimationMatrix = 0; ///< 1 if the matrix was created by the algorithm
+			CThreadPool* mpThreadPool = 0; ///< Thread pool for data-parallel loops
+			unsigned long mDeadlineMs = 0; ///< Time budget per computation in milliseconds, 0 if unlimited
+			std::chrono::steady_clock::time_point mDeadline; ///< End of the time budget of the running computation
+
 		public:
 			CScheduleAlgorithm(std::vector<CResource*>& rResources);
+			/// @brief Set estimation matrix shared between schedule computations
+			/// @param pEstimationMatrix Estimation matrix
+			void setEstimationMatrix(CEstimationMatrix* pEstimationMatrix);
+			/// @brief Set thread pool shared between schedule computations
+			/// @param pThreadPool Thread pool
+			void setThreadPool(CThreadPool* pThreadPool);
+			/// @brief Set time budget per schedule computation
+			/// @param ms Time budget in milliseconds, 0 disables the budget and the anytime mode
+			void setDeadline(unsigned long ms);
+			/// @brief Start the time budget of the next computation
+			/// @param start Start of the computation
+			void startDeadline(std::chrono::steady_clock::time_point start);
 			/// @brief Initialize algorithm
 			virtual int init() = 0;
 			/// @brief Compute new schedule
-			/// @param pTasks List of current tasks
+			/// @param pTasks List of current tasks, owned by the returned schedule, freed by the algorithm if it returns null
 			/// @param runningTasks List of currently active tasks per resource, may contain null if resource is idling
 			/// @param interrupt Pointer to interrupt variable to abort algorithm
 			/// @param updated 1 if task progress was updated before schedule computation, else 0
@@ -45,6 +124,19 @@ namespace algorithm {
 			virtual CSchedule* compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) = 0;
 			/// @brief Clean up algorithm
 			virtual void fini() = 0;
+			/// @brief Returns if compute() builds on the schedule returned by the previous call
+			/// Such algorithms only map new tasks, so their schedules can not be computed speculatively and discarded.
+			virtual bool reusesSchedule() { return false; }
+			/// @brief Adapts a schedule computed for another task list to the current tasks
+			/// Entries of finished tasks and parts are dropped, the progress of the remaining parts is updated.
+			/// Running tasks missing in the schedule continue at the front of their resource queue,
+			/// other tasks missing in the schedule are mapped by minimum completion time.
+			/// @param pSchedule Schedule to adapt, not modified
+			/// @param pTasks List of current tasks, owned by the returned schedule
+			/// @param runningTasks List of currently active tasks per resource, may contain null if resource is idling
+			/// @param updated 1 if task progress was updated, else the progress is estimated
+			/// @return New schedule
+			CSchedule* patch(CSchedule* pSchedule, std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, int updated);
 			virtual ~CScheduleAlgorithm();
 	};
 
@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmGenetic.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CLogger.h"
 #include "CConfig.h"
@@ -16,49 +18,66 @@ using sched::task::CTask;
 using sched::schedule::STaskEntry;
 using sched::schedule::CSchedule;
 
-CScheduleAlgorithmGenetic::CGeneticSchedule::CGeneticSchedule(int max_num, int machines) {
+CScheduleAlgorithmGenetic::CGeneticSchedule::CGeneticSchedule(int max_num, int machines)
+	: CGeneticSchedule(max_num, machines, new int[size(max_num, machines)]())
+{
+	own = true;
+}
+
+CScheduleAlgorithmGenetic::CGeneticSchedule::CGeneticSchedule(int max_num, int machines, int* buffer) {
 	this->max_num = max_num;
 	this->machines = machines;
-	this->tasks = new int[max_num*machines]();
-	this->num = new int[machines]();
+	this->num = buffer;
+	this->tasks = buffer + machines;
 	this->fitness = 0;
 	mfitness = 0;
+	own = false;
 	
 	//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: max_num %d machines %d %x", max_num, machines, this);
 }
 
 CScheduleAlgorithmGenetic::CGeneticSchedule::~CGeneticSchedule(){
 	//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: ~ %x", this);
-	delete[] tasks;
-	delete[] num;
+	if (own == true) {
+		delete[] num;
+	}
+}
+
+int CScheduleAlgorithmGenetic::CGeneticSchedule::size(int max_num, int machines){
+	return machines + max_num;
 }
 
 
 bool CScheduleAlgorithmGenetic::CGeneticSchedule::check (){
-	for (int tix=0; tix<max_num; tix++) {
-		int f = 0;
-		for (int mix=0; mix<machines; mix++) {
-			for (int rix=0; rix<num[mix]; rix++) {
-				if (tasks[max_num*mix + rix] == tix) {
-					f++;
-				}
-			}
-		}
-		if (f == 0 || f > 1) {
+	int total = 0;
+	for (int mix=0; mix<machines; mix++) {
+		total += num[mix];
+	}
+	if (total != max_num) {
+		return false;
+	}
+	// every task exactly once
+	std::vector<char> found(max_num, 0);
+	for (int ix=0; ix<max_num; ix++) {
+		int tix = tasks[ix];
+		if (tix < 0 || tix >= max_num || found[tix] != 0) {
 			return false;
 		}
+		found[tix] = 1;
 	}
 	return true;
 }
 
 void CScheduleAlgorithmGenetic::CGeneticSchedule::print(){
 	CLogger::mainlog->debug(">>> max_num %d machines %d fitness %lf mfitness %lf", max_num, machines, fitness, mfitness);
+	int* q = tasks;
 	for (int mix=0; mix<machines; mix++) {
 		std::ostringstream ss;
 		ss << mix << ":";
 		for(int rix=0; rix<num[mix]; rix++) {
-			ss << " " << tasks[max_num*mix + rix];
+			ss << " " << q[rix];
 		}
+		q += num[mix];
 		CLogger::mainlog->debug(ss.str());
 	}
 	CLogger::mainlog->debug("<<<");
@@ -76,21 +95,9 @@ void CScheduleAlgorithmGenetic::CGeneticSchedule::transfer(CGeneticSchedule* b){
 		return;
 	}
 	//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: this %x b %x num ", this, b);
-	
-	for (int i=0; i<machines; i++) {
-		b->num[i] = 
-			this->num[i];
-	}
-	
-	//memcpy(b->num, num, sizeof(int)*machines);
-	
-	for (int i=0; i<machines*max_num; i++) {
-		//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: ix %d ", i);
-		b->tasks[i] = 
-			this->tasks[i];
-	}
-	
-	//memcpy(b->tasks, tasks, sizeof(int)*max_num*machines);
+
+	std::copy(num, num + machines, b->num);
+	std::copy(tasks, tasks + max_num, b->tasks);
 	b->fitness = this->fitness;
 	b->mfitness = this->mfitness;
 }
@@ -125,6 +132,43 @@ int CScheduleAlgorithmGenetic::init() {
 
 	mRandom = std::mt19937(seed);
 
+	mValidate = loadValidate("ScheduleAlgorithmGenetic");
+
+	uint64_t value = 0;
+
+	ret = config->conf->getUint64((char*)"genetic_population", &value);
+	if (-1 == ret) {
+		CLogger::mainlog->info("ScheduleAlgorithmGenetic: config key \"genetic_population\" not found, using default: %u", mPopulationSize);
+	} else {
+		mPopulationSize = value;
+	}
+	// crossover works on pairs
+	if (mPopulationSize < 2 || mPopulationSize % 2 != 0) {
+		mPopulationSize = mPopulationSize < 2 ? 2 : mPopulationSize + 1;
+		CLogger::mainlog->warn("ScheduleAlgorithmGenetic: genetic_population has to be even and at least 2, using %u", mPopulationSize);
+	}
+	CLogger::mainlog->info("ScheduleAlgorithmGenetic: genetic_population: %u", mPopulationSize);
+	CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"genetic_population\",\"value\":%u", mPopulationSize);
+
+	ret = config->conf->getUint64((char*)"genetic_islands", &value);
+	if (-1 == ret) {
+		CLogger::mainlog->info("ScheduleAlgorithmGenetic: config key \"genetic_islands\" not found, using default: %u", mIslands);
+	} else {
+		mIslands = value > 0 ? value : 1;
+	}
+	CLogger::mainlog->info("ScheduleAlgorithmGenetic: genetic_islands: %u", mIslands);
+	CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"genetic_islands\",\"value\":%u", mIslands);
+
+	ret = config->conf->getUint64((char*)"genetic_migration_interval", &value);
+	if (-1 == ret) {
+		CLogger::mainlog->info("ScheduleAlgorithmGenetic: config key \"genetic_migration_interval\" not found, using default: %u", mMigrationInterval);
+	} else {
+		mMigrationInterval = value > 0 ? value : 1;
+	}
+	CLogger::mainlog->info("ScheduleAlgorithmGenetic: genetic_migration_interval: %u", mMigrationInterval);
+	CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"genetic_migration_interval\",\"value\":%u", mMigrationInterval);
+
+
 	return 0;
 }
 
@@ -132,25 +176,27 @@ void CScheduleAlgorithmGenetic::fini() {
 }
 
 CScheduleAlgorithmGenetic::CGeneticSchedule* CScheduleAlgorithmGenetic::generateSchedule(
-	
+	std::mt19937& rRandom,
 	//std::list<CTaskCopy*>* height_sets, 
 
 	std::vector<int>* height_sets,
 	int height_num, int machines,
-	int max_num, std::vector<CTaskCopy>* pTasks
+	int max_num, std::vector<CTaskCopy>* pTasks,
+	int* buffer
 ){
-	// save for each height set the number of already distributed tasks
-	int maxIx[height_num];
-	for (int i=0; i<height_num; i++) {
-		maxIx[i] = 0;
+	CGeneticSchedule* sched = 0;
+	if (buffer != 0) {
+		sched = new CGeneticSchedule(max_num, machines, buffer);
+	} else {
+		sched = new CGeneticSchedule(max_num, machines);
 	}
-	
-	CGeneticSchedule* sched = new CGeneticSchedule(max_num, machines);
+	std::fill(sched->num, sched->num + machines, 0);
 
-	// TODO: Change loops into:
 	// for all heights
 	// for each task in height
 	// assign randomly a machine
+	std::vector<int> picked(max_num);
+	int pix = 0;
 
 	for (int hix=0; hix<height_num; hix++) {
 
@@ -166,7 +212,7 @@ CScheduleAlgorithmGenetic::CGeneticSchedule* CScheduleAlgorithmGenetic::generate
 			int t_mix_num = task->mpResources->size();
 
 			// pick machine for task tix
-			int t_mix = (int)(((double)mRandom() / (double)mRandom.max())*(t_mix_num));
+			int t_mix = (int)(((double)rRandom() / (double)rRandom.max())*(t_mix_num));
 			if (t_mix == t_mix_num) {
 				t_mix--;
 			}
@@ -177,30 +223,43 @@ CScheduleAlgorithmGenetic::CGeneticSchedule* CScheduleAlgorithmGenetic::generate
 				std::find(mrResources.begin(),
 					mrResources.end(), res));
 
-			// add task to schedule
-			sched->tasks[max_num*mix + sched->num[mix]] = tix;
+			picked[pix] = mix;
+			pix++;
 			sched->num[mix]++;
-			maxIx[hix]++;
-
 		}
 
 	}
 
-	for (int mix=0; mix<machines; mix++) {
-		for (int rix=0; rix<sched->num[mix]; rix++) {
-
-			CLogger::mainlog->debug("generateSchedule: %d", sched->tasks[max_num*mix + rix]);
+	// add tasks to machine queues in height order
+	std::vector<int> offset(machines, 0);
+	for (int mix=1; mix<machines; mix++) {
+		offset[mix] = offset[mix-1] + sched->num[mix-1];
+	}
+	pix = 0;
+	for (int hix=0; hix<height_num; hix++) {
+		for (int tix : height_sets[hix]) {
+			sched->tasks[offset[picked[pix]]] = tix;
+			offset[picked[pix]]++;
+			pix++;
 		}
 	}
 
-	if (sched->check() == false) {
+	for (int ix=0; ix<max_num; ix++) {
+		CLogger::mainlog->debug("generateSchedule: %d", sched->tasks[ix]);
+	}
+
+	if (mValidate == true && sched->check() == false) {
 		
 		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: fuck");
 	}
 	return sched;
 }
 
-void CScheduleAlgorithmGenetic::mutate(CGeneticSchedule* sched, int* height, int machines, int height_num, std::vector<int>* height_sets, int max_num) {
+void CScheduleAlgorithmGenetic::mutate(std::mt19937& rRandom, CGeneticSchedule* sched, int* height, int machines, int height_num, std::vector<int>* height_sets, int max_num, SGeneticSwap* swap) {
+
+	if (swap != 0) {
+		swap->tix = -1;
+	}
 
 	// schedule needs to utilize at least one machine
 	int usedMachines = 0;
@@ -217,7 +276,7 @@ void CScheduleAlgorithmGenetic::mutate(CGeneticSchedule* sched, int* height, int
 	int mix = 0;
 	int mix_num = 0;
 	do {
-		mix = (((double)mRandom() / (double)mRandom.max())*(machines));
+		mix = (((double)rRandom() / (double)rRandom.max())*(machines));
 		if (mix == machines) {
 			mix--;
 		}
@@ -225,20 +284,20 @@ void CScheduleAlgorithmGenetic::mutate(CGeneticSchedule* sched, int* height, int
 	} while (mix_num == 0);
 
 	// pick position in machine queue
-	int rix = (((double)mRandom() / (double)mRandom.max())*(mix_num));
+	int rix = (((double)rRandom() / (double)rRandom.max())*(mix_num));
 	if (rix == mix_num) {
 		rix--;
 	}
 
 	// get task index
 	//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: rix %d mix_num %d mix %d", rix, mix_num, mix);
-	int tix = sched->tasks[max_num*mix + rix];
+	int tix = sched->queue(mix)[rix];
 	//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: tix %d rix %d mix_num %d mix %d", tix, rix, mix_num, mix);
 	int tix_height = height[tix];
 
 	// pick second random task with same height
 	int height_set_num = height_sets[tix_height].size();
-	int hix = (((double)mRandom() / (double)mRandom.max())*(height_set_num));
+	int hix = (((double)rRandom() / (double)rRandom.max())*(height_set_num));
 	if (hix == height_set_num) {
 		hix--;
 	}
@@ -250,111 +309,95 @@ void CScheduleAlgorithmGenetic::mutate(CGeneticSchedule* sched, int* height, int
 	}
 
 	// find position of second task in schedule
-	int mix2 = -1;
-	int rix2 = -1;
-	for (int t2_mix=0; t2_mix<machines; t2_mix++) {
-		for (int t2_rix=0; t2_rix<sched->num[t2_mix]; t2_rix++) {
-			if (sched->tasks[max_num*t2_mix + t2_rix] == tix2) {
-				mix2 = t2_mix;
-				rix2 = t2_rix;
-				break;
-			}
-		}
-		if (mix2 != -1) {
-			break;
-		}
-	}
-	// swap
-	
-	if (mix2 == -1 || rix2 == -1) {
+	int* pos2 = std::find(sched->tasks, sched->tasks + max_num, tix2);
+	if (pos2 == sched->tasks + max_num) {
 		
 		//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: tix %d not found, sched %x, tix_height %d, hix %d, machines %d", tix2, sched, tix_height, hix, machines);
-		if (sched->check() == false) {
+		if (mValidate == true && sched->check() == false) {
 			CLogger::mainlog->debug("ScheduleAlgorithmGenetic: not found fuck");
 		}
+		return;
+	}
+	int mix2 = 0;
+	int rix2 = pos2 - sched->tasks;
+	while (rix2 >= sched->num[mix2]) {
+		rix2 -= sched->num[mix2];
+		mix2++;
 	}
 
+	// swap
 	//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: max_num %d mix %d rix %d mix2 %d rix2 %d ", max_num, mix, rix, mix2, rix2);
-	if (max_num*mix + rix < 0 || max_num*mix + rix > max_num*machines) {
-		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: oops");
-	}
-	if (max_num*mix2 + rix2 < 0 || max_num*mix2 + rix2 > max_num*machines) {
-		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: oops");
+	sched->queue(mix)[rix] = tix2;
+	*pos2 = tix;
+
+	if (swap != 0) {
+		swap->tix = tix;
+		swap->mix = mix;
+		swap->rix = rix;
+		swap->tix2 = tix2;
+		swap->mix2 = mix2;
+		swap->rix2 = rix2;
 	}
-	sched->tasks[max_num*mix + rix] = tix2;
-	sched->tasks[max_num*mix2 + rix2] = tix;
 }
 
 
-void CScheduleAlgorithmGenetic::crossover(CGeneticSchedule* a, CGeneticSchedule* b, int height_num, int machines, int* height, int max_num){
+void CScheduleAlgorithmGenetic::crossover(std::mt19937& rRandom, CGeneticSchedule* a, CGeneticSchedule* b, CGeneticSchedule* a_out, CGeneticSchedule* b_out, int height_num, int machines, int* height, int max_num){
 
 
 	CLogger::mainlog->debug("Crossover before");
 	a->print();
 	b->print();
 
-	int c = (((double)mRandom() / (double)mRandom.max())*(height_num));
+	int c = (((double)rRandom() / (double)rRandom.max())*(height_num));
 	if (c == height_num) {
 		c--;
 	}
 
 	CLogger::mainlog->debug("Crossover height %d", c);
 
+	// queues are sorted by height,
+	// so every queue is split into a head with height <= c and a tail with height > c
+	int* a_queue = a->tasks;
+	int* b_queue = b->tasks;
+	int* a_out_queue = a_out->tasks;
+	int* b_out_queue = b_out->tasks;
+
 	// for all machines
 	for (int mix=0; mix<machines; mix++) {
-		int a_c_rix = -1;
-		int b_c_rix = -1;
+		int a_max = a->num[mix];
+		int b_max = b->num[mix];
 		// find first node for machine mix with height > c in sched a
-		for (int rix=0; rix<a->num[mix]; rix++) {
-			if (height[a->tasks[max_num*mix + rix]] > c) {
-				a_c_rix = rix;
-				break;
-			}
-		}
-		if (a_c_rix == -1) {
-			a_c_rix = a->num[mix];
+		int a_c_rix = 0;
+		while (a_c_rix < a_max && height[a_queue[a_c_rix]] <= c) {
+			a_c_rix++;
 		}
 		// find first node for machine mix with height > c in sched b
-		for (int rix=0; rix<b->num[mix]; rix++) {
-			if (height[b->tasks[max_num*mix + rix]] > c) {
-				b_c_rix = rix;
-				break;
-			}
-		}
-		if (b_c_rix == -1) {
-			b_c_rix = b->num[mix];
+		int b_c_rix = 0;
+		while (b_c_rix < b_max && height[b_queue[b_c_rix]] <= c) {
+			b_c_rix++;
 		}
-		// swap tasks for this machines
-		int a_max = a->num[mix];
-		int b_max = b->num[mix];
-		int max = b_max > a_max ? b_max : a_max;
-		for (int rix=0; rix<max; rix++) {
-			int a_tix = 0;
-			if (a_c_rix + rix < a_max) {
-				a_tix = a->tasks[max_num*mix + a_c_rix + rix];
-			}
-			int b_tix = 0;
-			if (b_c_rix + rix < b_max) {
-				b_tix = b->tasks[max_num*mix + b_c_rix + rix];
-			}
-			if (b_c_rix + rix < b_max) {
-				a->tasks[max_num*mix + a_c_rix + rix] = b_tix;
-			}
-			if (a_c_rix + rix < a_max) {
-				b->tasks[max_num*mix + b_c_rix + rix] = a_tix;
-			}
-		}
-		a->num[mix] = a_c_rix + (b_max-b_c_rix);
-		b->num[mix] = b_c_rix + (a_max-a_c_rix);
+		// exchange tails for this machine
+		a_out_queue = std::copy(a_queue, a_queue + a_c_rix, a_out_queue);
+		a_out_queue = std::copy(b_queue + b_c_rix, b_queue + b_max, a_out_queue);
+		b_out_queue = std::copy(b_queue, b_queue + b_c_rix, b_out_queue);
+		b_out_queue = std::copy(a_queue + a_c_rix, a_queue + a_max, b_out_queue);
+		a_out->num[mix] = a_c_rix + (b_max-b_c_rix);
+		b_out->num[mix] = b_c_rix + (a_max-a_c_rix);
+		a_queue += a_max;
+		b_queue += b_max;
 		CLogger::mainlog->debug("Crossover: a_c_rix %d b_c_rix %d", a_c_rix, b_c_rix);
 	}
+	a_out->fitness = a->fitness;
+	a_out->mfitness = a->mfitness;
+	b_out->fitness = b->fitness;
+	b_out->mfitness = b->mfitness;
 
 	CLogger::mainlog->debug("Crossover after");
-	a->print();
-	b->print();
+	a_out->print();
+	b_out->print();
 }
 
-void CScheduleAlgorithmGenetic::reproduction(std::vector<CGeneticSchedule*>* pop, std::vector<CGeneticSchedule*>* newpop){
+void CScheduleAlgorithmGenetic::reproduction(std::mt19937& rRandom, std::vector<CGeneticSchedule*>* pop, std::vector<CGeneticSchedule*>* newpop){
 
 	// expect that newpop already is a complete population
 	// just transfer data
@@ -373,7 +416,7 @@ void CScheduleAlgorithmGenetic::reproduction(std::vector<CGeneticSchedule*>* pop
 	}
 	CLogger::mainlog->debug("Reproduction: roulette_sum %lf", roulette_sum);
 	for (int npix=0; npix<pop_size-1; npix++) {
-		double pick = (((double)mRandom() / (double)mRandom.max())*(roulette_sum));
+		double pick = (((double)rRandom() / (double)rRandom.max())*(roulette_sum));
 		if (pick == roulette_sum) {
 			pick--;
 		}
@@ -395,61 +438,57 @@ void CScheduleAlgorithmGenetic::reproduction(std::vector<CGeneticSchedule*>* pop
 	pop->at(max_fitness_pix)->transfer(newpop->back());
 }
 
-void CScheduleAlgorithmGenetic::fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap,double double_max, std::vector<CTaskCopy*>* runningTasks){
+void CScheduleAlgorithmGenetic::prepareFitness(std::vector<CTaskCopy>* pTasks){
+
+	// the fitness functions only read these estimations,
+	// so they can be evaluated concurrently
+	mpMatrix = getEstimationMatrix(pTasks);
+	mScratch.resize(getThreads());
+	mIdlePower.resize(mrResources.size());
+	for (unsigned int mix=0; mix<mrResources.size(); mix++) {
+		mIdlePower[mix] = mpEstimation->resourceIdlePower(mrResources[mix]);
+	}
+}
+
+void CScheduleAlgorithmGenetic::fitness(CGeneticSchedule* sched, SFitnessScratch* scratch, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap,double double_max, std::vector<CTaskCopy*>* runningTasks){
 
 	switch(mFitnessType) {
 		case GENETIC_FITNESS_ENERGY:
-			
-			fitnessEnergy(sched,
-				tasks,
-				height_sets,
-				height,
-				machines,
-				height_num,
-				pTasks,
-				max_num,
-				taskmap,
-				double_max,
-				runningTasks);
-
+			fitness<GENETIC_FITNESS_ENERGY>(sched, scratch, tasks, height_sets, height, machines, height_num, pTasks, max_num, taskmap, double_max, runningTasks);
 		break;
 
 		default:
 		case GENETIC_FITNESS_MAKESPAN:
-
-			fitnessMakespan(sched,
-				tasks,
-				height_sets,
-				height,
-				machines,
-				height_num,
-				pTasks,
-				max_num,
-				taskmap,
-				double_max, 
-				runningTasks);
-
+			fitness<GENETIC_FITNESS_MAKESPAN>(sched, scratch, tasks, height_sets, height, machines, height_num, pTasks, max_num, taskmap, double_max, runningTasks);
 		break;
 	}
 
 }
 
-void CScheduleAlgorithmGenetic::fitnessMakespan(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
+template <enum CScheduleAlgorithmGenetic::EGeneticFitnessType Fitness>
+void CScheduleAlgorithmGenetic::fitness(CGeneticSchedule* sched, SFitnessScratch* scratch, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
 
 	// finishing time
-	double* finish = new double[tasks]();
-	int* progress = new int[machines]();
+	scratch->finish.assign(tasks, 0.0);
+	if (Fitness == GENETIC_FITNESS_ENERGY) {
+		scratch->energy.assign(tasks, 0.0);
+	}
+	scratch->progress.assign(machines, 0);
+	double* finish = scratch->finish.data();
+	double* energy = scratch->energy.data();
+	int* progress = scratch->progress.data();
 	double max_finish = 0.0;
 	for (int hix=0; hix<height_num; hix++) {
 
 		for (int mix=0; mix<machines; mix++) {
+			int* queue = sched->queue(mix);
 			for (int rix=progress[mix]; rix<sched->num[mix]; rix++) {
 
 				if (rix == sched->num[mix]) {
 					continue;
 				}
 
-				int tix = sched->tasks[max_num*mix + rix];
+				int tix = queue[rix];
 				if (height[tix] > hix) {
 					break;
 				}
@@ -457,22 +496,25 @@ void CScheduleAlgorithmGenetic::fitnessMakespan(CGeneticSchedule* sched, int tas
 				double preFinish = 0.0;
 
 				// check finish time of previous task on same time
+				// reads the slot of the task itself, which is still 0, SFitnessCache relies on this
 				if (rix > 0) {
-					preFinish = finish[sched->tasks[max_num*mix + rix]];
+					preFinish = finish[queue[rix]];
 				}
 
 				// compute duration
 				CTaskCopy* task = &((*pTasks)[tix]);
-				CResource* res = mrResources[mix];
-				double dur = 
-					mpEstimation->taskTimeInit(task, res) +
-					mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-					mpEstimation->taskTimeFini(task, res);
-
-				// task not valid for this resource
-				if (dur == 0) {
-					//dur = std::numeric_limits<double>::max();
-					//dur = 1000000000000.0;
+				double dur = mpMatrix->taskTime(tix, mix);
+
+				if (Fitness == GENETIC_FITNESS_ENERGY) {
+					double task_energy = mpMatrix->taskEnergy(tix, mix);
+					if (task->validResource(mrResources[mix]) == false) {
+						// task is not compatible with resource
+						task_energy = double_max;
+						dur = double_max;
+					}
+					energy[tix] = task_energy;
+				} else if (dur == 0) {
+					// task not valid for this resource
 					dur = double_max;
 				}
 
@@ -480,9 +522,12 @@ void CScheduleAlgorithmGenetic::fitnessMakespan(CGeneticSchedule* sched, int tas
 				// preceeding tasks need to be in previous height_sets
 				for (int six=0; six<task->mPredecessorNum; six++) {
 					int sid = task->mpPredecessorList[six];
-					int stask_ix = -1;
-					// stask_ix should always be in the map
-					stask_ix = (*taskmap)[sid];
+					// finished predecessors are not in the map
+					std::unordered_map<int,int>::const_iterator ix_it = taskmap->find(sid);
+					if (ix_it == taskmap->end()) {
+						continue;
+					}
+					int stask_ix = ix_it->second;
 					if (finish[stask_ix] > preFinish) {
 						preFinish = finish[stask_ix];
 					}
@@ -500,114 +545,572 @@ void CScheduleAlgorithmGenetic::fitnessMakespan(CGeneticSchedule* sched, int tas
 		}
 	}
 
-	delete[] finish;
-	delete[] progress;
+	if (Fitness == GENETIC_FITNESS_MAKESPAN) {
+		sched->fitness = max_finish;
+		return;
+	}
+
+	double E_dynamic = 0.0;
+	double E_static = 0.0;
+
+	// sum up task energy for total dynamic energy
+	// summed per height like in the incremental evaluation
+	for (int hix=0; hix<height_num; hix++) {
+		double height_energy = 0.0;
+		for (int tix : height_sets[hix]) {
+			height_energy += energy[tix];
+		}
+		E_dynamic += height_energy;
+	}
+
+	// sum up machine idle power during makespan for total static energy
+	for (int mix=0; mix<machines; mix++) {
+		E_static += max_finish * mIdlePower[mix];
+	}
 
-	sched->fitness = max_finish;
+	sched->fitness = E_static + E_dynamic;
 }
 
-void CScheduleAlgorithmGenetic::fitnessEnergy(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
+template <enum CScheduleAlgorithmGenetic::EGeneticFitnessType Fitness>
+double CScheduleAlgorithmGenetic::fitnessDuration(int tix, int mix, std::vector<CTaskCopy>* pTasks, double double_max) {
 
-	// finishing time
-	double* finish = new double[tasks]();
-	double* energy = new double[tasks]();
-	int* progress = new int[machines]();
+	double dur = mpMatrix->taskTime(tix, mix);
+	if (Fitness == GENETIC_FITNESS_ENERGY) {
+		if ((*pTasks)[tix].validResource(mrResources[mix]) == false) {
+			dur = double_max;
+		}
+	} else {
+		// task not valid for this resource
+		if (dur == 0) {
+			dur = double_max;
+		}
+	}
+	return dur;
+}
+
+template <enum CScheduleAlgorithmGenetic::EGeneticFitnessType Fitness>
+double CScheduleAlgorithmGenetic::fitnessCacheInit(SFitnessCache* cache, CGeneticSchedule* sched, SGeneticProblem* problem) {
+
+	int tasks = problem->tasks;
+	int height_num = problem->height_num;
+	std::vector<CTaskCopy>* pTasks = problem->pTasks;
+
+	// dependencies by task index, finished tasks are not in the map
+	cache->predStart.assign(tasks + 1, 0);
+	cache->succStart.assign(tasks + 1, 0);
+	cache->pred.clear();
+	cache->succ.clear();
+	for (int tix=0; tix<tasks; tix++) {
+		CTaskCopy* task = &((*pTasks)[tix]);
+		cache->predStart[tix] = cache->pred.size();
+		for (int pix=0; pix<task->mPredecessorNum; pix++) {
+			std::unordered_map<int,int>::const_iterator ix_it = problem->taskmap->find(task->mpPredecessorList[pix]);
+			if (ix_it != problem->taskmap->end()) {
+				cache->pred.push_back(ix_it->second);
+			}
+		}
+		cache->succStart[tix] = cache->succ.size();
+		for (int six=0; six<task->mSuccessorNum; six++) {
+			std::unordered_map<int,int>::const_iterator ix_it = problem->taskmap->find(task->mpSuccessorList[six]);
+			if (ix_it != problem->taskmap->end()) {
+				cache->succ.push_back(ix_it->second);
+			}
+		}
+	}
+	cache->predStart[tasks] = cache->pred.size();
+	cache->succStart[tasks] = cache->succ.size();
+
+	cache->machine.assign(tasks, 0);
+	int* queue = sched->tasks;
+	for (int mix=0; mix<problem->machines; mix++) {
+		for (int rix=0; rix<sched->num[mix]; rix++) {
+			cache->machine[queue[rix]] = mix;
+		}
+		queue += sched->num[mix];
+	}
+
+	// predecessors have a lower height, so heights are computed in order
+	cache->finish.assign(tasks, 0.0);
+	cache->energy.assign(tasks, 0.0);
+	cache->heightFinish.assign(height_num, 0.0);
+	cache->heightEnergy.assign(height_num, 0.0);
+	for (int hix=0; hix<height_num; hix++) {
+		for (int tix : problem->height_sets[hix]) {
+			int mix = cache->machine[tix];
+			double preFinish = 0.0;
+			for (int pix=cache->predStart[tix]; pix<cache->predStart[tix+1]; pix++) {
+				if (cache->finish[cache->pred[pix]] > preFinish) {
+					preFinish = cache->finish[cache->pred[pix]];
+				}
+			}
+			cache->finish[tix] = preFinish + fitnessDuration<Fitness>(tix, mix, pTasks, problem->double_max);
+			if (cache->finish[tix] > cache->heightFinish[hix]) {
+				cache->heightFinish[hix] = cache->finish[tix];
+			}
+			if (Fitness == GENETIC_FITNESS_ENERGY) {
+				cache->energy[tix] = (*pTasks)[tix].validResource(mrResources[mix]) == true ? mpMatrix->taskEnergy(tix, mix) : problem->double_max;
+				cache->heightEnergy[hix] += cache->energy[tix];
+			}
+		}
+	}
+
+	cache->trialFinish.assign(tasks, 0.0);
+	cache->trialStamp.assign(tasks, 0);
+	cache->trialHeightFinish.assign(height_num, 0.0);
+	cache->trialHeightStamp.assign(height_num, 0);
+	cache->dirty.assign(height_num, std::vector<int>());
+	cache->changed.clear();
+	cache->trial = 0;
+	cache->swap.tix = -1;
+
+	// combine heights
 	double max_finish = 0.0;
+	double E_dynamic = 0.0;
 	for (int hix=0; hix<height_num; hix++) {
+		if (cache->heightFinish[hix] > max_finish) {
+			max_finish = cache->heightFinish[hix];
+		}
+		E_dynamic += cache->heightEnergy[hix];
+	}
+	if (Fitness == GENETIC_FITNESS_ENERGY) {
+		double E_static = 0.0;
+		for (int mix=0; mix<problem->machines; mix++) {
+			E_static += max_finish * mIdlePower[mix];
+		}
+		cache->fitness = E_static + E_dynamic;
+	} else {
+		cache->fitness = max_finish;
+	}
+	cache->trialFitness = cache->fitness;
+	return cache->fitness;
+}
 
-		for (int mix=0; mix<machines; mix++) {
-			for (int rix=progress[mix]; rix<sched->num[mix]; rix++) {
+template <enum CScheduleAlgorithmGenetic::EGeneticFitnessType Fitness>
+double CScheduleAlgorithmGenetic::fitnessCacheTrial(SFitnessCache* cache, SGeneticSwap* swap, SGeneticProblem* problem) {
 
-				if (rix == sched->num[mix]) {
-					continue;
-				}
+	cache->changed.clear();
+	cache->swap = *swap;
+	cache->trialFitness = cache->fitness;
 
-				int tix = sched->tasks[max_num*mix + rix];
-				if (height[tix] > hix) {
-					break;
+	// swaps on the same machine do not change any finish time
+	if (swap->tix == -1 || swap->mix == swap->mix2) {
+		return cache->fitness;
+	}
+
+	cache->trial++;
+	unsigned int trial = cache->trial;
+	int height_num = problem->height_num;
+	int swap_hix = problem->height[swap->tix];
+	cache->swapHeight = swap_hix;
+	std::vector<CTaskCopy>* pTasks = problem->pTasks;
+
+	// the swapped tasks change their machines
+	cache->trialStamp[swap->tix] = trial;
+	cache->trialStamp[swap->tix2] = trial;
+	cache->dirty[swap_hix].push_back(swap->tix);
+	cache->dirty[swap_hix].push_back(swap->tix2);
+
+	for (int hix=swap_hix; hix<height_num; hix++) {
+		std::vector<int>& dirty = cache->dirty[hix];
+		if (dirty.size() == 0) {
+			continue;
+		}
+		bool rescan = false;
+		double height_finish = cache->heightFinish[hix];
+		for (int tix : dirty) {
+			int mix = cache->machine[tix];
+			if (tix == swap->tix) {
+				mix = swap->mix2;
+			} else
+			if (tix == swap->tix2) {
+				mix = swap->mix;
+			}
+			double preFinish = 0.0;
+			for (int pix=cache->predStart[tix]; pix<cache->predStart[tix+1]; pix++) {
+				int ptix = cache->pred[pix];
+				double pfinish = cache->trialStamp[ptix] == trial ? cache->trialFinish[ptix] : cache->finish[ptix];
+				if (pfinish > preFinish) {
+					preFinish = pfinish;
+				}
+			}
+			double finish = preFinish + fitnessDuration<Fitness>(tix, mix, pTasks, problem->double_max);
+			cache->trialFinish[tix] = finish;
+			cache->changed.push_back(tix);
+			if (finish == cache->finish[tix]) {
+				continue;
+			}
+			// a lower finish time of the latest task requires a rescan of the height
+			if (finish < cache->finish[tix] && cache->finish[tix] == cache->heightFinish[hix]) {
+				rescan = true;
+			}
+			if (finish > height_finish) {
+				height_finish = finish;
+			}
+			for (int six=cache->succStart[tix]; six<cache->succStart[tix+1]; six++) {
+				int stix = cache->succ[six];
+				if (cache->trialStamp[stix] != trial) {
+					cache->trialStamp[stix] = trial;
+					cache->dirty[problem->height[stix]].push_back(stix);
 				}
+			}
+		}
+		dirty.clear();
+		if (rescan == true) {
+			height_finish = 0.0;
+			for (int tix : problem->height_sets[hix]) {
+				double finish = cache->trialStamp[tix] == trial ? cache->trialFinish[tix] : cache->finish[tix];
+				if (finish > height_finish) {
+					height_finish = finish;
+				}
+			}
+		}
+		cache->trialHeightFinish[hix] = height_finish;
+		cache->trialHeightStamp[hix] = trial;
+	}
 
-				double preFinish = 0.0;
+	// combine heights
+	double max_finish = 0.0;
+	for (int hix=0; hix<height_num; hix++) {
+		double height_finish = cache->trialHeightStamp[hix] == trial ? cache->trialHeightFinish[hix] : cache->heightFinish[hix];
+		if (height_finish > max_finish) {
+			max_finish = height_finish;
+		}
+	}
 
-				// check finish time of previous task on same time
-				if (rix > 0) {
-					preFinish = finish[sched->tasks[max_num*mix + rix]];
-				}
+	if (Fitness == GENETIC_FITNESS_ENERGY) {
+		// only the height of the swap changes its task energy
+		cache->trialTaskEnergy = (*pTasks)[swap->tix].validResource(mrResources[swap->mix2]) == true ? mpMatrix->taskEnergy(swap->tix, swap->mix2) : problem->double_max;
+		cache->trialTaskEnergy2 = (*pTasks)[swap->tix2].validResource(mrResources[swap->mix]) == true ? mpMatrix->taskEnergy(swap->tix2, swap->mix) : problem->double_max;
+		cache->trialEnergy = 0.0;
+		for (int tix : problem->height_sets[swap_hix]) {
+			if (tix == swap->tix) {
+				cache->trialEnergy += cache->trialTaskEnergy;
+			} else
+			if (tix == swap->tix2) {
+				cache->trialEnergy += cache->trialTaskEnergy2;
+			} else {
+				cache->trialEnergy += cache->energy[tix];
+			}
+		}
+		double E_dynamic = 0.0;
+		for (int hix=0; hix<height_num; hix++) {
+			E_dynamic += hix == swap_hix ? cache->trialEnergy : cache->heightEnergy[hix];
+		}
+		double E_static = 0.0;
+		for (int mix=0; mix<problem->machines; mix++) {
+			E_static += max_finish * mIdlePower[mix];
+		}
+		cache->trialFitness = E_static + E_dynamic;
+	} else {
+		cache->trialFitness = max_finish;
+	}
+	return cache->trialFitness;
+}
 
-				// compute duration
-				CTaskCopy* task = &((*pTasks)[tix]);
-				CResource* res = mrResources[mix];
-				double dur = 
-					mpEstimation->taskTimeInit(task, res) +
-					mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-					mpEstimation->taskTimeFini(task, res);
-
-            	double task_energy =
-	                mpEstimation->taskEnergyInit(task, res) +
-	                mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints) +
-    	            mpEstimation->taskEnergyFini(task, res);
-
-                if (std::find(task->mpResources->begin(),
-                        task->mpResources->end(), res)
-                    == task->mpResources->end()) {
-                    // task is not compatible with resource
-                    //task_energy = std::numeric_limits<double>::max();
-                    //dur = std::numeric_limits<double>::max();
-                    //task_energy = 10000000000000000.0;
-                    //dur = 1000000000000.0;
-					task_energy = double_max;
-					dur = double_max;
-                }
+template <enum CScheduleAlgorithmGenetic::EGeneticFitnessType Fitness>
+void CScheduleAlgorithmGenetic::fitnessCacheCommit(SFitnessCache* cache) {
 
+	SGeneticSwap* swap = &(cache->swap);
+	cache->fitness = cache->trialFitness;
+	if (swap->tix == -1 || swap->mix == swap->mix2) {
+		return;
+	}
 
-				energy[tix] = task_energy;
+	unsigned int trial = cache->trial;
+	for (int tix : cache->changed) {
+		cache->finish[tix] = cache->trialFinish[tix];
+	}
+	for (unsigned int hix=0; hix<cache->heightFinish.size(); hix++) {
+		if (cache->trialHeightStamp[hix] == trial) {
+			cache->heightFinish[hix] = cache->trialHeightFinish[hix];
+		}
+	}
+	cache->machine[swap->tix] = swap->mix2;
+	cache->machine[swap->tix2] = swap->mix;
 
-				// find max finish time of preceeding tasks
-				// preceeding tasks need to be in previous height_sets
-				for (int six=0; six<task->mPredecessorNum; six++) {
-					int sid = task->mpPredecessorList[six];
-					int stask_ix = -1;
-					// stask_ix should always be in the map
-					stask_ix = (*taskmap)[sid];
-					if (finish[stask_ix] > preFinish) {
-						preFinish = finish[stask_ix];
-					}
-				}
+	if (Fitness == GENETIC_FITNESS_ENERGY) {
+		cache->energy[swap->tix] = cache->trialTaskEnergy;
+		cache->energy[swap->tix2] = cache->trialTaskEnergy2;
+		cache->heightEnergy[cache->swapHeight] = cache->trialEnergy;
+	}
+	swap->tix = -1;
+}
 
-				// set finish time
-				finish[tix] = preFinish + dur;
+// instances used by the simulated annealing algorithm
+template void CScheduleAlgorithmGenetic::fitness<CScheduleAlgorithmGenetic::GENETIC_FITNESS_MAKESPAN>(CGeneticSchedule* sched, SFitnessScratch* scratch, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
+template void CScheduleAlgorithmGenetic::fitness<CScheduleAlgorithmGenetic::GENETIC_FITNESS_ENERGY>(CGeneticSchedule* sched, SFitnessScratch* scratch, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
+template double CScheduleAlgorithmGenetic::fitnessCacheInit<CScheduleAlgorithmGenetic::GENETIC_FITNESS_MAKESPAN>(SFitnessCache* cache, CGeneticSchedule* sched, SGeneticProblem* problem);
+template double CScheduleAlgorithmGenetic::fitnessCacheInit<CScheduleAlgorithmGenetic::GENETIC_FITNESS_ENERGY>(SFitnessCache* cache, CGeneticSchedule* sched, SGeneticProblem* problem);
+template double CScheduleAlgorithmGenetic::fitnessCacheTrial<CScheduleAlgorithmGenetic::GENETIC_FITNESS_MAKESPAN>(SFitnessCache* cache, SGeneticSwap* swap, SGeneticProblem* problem);
+template double CScheduleAlgorithmGenetic::fitnessCacheTrial<CScheduleAlgorithmGenetic::GENETIC_FITNESS_ENERGY>(SFitnessCache* cache, SGeneticSwap* swap, SGeneticProblem* problem);
+template void CScheduleAlgorithmGenetic::fitnessCacheCommit<CScheduleAlgorithmGenetic::GENETIC_FITNESS_MAKESPAN>(SFitnessCache* cache);
+template void CScheduleAlgorithmGenetic::fitnessCacheCommit<CScheduleAlgorithmGenetic::GENETIC_FITNESS_ENERGY>(SFitnessCache* cache);
 
-				if (finish[tix] > max_finish) {
-					max_finish = finish[tix];
-				}
+template <enum CScheduleAlgorithmGenetic::EGeneticFitnessType Fitness>
+void CScheduleAlgorithmGenetic::initPopulation(SGeneticIsland* island, SGeneticProblem* problem) {
 
-				progress[mix]++;
+	std::mt19937& random = *(island->pRandom);
+	int pop_num = mPopulationSize;
+
+	// one buffer for the schedules of pop, newpop and tmp
+	int size = CGeneticSchedule::size(problem->max_num, problem->machines);
+	island->genes.assign((size_t) 3 * pop_num * size, 0);
+	int* genes = island->genes.data();
+
+	// create initial population
+	island->pop = new std::vector<CGeneticSchedule*>();
+	for (int popix=0; popix<pop_num; popix++) {
+		island->pop->push_back(generateSchedule(random, problem->height_sets, problem->height_num, problem->machines, problem->max_num, problem->pTasks, genes + (size_t) popix * size));
+	}
+
+	// compute fitness of initial population
+	std::vector<CGeneticSchedule*>* pop = island->pop;
+	island->max_fitness = 0.0;
+	island->best_ix = -1;
+	island->best_fitness = 0.0;
+	parallelFor(pop_num, [&](int pix, unsigned int thread) {
+		fitness<Fitness>((*pop)[pix], &(mScratch[thread]), problem->tasks, problem->height_sets, problem->height, problem->machines, problem->height_num, problem->pTasks, problem->max_num, problem->taskmap, problem->double_max, problem->runningTasks);
+	});
+	for (int pix=0; pix<pop_num; pix++) {
+		if ((*pop)[pix]->fitness > island->max_fitness) {
+			island->max_fitness = (*pop)[pix]->fitness;
+		}
+		if (island->best_ix == -1 || (*pop)[pix]->fitness < island->best_fitness) {
+			island->best_ix = pix;
+			island->best_fitness = (*pop)[pix]->fitness;
+		}
+	}
+	for (int pix=0; pix<pop_num; pix++) {
+		(*pop)[pix]->mfitness = island->max_fitness - (*pop)[pix]->fitness;
+	}
+
+	island->newpop = new std::vector<CGeneticSchedule*>();
+	island->tmp = new std::vector<CGeneticSchedule*>();
+	for(int pix=0; pix < pop_num; pix++) {
+		island->newpop->push_back(new CGeneticSchedule(problem->max_num, problem->machines, genes + (size_t) (pop_num + pix) * size));
+		island->tmp->push_back(new CGeneticSchedule(problem->max_num, problem->machines, genes + (size_t) (2 * pop_num + pix) * size));
+	}
+	island->nochange = 0;
+	island->count = 0;
+
+	CLogger::mainlog->debug("ScheduleAlgorithmGenetic: best fitness initial: %f", island->best_fitness);
+}
+
+template <enum CScheduleAlgorithmGenetic::EGeneticFitnessType Fitness>
+void CScheduleAlgorithmGenetic::evolve(SGeneticIsland* island, SGeneticProblem* problem) {
+
+	std::mt19937& random = *(island->pRandom);
+	std::vector<CGeneticSchedule*>* pop = island->pop;
+	std::vector<CGeneticSchedule*>* newpop = island->newpop;
+	std::vector<CGeneticSchedule*>* tmp = island->tmp;
+	int pop_num = pop->size();
+	int machines = problem->machines;
+	int height_num = problem->height_num;
+	int* height = problem->height;
+	int max_num = problem->max_num;
+	double crossover_prob = 0.6;
+	double mutation_prob = 0.6;
+
+	// reproduction
+	if (mValidate == true) {
+		for (int ix=0; ix<pop_num; ix++) {
+			if(pop->at(ix)->check() == false) {
+				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before reproduction");
+			}
+		}
+	}
+	reproduction(random, pop, newpop);
+	if (mValidate == true) {
+		for (int ix=0; ix<pop_num; ix++) {
+			if(pop->at(ix)->check() == false) {
+				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after reproduction");
 			}
 		}
 	}
+	// crossover
+	CLogger::mainlog->debug("ScheduleAlgorithmGenetic: Crossover");
+	for (int cix=0; cix<pop_num/2; cix++) {
+		double guess = (double)random() / (double)random.max();
+		CGeneticSchedule* a = (*newpop)[cix];
+		CGeneticSchedule* b = (*newpop)[pop_num/2 + cix];
+		if (guess < crossover_prob) {
+			// apply crossover
+			if (mValidate == true && (a->check() == false || b->check() == false)) {
+				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before crossover");
+			}
+			crossover(random, a, b, (*tmp)[cix*2], (*tmp)[cix*2 + 1], height_num, machines, height, max_num);
+			if (mValidate == true && ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false)) {
+				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after crossover");
+			}
+		} else {
+			a->transfer((*tmp)[cix*2]);
+			b->transfer((*tmp)[cix*2 + 1]);
+		}
+	}
 
-	double E_dynamic = 0.0;
-	double E_static = 0.0;
+	// mutation
+	CLogger::mainlog->debug("ScheduleAlgorithmGenetic: Mutation");
+	for (int pix=0; pix<pop_num; pix++) {
+		double guess = (double)random() / (double)random.max();
+		if (guess < mutation_prob) {
+			// apply mutation
+			mutate(random, (*tmp)[pix], height, machines, height_num, problem->height_sets, max_num);
+		}
+	}
 
-	// sum up task energy for total dynamic energy
-	for (int tix=0; tix<tasks; tix++) {
-		E_dynamic += energy[tix];
+	// recompute fitness for new population
+	int worst_pix = -1;
+	double worst_fitness = 0.0;
+	int new_best_ix = -1;
+	double new_best_fitness = 0.0;
+	parallelFor(pop_num, [&](int pix, unsigned int thread) {
+		fitness<Fitness>((*tmp)[pix], &(mScratch[thread]), problem->tasks, problem->height_sets, height, machines, height_num, problem->pTasks, max_num, problem->taskmap, problem->double_max, problem->runningTasks);
+	});
+	for (int pix=0; pix<pop_num; pix++) {
+		if ((*tmp)[pix]->fitness > island->max_fitness) {
+			island->max_fitness = (*tmp)[pix]->fitness;
+		}
+		if (worst_pix == -1 || (*tmp)[pix]->fitness > worst_fitness) {
+			worst_pix = pix;
+			worst_fitness = (*tmp)[pix]->fitness;
+		}
+		if (new_best_ix == -1 || (*tmp)[pix]->fitness < new_best_fitness) {
+			new_best_ix = pix;
+			new_best_fitness = (*tmp)[pix]->fitness;
+		}
+
+		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: ix %d fitness %f", pix,  (*tmp)[pix]->fitness);
 	}
 
-	// sum up machine idle power during makespan for total static energy
-	for (int mix=0; mix<machines; mix++) {
-		CResource* res = mrResources[mix];
-		double res_idle_power = mpEstimation->resourceIdlePower(res);
-		E_static += max_finish * res_idle_power;
+	for (int pix=0; pix<pop_num; pix++) {
+		(*pop)[pix]->mfitness = island->max_fitness - (*pop)[pix]->fitness;
+	}
+
+	// replace worst node with best node
+	(*pop)[island->best_ix]->transfer((*tmp)[worst_pix]);
+	island->best_ix = worst_pix;
+	if (new_best_fitness < island->best_fitness) {
+		island->best_ix = new_best_ix;
+		island->best_fitness = new_best_fitness;
+		island->nochange = 0;
+	} else {
+		island->nochange++;
 	}
+	island->pop = tmp;
+	island->tmp = pop;
+	island->count++;
+	CLogger::mainlog->debug("ScheduleAlgorithmGenetic: best fitness round %d: %f", island->count, island->best_fitness);
+}
 
-	delete[] finish;
-	delete[] progress;
-	delete[] energy;
+void CScheduleAlgorithmGenetic::migrate(std::vector<SGeneticIsland>& islands) {
 
-	sched->fitness = E_static + E_dynamic;
+	int island_num = islands.size();
+	if (island_num < 2) {
+		return;
+	}
+
+	// take copies first, so the result does not depend on the island order
+	std::vector<CGeneticSchedule*> migrants;
+	for (int iix=0; iix<island_num; iix++) {
+		SGeneticIsland* island = &(islands[iix]);
+		migrants.push_back((*island->pop)[island->best_ix]->copy());
+	}
+
+	for (int iix=0; iix<island_num; iix++) {
+		CGeneticSchedule* migrant = migrants[iix];
+		SGeneticIsland* target = &(islands[(iix + 1) % island_num]);
+		std::vector<CGeneticSchedule*>* pop = target->pop;
+
+		// find worst individual of target island
+		int worst_pix = -1;
+		for (unsigned int pix=0; pix<pop->size(); pix++) {
+			if (worst_pix == -1 || (*pop)[pix]->fitness > (*pop)[worst_pix]->fitness) {
+				worst_pix = pix;
+			}
+		}
+
+		if (worst_pix != target->best_ix && migrant->fitness < (*pop)[worst_pix]->fitness) {
+			migrant->transfer((*pop)[worst_pix]);
+			(*pop)[worst_pix]->mfitness = target->max_fitness - migrant->fitness;
+			if (migrant->fitness < target->best_fitness) {
+				target->best_ix = worst_pix;
+				target->best_fitness = migrant->fitness;
+				target->nochange = 0;
+			}
+		}
+		delete migrant;
+	}
+}
+
+void CScheduleAlgorithmGenetic::runIslands(std::vector<SGeneticIsland>& islands, std::function<void(SGeneticIsland*)> function) {
+
+	// islands are independent, each one is processed by exactly one thread
+	parallelFor(islands.size(), [&](int iix, unsigned int thread) {
+		function(&(islands[iix]));
+	});
+}
+
+template <enum CScheduleAlgorithmGenetic::EGeneticFitnessType Fitness>
+CScheduleAlgorithm::EComputeState CScheduleAlgorithmGenetic::evolveIslands(std::vector<SGeneticIsland>& islands, SGeneticProblem* problem, volatile int* interrupt) {
+
+	EComputeState state = COMPUTE_CONTINUE;
+
+	runIslands(islands, [&](SGeneticIsland* island) {
+		initPopulation<Fitness>(island, problem);
+	});
+
+	if (islands.size() == 1) {
+		SGeneticIsland* island = &(islands[0]);
+		do {
+			evolve<Fitness>(island, problem);
+			state = computeState(interrupt);
+		} while (island->nochange < MAX_NOCHANGE && state == COMPUTE_CONTINUE);
+	} else {
+		// island populations evolve independently between migrations
+		bool converged = false;
+		do {
+			runIslands(islands, [&](SGeneticIsland* island) {
+				for (unsigned int gix=0; gix<mMigrationInterval; gix++) {
+					if (island->nochange >= MAX_NOCHANGE || computeState(interrupt) != COMPUTE_CONTINUE) {
+						break;
+					}
+					evolve<Fitness>(island, problem);
+				}
+			});
+			state = computeState(interrupt);
+			if (state != COMPUTE_CONTINUE) {
+				break;
+			}
+			converged = true;
+			for (unsigned int iix=0; iix<islands.size(); iix++) {
+				if (islands[iix].nochange < MAX_NOCHANGE) {
+					converged = false;
+				}
+			}
+			if (converged == false) {
+				migrate(islands);
+			}
+		} while (converged == false);
+	}
+
+	return state;
 }
 
+void CScheduleAlgorithmGenetic::freePopulation(SGeneticIsland* island) {
+
+	for (unsigned int pix=0; pix<island->pop->size(); pix++) {
+		delete (*island->pop)[pix];
+		delete (*island->newpop)[pix];
+		delete (*island->tmp)[pix];
+	}
+	delete island->pop;
+	delete island->newpop;
+	delete island->tmp;
+	island->pop = 0;
+	island->newpop = 0;
+	island->tmp = 0;
+	std::vector<int>().swap(island->genes);
+}
 
 CSchedule* CScheduleAlgorithmGenetic::compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
 
@@ -638,7 +1141,7 @@ CSchedule* CScheduleAlgorithmGenetic::compute(std::vector<CTaskCopy>* pTasks, st
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -648,6 +1151,8 @@ CSchedule* CScheduleAlgorithmGenetic::compute(std::vector<CTaskCopy>* pTasks, st
 
 
 
+	prepareFitness(pTasks);
+
 	// generate map for global id to local id conversion
 	std::unordered_map<int,int> taskmap;
 	for (unsigned int i=0; i<pTasks->size(); i++) {
@@ -656,13 +1161,13 @@ CSchedule* CScheduleAlgorithmGenetic::compute(std::vector<CTaskCopy>* pTasks, st
 
 	// prepare tasks
 	// compute height for every task
-	int* height = new int[tasks]();
+	int* height = sched->mArena.createArray<int>(tasks);
 	for (int ix=0; ix<tasks; ix++) {
 		height[ix] = -1;
 	}
 	int max_height = -1;
 	// for each task traverse successor tasks to set height
-	int* stack = new int[tasks*2](); // taskid, height
+	int* stack = sched->mArena.createArray<int>(tasks*2); // taskid, height
 	int stackIx = 0; // next element
 	for (int ix=0; ix<tasks; ix++) {
 		if (height[ix] != -1) {
@@ -721,7 +1226,6 @@ CSchedule* CScheduleAlgorithmGenetic::compute(std::vector<CTaskCopy>* pTasks, st
 			}
 		}
 	}
-	delete[] stack;
 
 	// all tasks have height 0 ?
 	if (tasks > 0 && max_height == -1) {
@@ -742,158 +1246,63 @@ CSchedule* CScheduleAlgorithmGenetic::compute(std::vector<CTaskCopy>* pTasks, st
 	
 
 
-	// create initial population
-	int pop_num = 20;
-	std::vector<CGeneticSchedule*>* pop = new std::vector<CGeneticSchedule*>();
-	for (int popix=0; popix<pop_num; popix++) {
-		pop->push_back(generateSchedule(height_sets, height_num, machines, max_num, pTasks));
-	}
-
 	//double double_max = std::numeric_limits<double>::max();
 	double double_max = 10000000000.0;
 
-	// compute fitness of initial population
-	double max_fitness = 0.0;
-	int best_ix = -1;
-	double best_fitness = 0.0;
-	for (int pix=0; pix<pop_num; pix++) {
-		fitness((*pop)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
-
-		if ((*pop)[pix]->fitness > max_fitness) {
-			max_fitness = (*pop)[pix]->fitness;
-		}
-		if (best_ix == -1 || (*pop)[pix]->fitness < best_fitness) {
-			best_ix = pix;
-			best_fitness = (*pop)[pix]->fitness;
+	SGeneticProblem problem;
+	problem.tasks = tasks;
+	problem.machines = machines;
+	problem.max_num = max_num;
+	problem.height_num = height_num;
+	problem.height = height;
+	problem.height_sets = height_sets;
+	problem.pTasks = pTasks;
+	problem.taskmap = &taskmap;
+	problem.double_max = double_max;
+	problem.runningTasks = runningTasks;
+
+	EComputeState state = COMPUTE_CONTINUE;
+
+	// one population uses the algorithm's random number stream,
+	// multiple populations get their own streams seeded from it
+	std::vector<SGeneticIsland> islands(mIslands > 1 ? mIslands : 1);
+	if (islands.size() == 1) {
+		islands[0].pRandom = &mRandom;
+	} else {
+		for (unsigned int iix=0; iix<islands.size(); iix++) {
+			islands[iix].random = std::mt19937(mRandom());
+			islands[iix].pRandom = &(islands[iix].random);
 		}
 	}
-	for (int pix=0; pix<pop_num; pix++) {
-		(*pop)[pix]->mfitness = max_fitness - (*pop)[pix]->fitness;
-	}
-
 
-	std::vector<CGeneticSchedule*>* newpop = new std::vector<CGeneticSchedule*>();
-	std::vector<CGeneticSchedule*>* tmp = new std::vector<CGeneticSchedule*>();
-
-	for(int pix=0; pix < pop_num; pix++) {
-		newpop->push_back(new CGeneticSchedule(max_num, machines));
-		tmp->push_back(new CGeneticSchedule(max_num, machines));
+	// select the fitness function once, so the evaluation of the populations does not check the fitness type
+	if (getFitnessType() == GENETIC_FITNESS_ENERGY) {
+		state = evolveIslands<GENETIC_FITNESS_ENERGY>(islands, &problem, interrupt);
+	} else {
+		state = evolveIslands<GENETIC_FITNESS_MAKESPAN>(islands, &problem, interrupt);
 	}
 
-	CLogger::mainlog->debug("ScheduleAlgorithmGenetic: best fitness initial: %f", best_fitness);
-
-	int nochange = 0;
-	int max_nochange = 10;
-	double crossover_prob = 0.6;
-	double mutation_prob = 0.6;
-	int count = 0;
-	bool interrupted = false;
-	do {
-
-		// reproduction
-		for (int ix=0; ix<pop_num; ix++) {
-			if(pop->at(ix)->check() == false) {
-				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before reproduction");
-			}
-		}
-		reproduction(pop, newpop);
-		for (int ix=0; ix<pop_num; ix++) {
-			if(pop->at(ix)->check() == false) {
-				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after reproduction");
-			}
-		}
-		//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: pop_num %d",pop_num);
-		// crossover
-		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: Crossover");
-		for (int cix=0; cix<pop_num/2; cix++) {
-			double guess = (double)mRandom() / (double)mRandom.max();
-			(*newpop)[cix]->transfer((*tmp)[cix*2]);
-		
-			//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: newpop %d tmp %d", pop_num/2 + cix, cix*2 + 1);
-			(*newpop)[pop_num/2 + cix]->transfer((*tmp)[cix*2 + 1]);
-			if (guess < crossover_prob) {
-				// apply crossover
-				if ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false ) {
-					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before crossover");
-				}
-					
-				//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: apply crossover");
-				crossover((*tmp)[cix*2], (*tmp)[cix*2 + 1], height_num, machines, height, max_num);
-				if ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false ) {
-					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after crossover");
-					
-				}
-			}
-		}
-
-		// mutation
-		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: Mutation");
-		for (int pix=0; pix<pop_num; pix++) {
-			double guess = (double)mRandom() / (double)mRandom.max();
-			if (guess < mutation_prob) {
-				// apply mutation
-				mutate((*tmp)[pix], height, machines, height_num, height_sets, max_num);
-			}
-		}
-
-
+	if (state == COMPUTE_STOP) {
+		CLogger::mainlog->info("ScheduleAlgorithmGenetic: stopped after %d generations, using best schedule so far", islands[0].count);
+	}
 
-		// recompute fitness for new population
-		int worst_pix = -1;
-		double worst_fitness = 0.0;
-		int new_best_ix = -1;
-		double new_best_fitness = 0.0;
-		for (int pix=0; pix<pop_num; pix++) {
-			fitness((*tmp)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
-			if ((*tmp)[pix]->fitness > max_fitness) {
-				max_fitness = (*tmp)[pix]->fitness;
-			}
-			if (worst_pix == -1 || (*tmp)[pix]->fitness > worst_fitness) {
-				worst_pix = pix;
-				worst_fitness = (*tmp)[pix]->fitness;
+	if (state != COMPUTE_ABORT) {
+		// best individual of all islands
+		SGeneticIsland* best = &(islands[0]);
+		for (unsigned int iix=0; iix<islands.size(); iix++) {
+			CLogger::mainlog->debug("ScheduleAlgorithmGenetic: island %d generations %d best fitness %f", iix, islands[iix].count, islands[iix].best_fitness);
+			if (islands[iix].best_fitness < best->best_fitness) {
+				best = &(islands[iix]);
 			}
-			if (new_best_ix == -1 || (*tmp)[pix]->fitness < new_best_fitness) {
-				new_best_ix = pix;
-				new_best_fitness = (*tmp)[pix]->fitness;
-			}
-			
-			CLogger::mainlog->debug("ScheduleAlgorithmGenetic: ix %d fitness %f", pix,  (*tmp)[pix]->fitness);
 		}
-
-		for (int pix=0; pix<pop_num; pix++) {
-			(*pop)[pix]->mfitness = max_fitness - (*pop)[pix]->fitness;
-		}
-
-		// replace worst node with best node
-		(*pop)[best_ix]->transfer((*tmp)[worst_pix]);
-		best_ix = worst_pix;
-		if (new_best_fitness < best_fitness) {
-			best_ix = new_best_ix;
-			best_fitness = new_best_fitness;
-			nochange = 0;
-		} else {
-			nochange++;
-		}
-		std::vector<CGeneticSchedule*>* swap = pop;
-		pop = tmp;
-		tmp = swap;
-		count++;
-		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: best fitness round %d: %f", count, best_fitness);
-
-		if (*interrupt == 1) {
-			interrupted = true;
-		}
-
-	} while ( nochange < max_nochange && interrupted == false);
-
-	if (interrupted == false) {
-		CGeneticSchedule* bestsched = (*pop)[best_ix];
+		CGeneticSchedule* bestsched = (*best->pop)[best->best_ix];
 
 		// add task to machine queue
 		for (int mix=0; mix<machines; mix++) {
+			int* queue = bestsched->queue(mix);
 			for (int rix=0; rix<bestsched->num[mix]; rix++) {
-				int tix = bestsched->tasks[mix*max_num + rix];
-				STaskEntry* entry = new STaskEntry();
+				int tix = queue[rix];
+				STaskEntry* entry = sched->newEntry();
 				entry->taskcopy = &((*pTasks)[tix]);
 				entry->taskid = entry->taskcopy->mId;
 				entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -909,18 +1318,16 @@ CSchedule* CScheduleAlgorithmGenetic::compute(std::vector<CTaskCopy>* pTasks, st
 
 	// clean up
 	delete[] height_sets;
-	delete[] height;
-	for (int pix=0; pix<pop_num; pix++) {
-		delete pop->back();
-		delete newpop->back();
-		delete tmp->back();
-		pop->pop_back();
-		newpop->pop_back();
-		tmp->pop_back();
+	for (unsigned int iix=0; iix<islands.size(); iix++) {
+		freePopulation(&(islands[iix]));
 	}
-	delete pop;
-	delete newpop;
-	delete tmp;
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterGenetic("Genetic", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmGenetic(rResources, CScheduleAlgorithmGenetic::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
+});
+static CScheduleAlgorithmRegistrar sRegisterGeneticEnergy("GeneticEnergy", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmGenetic(rResources, CScheduleAlgorithmGenetic::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
+});
@@ -5,6 +5,7 @@
 #define __CSCHEDULEALGORITHMGENETIC_H__
 #include <random>
 #include <cstring>
+#include <functional>
 #include <unordered_map>
 #include "CLogger.h"
 #include "CScheduleAlgorithm.h"
@@ -13,6 +14,7 @@ namespace sched {
 namespace algorithm {
 
 	class CEstimation;
+	class CEstimationMatrix;
 
 
 
@@ -24,18 +26,40 @@ namespace algorithm {
 			GENETIC_FITNESS_ENERGY
 		};
 
+		/// @brief Chromosome with one task queue per machine
+		///
+		/// The queues of all machines are stored back to back in one array of max_num task indices,
+		/// so a schedule is max_num + machines ints regardless of the number of machines.
+		/// The storage is either owned by the schedule or part of a population buffer.
 		class CGeneticSchedule{
 			public:
-				int max_num;
+				int max_num; // number of tasks
 				int machines;
-				// array for $max_num tasks per machine
-				int* tasks; // max_num * machines
-				// array of number of tasks per array in $tasks
-				int* num; // real max index for each machine
+				// task indices of all machine queues, back to back
+				int* tasks; // max_num
+				// array of number of tasks per machine queue in $tasks
+				int* num; // machines
 				double fitness;
 				double mfitness; // max_fitness so far - fitness
+			private:
+				bool own; ///< Storage allocated by the schedule
 			public:
 				CGeneticSchedule(int max_num, int machines);
+				/// @brief Creates a schedule on external storage
+				/// @param buffer Storage of size(max_num, machines) ints, has to outlive the schedule
+				CGeneticSchedule(int max_num, int machines, int* buffer);
+				CGeneticSchedule(const CGeneticSchedule&) = delete;
+				CGeneticSchedule& operator=(const CGeneticSchedule&) = delete;
+				/// @brief Number of ints required for the storage of one schedule
+				static int size(int max_num, int machines);
+				/// @brief Returns the task queue of a machine
+				inline int* queue(int mix) {
+					int offset = 0;
+					for (int i=0; i<mix; i++) {
+						offset += num[i];
+					}
+					return tasks + offset;
+				}
 				bool check();
 				void print();
 				CGeneticSchedule* copy();
@@ -44,28 +68,190 @@ namespace algorithm {
 		};
 
 		protected:
+			/// @brief Task graph data shared by all populations of one computation
+			struct SGeneticProblem {
+				int tasks;
+				int machines;
+				int max_num;
+				int height_num;
+				int* height; ///< Height of each task
+				std::vector<int>* height_sets; ///< Task indices for each height
+				std::vector<CTaskCopy>* pTasks;
+				std::unordered_map<int,int>* taskmap; ///< Task id to task index
+				double double_max; ///< Penalty for incompatible task/resource combinations
+				std::vector<CTaskCopy*>* runningTasks;
+			};
+
+			/// @brief Population evolving with its own random number stream
+			struct SGeneticIsland {
+				std::mt19937 random;
+				std::mt19937* pRandom = 0; ///< Random number stream used for evolution
+				std::vector<CGeneticSchedule*>* pop = 0; ///< Current population
+				std::vector<CGeneticSchedule*>* newpop = 0; ///< Selected individuals
+				std::vector<CGeneticSchedule*>* tmp = 0; ///< Next population
+				std::vector<int> genes; ///< Storage of all schedules of pop, newpop and tmp
+				int best_ix = -1; ///< Index of best individual in pop
+				double best_fitness = 0.0;
+				double max_fitness = 0.0; ///< Worst fitness seen so far
+				int nochange = 0; ///< Generations without improvement
+				int count = 0; ///< Generations
+			};
+
+			/// @brief Buffers of one thread for the fitness functions
+			struct SFitnessScratch {
+				std::vector<double> finish; ///< Finish time per task
+				std::vector<double> energy; ///< Energy per task
+				std::vector<int> progress; ///< Next queue position per machine
+			};
+
+			/// @brief Swap of two tasks of the same height as applied by mutate
+			struct SGeneticSwap {
+				int tix = -1; ///< First task or -1 if the schedule was not changed
+				int mix = -1; ///< Machine of the first task before the swap
+				int rix = -1; ///< Queue position of the first task
+				int tix2 = -1; ///< Second task
+				int mix2 = -1; ///< Machine of the second task before the swap
+				int rix2 = -1; ///< Queue position of the second task
+			};
+
+			/// @brief Fitness state of one schedule for incremental evaluation of swaps
+			///
+			/// The finish time of a task only depends on its machine and the finish times of its predecessors.
+			/// This mirrors fitness(), which reads the finish time of the previous task on the
+			/// same machine as finish[queue[rix]], the not yet computed slot of the task itself, so the queue order does not
+			/// delay a task. If this line read finish[queue[rix-1]], the cache has to keep the finish times per machine queue.
+			/// With genetic_validate the simulated annealing compares every cached evaluation with a full evaluation.
+			/// A swap of two tasks of the same height therefore only changes the finish times of the two tasks and their descendants,
+			/// which all have a larger height.
+			/// Only these tasks are recomputed, height by height, and propagation stops at tasks whose finish time did not change.
+			/// The latest finish time and the task energy sum are kept per height, so the fitness is combined from the unchanged heights and the recomputed ones.
+			/// A trial evaluation does not change the cached state until it is committed.
+			struct SFitnessCache {
+				std::vector<double> finish; ///< Finish time per task
+				std::vector<double> energy; ///< Energy per task
+				std::vector<int> machine; ///< Machine per task
+				std::vector<double> heightFinish; ///< Latest finish time per height
+				std::vector<double> heightEnergy; ///< Task energy sum per height
+				std::vector<int> predStart; ///< Start of the predecessor indices in pred per task, tasks+1 entries
+				std::vector<int> pred; ///< Predecessor task indices
+				std::vector<int> succStart; ///< Start of the successor indices in succ per task, tasks+1 entries
+				std::vector<int> succ; ///< Successor task indices
+				double fitness = 0.0; ///< Fitness of the cached state
+
+				SGeneticSwap swap; ///< Swap of the last trial
+				int swapHeight = 0; ///< Height of the swapped tasks of the last trial
+				std::vector<double> trialFinish; ///< Recomputed finish time per task
+				std::vector<unsigned int> trialStamp; ///< Trial that recomputed the task, by task index
+				std::vector<double> trialHeightFinish; ///< Recomputed latest finish time per height
+				std::vector<unsigned int> trialHeightStamp; ///< Trial that recomputed the height, by height
+				std::vector<std::vector<int>> dirty; ///< Tasks to recompute per height
+				std::vector<int> changed; ///< Recomputed tasks of the last trial
+				double trialTaskEnergy = 0.0; ///< Energy of the first swapped task on its new machine
+				double trialTaskEnergy2 = 0.0; ///< Energy of the second swapped task on its new machine
+				double trialEnergy = 0.0; ///< Recomputed task energy sum of the height of the swap
+				double trialFitness = 0.0; ///< Fitness of the last trial
+				unsigned int trial = 0; ///< Number of trials
+			};
+
+			static const int MAX_NOCHANGE = 10; ///< Generations without improvement until a population stops
+
 			CEstimation* mpEstimation;
+			CEstimationMatrix* mpMatrix = 0; ///< Estimations for the current computation
+			std::vector<double> mIdlePower; ///< Resource idle power for the current computation
+			std::vector<SFitnessScratch> mScratch; ///< Fitness buffers by thread index
 			std::mt19937 mRandom;
+			bool mValidate = false; ///< Check schedules after each genetic operation, for tests and debugging
 			enum EGeneticFitnessType mFitnessType = GENETIC_FITNESS_MAKESPAN;
+			unsigned int mPopulationSize = 20; ///< Individuals per population
+			unsigned int mIslands = 1; ///< Number of populations
+			unsigned int mMigrationInterval = 5; ///< Generations between migrations
 
 		protected:
+			/// @param buffer Storage for the new schedule, optional, see CGeneticSchedule::size()
 			CGeneticSchedule* generateSchedule(
-				std::vector<int>* height_sets, int height_num, int machines, int max_num, std::vector<CTaskCopy>* pTasks
+				std::mt19937& rRandom,
+				std::vector<int>* height_sets, int height_num, int machines, int max_num, std::vector<CTaskCopy>* pTasks,
+				int* buffer = 0
 				);
 
-			void mutate(CGeneticSchedule* sched, int* height, int machines, int height_num, std::vector<int>* height_sets, int max_num);
+			/// @brief Swaps two random tasks of the same height
+			/// @param[out] swap Applied swap, optional
+			void mutate(std::mt19937& rRandom, CGeneticSchedule* sched, int* height, int machines, int height_num, std::vector<int>* height_sets, int max_num, SGeneticSwap* swap = 0);
+
+
+			/// @brief Exchanges the machine queue tails above a random height between two schedules
+			/// @param a First parent
+			/// @param b Second parent
+			/// @param[out] a_out Heads of a with tails of b
+			/// @param[out] b_out Heads of b with tails of a
+			void crossover(std::mt19937& rRandom, CGeneticSchedule* a, CGeneticSchedule* b, CGeneticSchedule* a_out, CGeneticSchedule* b_out, int height_num, int machines, int* height, int max_num);
+
+			void reproduction(std::mt19937& rRandom, std::vector<CGeneticSchedule*>* pop, std::vector<CGeneticSchedule*>* newpop);
+
+
+			/// @brief Prepares the estimations used by the fitness functions for the given task list
+			void prepareFitness(std::vector<CTaskCopy>* pTasks);
+
+			/// @brief Computes the fitness of a schedule for the fitness type of the algorithm
+			void fitness(CGeneticSchedule* sched, SFitnessScratch* scratch, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
+
+			/// @brief Computes the makespan or energy fitness of a schedule
+			/// @tparam Fitness Fitness type, the energy sums are only compiled into the energy instance
+			template <enum EGeneticFitnessType Fitness>
+			void fitness(CGeneticSchedule* sched, SFitnessScratch* scratch, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
+
+			/// @brief Duration of a task on a machine as used by the fitness functions
+			/// Incompatible task/machine combinations are punished with double_max.
+			/// @tparam Fitness Fitness type, selects the validity check at compile time
+			template <enum EGeneticFitnessType Fitness>
+			double fitnessDuration(int tix, int mix, std::vector<CTaskCopy>* pTasks, double double_max);
+
+			/// @brief Computes the full fitness state of a schedule
+			/// The fitness of the schedule object itself is not changed.
+			/// The fitness cache methods are instantiated for both fitness types,
+			/// the caller selects the instance once per computation, see getFitnessType().
+			/// @return Fitness of the schedule
+			template <enum EGeneticFitnessType Fitness>
+			double fitnessCacheInit(SFitnessCache* cache, CGeneticSchedule* sched, SGeneticProblem* problem);
+
+			/// @brief Computes the fitness of the cached schedule with a swap applied, without changing the cached state
+			/// @param swap Swap as reported by mutate
+			/// @return Fitness of the changed schedule
+			template <enum EGeneticFitnessType Fitness>
+			double fitnessCacheTrial(SFitnessCache* cache, SGeneticSwap* swap, SGeneticProblem* problem);
+
+			/// @brief Applies the last trial to the cached state
+			template <enum EGeneticFitnessType Fitness>
+			void fitnessCacheCommit(SFitnessCache* cache);
 
+			/// @brief Returns the fitness type of the algorithm
+			inline enum EGeneticFitnessType getFitnessType() {
+				return mFitnessType;
+			}
 
-			void crossover(CGeneticSchedule* a, CGeneticSchedule* b, int height_num, int machines, int* height, int max_num);
+			/// @brief Generates the initial population of an island and computes its fitness
+			template <enum EGeneticFitnessType Fitness>
+			void initPopulation(SGeneticIsland* island, SGeneticProblem* problem);
 
-			void reproduction(std::vector<CGeneticSchedule*>* pop, std::vector<CGeneticSchedule*>* newpop);
+			/// @brief Computes one generation of an island
+			template <enum EGeneticFitnessType Fitness>
+			void evolve(SGeneticIsland* island, SGeneticProblem* problem);
 
+			/// @brief Initializes the islands and evolves them until they converge or the computation is interrupted
+			/// compute() selects the instance for the fitness type of the algorithm.
+			/// @return State of the computation after the last generation
+			template <enum EGeneticFitnessType Fitness>
+			EComputeState evolveIslands(std::vector<SGeneticIsland>& islands, SGeneticProblem* problem, volatile int* interrupt);
 
-			void fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
+			/// @brief Sends the best individual of every island to the next island in a ring
+			/// The migrant replaces the worst individual of the target island if it is better.
+			void migrate(std::vector<SGeneticIsland>& islands);
 
-			void fitnessMakespan(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
+			/// @brief Applies the function to all islands in parallel
+			void runIslands(std::vector<SGeneticIsland>& islands, std::function<void(SGeneticIsland*)> function);
 
-			void fitnessEnergy(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
+			/// @brief Frees the populations of an island
+			void freePopulation(SGeneticIsland* island);
 
 		public:
 			CScheduleAlgorithmGenetic(std::vector<CResource*>& rResources, enum EGeneticFitnessType fitness);
@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmGeneticDyn.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -125,6 +126,8 @@ int CScheduleAlgorithmGeneticDyn::init() {
 
 	mRandom = std::mt19937(seed);
 
+	mValidate = loadValidate("ScheduleAlgorithmGeneticDyn");
+
 	return 0;
 }
 
@@ -193,7 +196,7 @@ CScheduleAlgorithmGeneticDyn::CGeneticSchedule* CScheduleAlgorithmGeneticDyn::ge
 		}
 	}
 
-	if (sched->check() == false) {
+	if (mValidate == true && sched->check() == false) {
 		
 		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: fuck");
 	}
@@ -269,7 +272,7 @@ void CScheduleAlgorithmGeneticDyn::mutate(CGeneticSchedule* sched, int* height,
 	if (mix2 == -1 || rix2 == -1) {
 		
 		//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: tix %d not found, sched %x, tix_height %d, hix %d, machines %d", tix2, sched, tix_height, hix, machines);
-		if (sched->check() == false) {
+		if (mValidate == true && sched->check() == false) {
 			CLogger::mainlog->debug("ScheduleAlgorithmGenetic: not found fuck");
 		}
 	}
@@ -395,49 +398,30 @@ void CScheduleAlgorithmGeneticDyn::reproduction(std::vector<CGeneticSchedule*>*
 	pop->at(max_fitness_pix)->transfer(newpop->back());
 }
 
-void CScheduleAlgorithmGeneticDyn::fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap,double double_max, std::vector<CTaskCopy*>* runningTasks){
+void CScheduleAlgorithmGeneticDyn::fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
 
 	switch(mFitnessType) {
 		case GENETIC_FITNESS_ENERGY:
-			
-			fitnessEnergy(sched,
-				tasks,
-				height_sets,
-				height,
-				machines,
-				height_num,
-				pTasks,
-				max_num,
-				taskmap,
-				double_max,
-				runningTasks);
-
+			fitness<GENETIC_FITNESS_ENERGY>(sched, tasks, height_sets, height, machines, height_num, pTasks, max_num, taskmap, double_max, runningTasks);
 		break;
 
 		default:
 		case GENETIC_FITNESS_MAKESPAN:
-
-			fitnessMakespan(sched,
-				tasks,
-				height_sets,
-				height,
-				machines,
-				height_num,
-				pTasks,
-				max_num,
-				taskmap,
-				double_max, 
-				runningTasks);
-
+			fitness<GENETIC_FITNESS_MAKESPAN>(sched, tasks, height_sets, height, machines, height_num, pTasks, max_num, taskmap, double_max, runningTasks);
 		break;
 	}
 
 }
 
-void CScheduleAlgorithmGeneticDyn::fitnessMakespan(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
+template <enum CScheduleAlgorithmGeneticDyn::EGeneticFitnessType Fitness>
+void CScheduleAlgorithmGeneticDyn::fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
 
 	// finishing time
 	double* finish = new double[tasks]();
+	double* energy = 0;
+	if (Fitness == GENETIC_FITNESS_ENERGY) {
+		energy = new double[tasks]();
+	}
 	int* progress = new int[machines]();
 	double max_finish = 0.0;
 	for (int hix=0; hix<height_num; hix++) {
@@ -459,7 +443,7 @@ void CScheduleAlgorithmGeneticDyn::fitnessMakespan(CGeneticSchedule* sched, int
 				int run_mix = findRunMix(runningTasks, task->mId);
 
 				double preFinish = 0.0;
-			
+
 				// check finish time of previous task on same time
 				if (rix > 0) {
 					preFinish = finish[sched->tasks[max_num*mix + rix]];
@@ -477,17 +461,33 @@ void CScheduleAlgorithmGeneticDyn::fitnessMakespan(CGeneticSchedule* sched, int
 				double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
 				double fini = mpEstimation->taskTimeFini(task, res);
 
+				double initEnergy = 0.0;
+				double computeEnergy = 0.0;
+				double finiEnergy = 0.0;
+				if (Fitness == GENETIC_FITNESS_ENERGY) {
+					initEnergy = mpEstimation->taskEnergyInit(task, res);
+					computeEnergy = mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints);
+					finiEnergy = mpEstimation->taskEnergyFini(task, res);
+				}
+
 				// remove init time if task is already running and is in slot 0
 				if (run_mix == mix && rix == 0) {
 					init = 0.0;
+					initEnergy = 0.0;
 				}
 
 				double dur = init + compute + fini;
 
-				// task not valid for this resource
-				if (dur == 0) {
-					//dur = std::numeric_limits<double>::max();
-					//dur = 1000000000000.0;
+				if (Fitness == GENETIC_FITNESS_ENERGY) {
+					double task_energy = initEnergy + computeEnergy + finiEnergy;
+					if (task->validResource(res) == false) {
+						// task is not compatible with resource
+						task_energy = double_max;
+						dur = double_max;
+					}
+					energy[tix] = task_energy;
+				} else if (dur == 0) {
+					// task not valid for this resource
 					dur = double_max;
 				}
 
@@ -518,103 +518,9 @@ void CScheduleAlgorithmGeneticDyn::fitnessMakespan(CGeneticSchedule* sched, int
 	delete[] finish;
 	delete[] progress;
 
-	sched->fitness = max_finish;
-}
-
-void CScheduleAlgorithmGeneticDyn::fitnessEnergy(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
-
-	// finishing time
-	double* finish = new double[tasks]();
-	double* energy = new double[tasks]();
-	int* progress = new int[machines]();
-	double max_finish = 0.0;
-	for (int hix=0; hix<height_num; hix++) {
-
-		for (int mix=0; mix<machines; mix++) {
-			for (int rix=progress[mix]; rix<sched->num[mix]; rix++) {
-
-				if (rix == sched->num[mix]) {
-					continue;
-				}
-
-				int tix = sched->tasks[max_num*mix + rix];
-				if (height[tix] > hix) {
-					break;
-				}
-
-				CTaskCopy* task = &((*pTasks)[tix]);
-				// check if task already running on this machine
-				int run_mix = findRunMix(runningTasks, task->mId);
-
-				double preFinish = 0.0;
-
-				// check finish time of previous task on same time
-				if (rix > 0) {
-					preFinish = finish[sched->tasks[max_num*mix + rix]];
-				}
-
-				// add fini time if task is running on different machine
-				if (run_mix != -1 && run_mix != mix) {
-					double run_fini = mpEstimation->taskTimeFini(task, mrResources[run_mix]);
-					preFinish = preFinish < run_fini ? run_fini : preFinish;
-				}
-
-				// compute duration
-				CResource* res = mrResources[mix];
-				double init = mpEstimation->taskTimeInit(task, res);
-				double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-				double fini = mpEstimation->taskTimeFini(task, res);
-
-				double initEnergy = mpEstimation->taskEnergyInit(task, res);
-				double computeEnergy = mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints);
-				double finiEnergy = mpEstimation->taskEnergyFini(task, res);
-
-				// remove init time if task is already running and is in slot 0
-				if (run_mix == mix && rix == 0) {
-					init = 0.0;
-					initEnergy = 0.0;
-				}
-
-				double dur = init + compute + fini;
-            	double task_energy = initEnergy + computeEnergy + finiEnergy;
-
-                if (std::find(task->mpResources->begin(),
-                        task->mpResources->end(), res)
-                    == task->mpResources->end()) {
-                    // task is not compatible with resource
-                    //task_energy = std::numeric_limits<double>::max();
-                    //dur = std::numeric_limits<double>::max();
-                    //task_energy = 10000000000000000.0;
-                    //dur = 1000000000000.0;
-					task_energy = double_max;
-					dur = double_max;
-                }
-
-
-				energy[tix] = task_energy;
-
-				// find max finish time of preceeding tasks
-				// preceeding tasks need to be in previous height_sets
-				for (int six=0; six<task->mPredecessorNum; six++) {
-					int sid = task->mpPredecessorList[six];
-					int stask_ix = -1;
-					// stask_ix should always be in the map
-					stask_ix = (*taskmap)[sid];
-					if (finish[stask_ix] > preFinish) {
-						preFinish = finish[stask_ix];
-					}
-				}
-
-				// set finish time
-				finish[tix] = preFinish + dur;
-
-				if (finish[tix] > max_finish) {
-					max_finish = finish[tix];
-				}
-
-				progress[mix]++;
-			}
-		}
+	if (Fitness == GENETIC_FITNESS_MAKESPAN) {
+		sched->fitness = max_finish;
+		return;
 	}
 
 	double E_dynamic = 0.0;
@@ -632,15 +538,14 @@ void CScheduleAlgorithmGeneticDyn::fitnessEnergy(CGeneticSchedule* sched, int ta
 		E_static += max_finish * res_idle_power;
 	}
 
-	delete[] finish;
-	delete[] progress;
 	delete[] energy;
 
 	sched->fitness = E_static + E_dynamic;
 }
 
 
-CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
+template <enum CScheduleAlgorithmGeneticDyn::EGeneticFitnessType Fitness>
+CSchedule* CScheduleAlgorithmGeneticDyn::computeFitness(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
@@ -669,7 +574,7 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -687,13 +592,13 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 
 	// prepare tasks
 	// compute height for every task
-	int* height = new int[tasks]();
+	int* height = sched->mArena.createArray<int>(tasks);
 	for (int ix=0; ix<tasks; ix++) {
 		height[ix] = -1;
 	}
 	int max_height = -1;
 	// for each task traverse successor tasks to set height
-	int* stack = new int[tasks*2](); // taskid, height
+	int* stack = sched->mArena.createArray<int>(tasks*2); // taskid, height
 	int stackIx = 0; // next element
 	for (int ix=0; ix<tasks; ix++) {
 		if (height[ix] != -1) {
@@ -752,7 +657,6 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 			}
 		}
 	}
-	delete[] stack;
 
 	// all tasks have height 0 ?
 	if (tasks > 0 && max_height == -1) {
@@ -788,7 +692,7 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 	int best_ix = -1;
 	double best_fitness = 0.0;
 	for (int pix=0; pix<pop_num; pix++) {
-		fitness((*pop)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
+		fitness<Fitness>((*pop)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
 
 		if ((*pop)[pix]->fitness > max_fitness) {
 			max_fitness = (*pop)[pix]->fitness;
@@ -818,19 +722,23 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 	double crossover_prob = 0.6;
 	double mutation_prob = 0.6;
 	int count = 0;
-	bool interrupted = false;
+	EComputeState state = COMPUTE_CONTINUE;
 	do {
 
 		// reproduction
-		for (int ix=0; ix<pop_num; ix++) {
-			if(pop->at(ix)->check() == false) {
-				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before reproduction");
+		if (mValidate == true) {
+			for (int ix=0; ix<pop_num; ix++) {
+				if(pop->at(ix)->check() == false) {
+					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before reproduction");
+				}
 			}
 		}
 		reproduction(pop, newpop);
-		for (int ix=0; ix<pop_num; ix++) {
-			if(pop->at(ix)->check() == false) {
-				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after reproduction");
+		if (mValidate == true) {
+			for (int ix=0; ix<pop_num; ix++) {
+				if(pop->at(ix)->check() == false) {
+					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after reproduction");
+				}
 			}
 		}
 		//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: pop_num %d",pop_num);
@@ -844,13 +752,13 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 			(*newpop)[pop_num/2 + cix]->transfer((*tmp)[cix*2 + 1]);
 			if (guess < crossover_prob) {
 				// apply crossover
-				if ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false ) {
+				if (mValidate == true && ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false)) {
 					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before crossover");
 				}
 					
 				//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: apply crossover");
 				crossover((*tmp)[cix*2], (*tmp)[cix*2 + 1], height_num, machines, height, max_num);
-				if ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false ) {
+				if (mValidate == true && ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false)) {
 					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after crossover");
 					
 				}
@@ -875,7 +783,7 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 		int new_best_ix = -1;
 		double new_best_fitness = 0.0;
 		for (int pix=0; pix<pop_num; pix++) {
-			fitness((*tmp)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
+			fitness<Fitness>((*tmp)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
 			if ((*tmp)[pix]->fitness > max_fitness) {
 				max_fitness = (*tmp)[pix]->fitness;
 			}
@@ -911,20 +819,22 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 		count++;
 		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: best fitness round %d: %f", count, best_fitness);
 
-		if (*interrupt == 1) {
-			interrupted = true;
-		}
+		state = computeState(interrupt);
+
+	} while ( nochange < max_nochange && state == COMPUTE_CONTINUE);
 
-	} while ( nochange < max_nochange && interrupted == false);
+	if (state == COMPUTE_STOP) {
+		CLogger::mainlog->info("ScheduleAlgorithmGenetic: stopped after %d generations, using best schedule so far", count);
+	}
 
-	if (interrupted == false) {
+	if (state != COMPUTE_ABORT) {
 		CGeneticSchedule* bestsched = (*pop)[best_ix];
 
 		// add task to machine queue
 		for (int mix=0; mix<machines; mix++) {
 			for (int rix=0; rix<bestsched->num[mix]; rix++) {
 				int tix = bestsched->tasks[mix*max_num + rix];
-				STaskEntry* entry = new STaskEntry();
+				STaskEntry* entry = sched->newEntry();
 				entry->taskcopy = &((*pTasks)[tix]);
 				entry->taskid = entry->taskcopy->mId;
 				entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -940,7 +850,6 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 
 	// clean up
 	delete[] height_sets;
-	delete[] height;
 	for (int pix=0; pix<pop_num; pix++) {
 		delete pop->back();
 		delete newpop->back();
@@ -956,6 +865,15 @@ CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks,
 	return sched;
 }
 
+CSchedule* CScheduleAlgorithmGeneticDyn::compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
+
+	// select the fitness function once, so the evaluation of the populations does not check the fitness type
+	if (mFitnessType == GENETIC_FITNESS_ENERGY) {
+		return computeFitness<GENETIC_FITNESS_ENERGY>(pTasks, runningTasks, interrupt, updated);
+	}
+	return computeFitness<GENETIC_FITNESS_MAKESPAN>(pTasks, runningTasks, interrupt, updated);
+}
+
 int CScheduleAlgorithmGeneticDyn::findRunMix(std::vector<CTaskCopy*>* tasks, int tid) {
 
 	for (unsigned int i=0; i<tasks->size(); i++) {
@@ -966,3 +884,10 @@ int CScheduleAlgorithmGeneticDyn::findRunMix(std::vector<CTaskCopy*>* tasks, int
 	return -1;
 
 }
+
+static CScheduleAlgorithmRegistrar sRegisterGeneticDyn("GeneticDyn", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmGeneticDyn(rResources, CScheduleAlgorithmGeneticDyn::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
+});
+static CScheduleAlgorithmRegistrar sRegisterGeneticEnergyDyn("GeneticEnergyDyn", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmGeneticDyn(rResources, CScheduleAlgorithmGeneticDyn::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
+});
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include "CScheduleAlgorithmGeneticMigDyn.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CScheduleAlgorithmGeneticMigSolverLPDyn.h"
 #include "CScheduleAlgorithmGeneticMigSolverLPEnergyDyn.h"
 #include "CTask.h"
@@ -203,15 +204,18 @@ int CScheduleAlgorithmGeneticMigDyn::init() {
 
 	mRandom = std::mt19937(seed);
 
+	mValidate = loadValidate("ScheduleAlgorithmGeneticMigDyn");
+
 	std::string* solver = 0;
 	ret = config->conf->getString((char*)"geneticmig_solver", &solver);
 	if (-1 == ret) {
-		CLogger::mainlog->error("ScheduleAlgorithmGenetic: geneticmig_solver not found in config");
-		return -1;
+		mpSolverPath = (char*) "internal";
+		CLogger::mainlog->info("ScheduleAlgorithmGenetic: config key \"geneticmig_solver\" not found, using default: internal");
+	} else {
+		mpSolverPath = (char*) solver->c_str();
 	}
-	CLogger::mainlog->info("ScheduleAlgorithmGenetic: solver: %s", solver);
+	CLogger::mainlog->info("ScheduleAlgorithmGenetic: solver: %s", mpSolverPath);
 
-	mpSolverPath = (char*) solver->c_str();
 	CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"geneticmig_solver\",\"value\":\"%s\"", mpSolverPath);
 
 	return 0;
@@ -287,7 +291,7 @@ CScheduleAlgorithmGeneticMigDyn::CGeneticSchedule* CScheduleAlgorithmGeneticMigD
 		}
 	}
 
-	if (sched->check() == false) {
+	if (mValidate == true && sched->check() == false) {
 		
 		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: fuck");
 	}
@@ -358,7 +362,7 @@ bool CScheduleAlgorithmGeneticMigDyn::mutate(CGeneticSchedule* sched, int* heigh
 
 	if (found == false) {
 		//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: tix %d not found, sched %x, tix_height %d, hix %d, machines %d", tix2, sched, tix_height, hix, machines);
-		if (sched->check() == false) {
+		if (mValidate == true && sched->check() == false) {
 		}
 		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: not found fuck");
 	}
@@ -533,47 +537,23 @@ void CScheduleAlgorithmGeneticMigDyn::reproduction(std::vector<CGeneticSchedule*
 	pop->at(max_fitness_pix)->transfer(newpop->back());
 }
 
-void CScheduleAlgorithmGeneticMigDyn::fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap,double double_max, std::vector<CTaskCopy*>* runningTasks){
+void CScheduleAlgorithmGeneticMigDyn::fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
 
 	switch(mFitnessType) {
 		case GENETIC_FITNESS_ENERGY:
-			
-			fitnessEnergy(sched,
-				tasks,
-				height_sets,
-				height,
-				machines,
-				height_num,
-				pTasks,
-				max_num,
-				taskmap,
-				double_max,
-				runningTasks);
-
+			fitness<GENETIC_FITNESS_ENERGY>(sched, tasks, height_sets, height, machines, height_num, pTasks, max_num, taskmap, double_max, runningTasks);
 		break;
 
 		default:
 		case GENETIC_FITNESS_MAKESPAN:
-
-			fitnessMakespan(sched,
-				tasks,
-				height_sets,
-				height,
-				machines,
-				height_num,
-				pTasks,
-				max_num,
-				taskmap,
-				double_max,
-				runningTasks);
-
+			fitness<GENETIC_FITNESS_MAKESPAN>(sched, tasks, height_sets, height, machines, height_num, pTasks, max_num, taskmap, double_max, runningTasks);
 		break;
 	}
 
 }
 
-void CScheduleAlgorithmGeneticMigDyn::fitnessMakespan(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
-
+template <enum CScheduleAlgorithmGeneticMigDyn::EGeneticFitnessType Fitness>
+void CScheduleAlgorithmGeneticMigDyn::fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
 
 	// check schedule for validity
 	for (int mix=0; mix<machines; mix++) {
@@ -592,104 +572,25 @@ void CScheduleAlgorithmGeneticMigDyn::fitnessMakespan(CGeneticSchedule* sched, i
 		}
 	}
 
-	CScheduleAlgorithmGeneticMigSolverLPDyn::solve(sched, mrResources, mpEstimation, pTasks, taskmap, double_max, runningTasks, mpSolverPath);
-
-/*
-	// finishing time
-	double* finish = new double[tasks]();
-	int* progress = new int[machines]();
-	double max_finish = 0.0;
-	for (int hix=0; hix<height_num; hix++) {
-
-		for (int mix=0; mix<machines; mix++) {
-			for (int rix=progress[mix]; rix<sched->num[mix]; rix++) {
-
-				if (rix == sched->num[mix]) {
-					continue;
-				}
-
-				int tix = sched->get(mix, rix)->taskid;
-				if (sched->get(mix, rix)->height > hix) {
-					break;
-				}
-
-				double preFinish = 0.0;
-
-				// check finish time of previous task on same time
-				if (rix > 0) {
-					preFinish = finish[sched->get(mix, rix)->taskid];
-				}
-
-				// compute duration
-				CTaskCopy* task = &((*pTasks)[tix]);
-				CResource* res = mrResources[mix];
-				double dur = 
-					mpEstimation->taskTimeInit(task, res) +
-					mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-					mpEstimation->taskTimeFini(task, res);
-
-				// task not valid for this resource
-				if (dur == 0) {
-					//dur = std::numeric_limits<double>::max();
-					//dur = 1000000000000.0;
-					dur = double_max;
-				}
-
-				// find max finish time of preceeding tasks
-				// preceeding tasks need to be in previous height_sets
-				for (int six=0; six<task->mPredecessorNum; six++) {
-					int sid = task->mpPredecessorList[six];
-					int stask_ix = -1;
-					// stask_ix should always be in the map
-					stask_ix = (*taskmap)[sid];
-					if (finish[stask_ix] > preFinish) {
-						preFinish = finish[stask_ix];
-					}
-				}
-
-				// set finish time
-				finish[tix] = preFinish + dur;
-
-				if (finish[tix] > max_finish) {
-					max_finish = finish[tix];
-				}
-
-				progress[mix]++;
-			}
+	// the solver expects every task part exactly once
+	if (mValidate == true) {
+		if (sched->check() == false) {
+			CLogger::mainlog->debug("Solver: sched check failed");
+		} else {
+			CLogger::mainlog->debug("Solver: sched check ok");
 		}
 	}
 
-	delete[] finish;
-	delete[] progress;
-*/
-//	sched->fitness = max_finish;
-}
-
-void CScheduleAlgorithmGeneticMigDyn::fitnessEnergy(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks){
-
-	// check schedule for validity
-	for (int mix=0; mix<machines; mix++) {
-		CResource* res = mrResources[mix];
-		for (int rix=0; rix<sched->num[mix]; rix++) {
-
-			int tix = sched->get(mix, rix)->taskid;
-
-			CTaskCopy* task = &((*pTasks)[tix]);
-
-			if (task->validResource(res) == false) {
-				sched->fitness = double_max;
-				return;
-			}
-
-		}
+	if (Fitness == GENETIC_FITNESS_ENERGY) {
+		CScheduleAlgorithmGeneticMigSolverLPEnergyDyn::solve(sched, mrResources, mpEstimation, pTasks, taskmap, double_max, runningTasks, mpSolverPath);
+	} else {
+		CScheduleAlgorithmGeneticMigSolverLPDyn::solve(sched, mrResources, mpEstimation, pTasks, taskmap, double_max, runningTasks, mpSolverPath);
 	}
-
-	CScheduleAlgorithmGeneticMigSolverLPEnergyDyn::solve(sched, mrResources, mpEstimation, pTasks, taskmap, double_max, runningTasks, mpSolverPath);
-
 }
 
 
-CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
+template <enum CScheduleAlgorithmGeneticMigDyn::EGeneticFitnessType Fitness>
+CSchedule* CScheduleAlgorithmGeneticMigDyn::computeFitness(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
@@ -718,7 +619,7 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -736,13 +637,13 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 
 	// prepare tasks
 	// compute height for every task
-	int* height = new int[tasks]();
+	int* height = sched->mArena.createArray<int>(tasks);
 	for (int ix=0; ix<tasks; ix++) {
 		height[ix] = -1;
 	}
 	int max_height = -1;
 	// for each task traverse successor tasks to set height
-	int* stack = new int[tasks*2](); // taskid, height
+	int* stack = sched->mArena.createArray<int>(tasks*2); // taskid, height
 	int stackIx = 0; // next element
 	for (int ix=0; ix<tasks; ix++) {
 		if (height[ix] != -1) {
@@ -801,7 +702,6 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 			}
 		}
 	}
-	delete[] stack;
 
 	// all tasks have height 0 ?
 	if (tasks > 0 && max_height == -1) {
@@ -840,7 +740,7 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 	int best_ix = -1;
 	double best_fitness = 0.0;
 	for (int pix=0; pix<pop_num; pix++) {
-		fitness((*pop)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
+		fitness<Fitness>((*pop)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
 
 		if ((*pop)[pix]->fitness > max_fitness) {
 			max_fitness = (*pop)[pix]->fitness;
@@ -870,19 +770,23 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 	double crossover_prob = 0.6;
 	double mutation_prob = 0.6;
 	int count = 0;
-	bool interrupted = false;
+	EComputeState state = COMPUTE_CONTINUE;
 	do {
 
 		// reproduction
-		for (int ix=0; ix<pop_num; ix++) {
-			if(pop->at(ix)->check() == false) {
-				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before reproduction");
+		if (mValidate == true) {
+			for (int ix=0; ix<pop_num; ix++) {
+				if(pop->at(ix)->check() == false) {
+					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before reproduction");
+				}
 			}
 		}
 		reproduction(pop, newpop);
-		for (int ix=0; ix<pop_num; ix++) {
-			if(pop->at(ix)->check() == false) {
-				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after reproduction");
+		if (mValidate == true) {
+			for (int ix=0; ix<pop_num; ix++) {
+				if(pop->at(ix)->check() == false) {
+					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after reproduction");
+				}
 			}
 		}
 		//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: pop_num %d",pop_num);
@@ -896,13 +800,13 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 			(*newpop)[pop_num/2 + cix]->transfer((*tmp)[cix*2 + 1]);
 			if (guess < crossover_prob) {
 				// apply crossover
-				if ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false ) {
+				if (mValidate == true && ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false)) {
 					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before crossover");
 				}
 					
 				//CLogger::mainlog->debug("ScheduleAlgorithmGenetic: apply crossover");
 				crossover((*tmp)[cix*2], (*tmp)[cix*2 + 1], height_num, machines, height, max_num);
-				if ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false ) {
+				if (mValidate == true && ((*tmp)[cix*2]->check() == false || (*tmp)[cix*2 + 1]->check() == false)) {
 					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after crossover");
 					
 				}
@@ -915,7 +819,7 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 			double guess = (double)mRandom() / (double)mRandom.max();
 			if (guess < mutation_prob) {
 				// apply mutation
-				if ((*tmp)[pix]->check() == false) {
+				if (mValidate == true && (*tmp)[pix]->check() == false) {
 					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken before mutation");
 				}
 				int tries = 0;
@@ -924,12 +828,14 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 					mok = mutate((*tmp)[pix], height, machines, height_num, height_sets, max_num*2);
 					tries++;
 				} while (mok == false && tries < 5);
-				if ((*tmp)[pix]->check() == false) {
+				if (mValidate == true && (*tmp)[pix]->check() == false) {
 					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: broken after mutation");
 				}
 				if (mok == false) {
 					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: Mutation failed");
-					(*tmp)[pix]->check();
+					if (mValidate == true) {
+						(*tmp)[pix]->check();
+					}
 					CLogger::mainlog->debug("ScheduleAlgorithmGenetic: ---");
 				}
 			}
@@ -943,8 +849,13 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 		int new_best_ix = -1;
 		double new_best_fitness = 0.0;
 		for (int pix=0; pix<pop_num; pix++) {
+			// every evaluation runs the solver, so stop between evaluations
+			state = computeState(interrupt);
+			if (state != COMPUTE_CONTINUE) {
+				break;
+			}
 			CLogger::mainlog->debug("ScheduleAlgorithmGenetic: fitness call");
-			fitness((*tmp)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
+			fitness<Fitness>((*tmp)[pix], tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
 			if ((*tmp)[pix]->fitness > max_fitness) {
 				max_fitness = (*tmp)[pix]->fitness;
 			}
@@ -960,6 +871,11 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 			CLogger::mainlog->debug("ScheduleAlgorithmGenetic: ix %d fitness %f", pix,  (*tmp)[pix]->fitness);
 		}
 
+		if (state != COMPUTE_CONTINUE) {
+			// keep the last completely evaluated population
+			break;
+		}
+
 		for (int pix=0; pix<pop_num; pix++) {
 			(*pop)[pix]->mfitness = max_fitness - (*pop)[pix]->fitness;
 		}
@@ -980,21 +896,25 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 		count++;
 		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: best fitness round %d: %f", count, best_fitness);
 
-		if (*interrupt == 1) {
-			interrupted = true;
-		}
+		state = computeState(interrupt);
 
-	} while ( nochange < max_nochange && interrupted == false);
+	} while ( nochange < max_nochange && state == COMPUTE_CONTINUE);
 
-	if (interrupted == false) {
+	if (state == COMPUTE_STOP) {
+		CLogger::mainlog->info("ScheduleAlgorithmGenetic: stopped after %d generations, using best schedule so far", count);
+	}
+
+	if (state != COMPUTE_ABORT) {
 		CGeneticSchedule* bestsched = (*pop)[best_ix];
 
 		CLogger::mainlog->debug("ScheduleAlgorithmGenetic: final schedule fitness %f timestamp %ld", bestsched->fitness, bestsched->timestamp);
 		
-		if (bestsched->check() == true) {
-			CLogger::mainlog->debug("ScheduleAlgorithmGenetic: schedule seems ok");
-		} else {
-			CLogger::mainlog->debug("ScheduleAlgorithmGenetic: schedule seems broken");
+		if (mValidate == true) {
+			if (bestsched->check() == true) {
+				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: schedule seems ok");
+			} else {
+				CLogger::mainlog->debug("ScheduleAlgorithmGenetic: schedule seems broken");
+			}
 		}
 		
 
@@ -1011,7 +931,7 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 				}
 
 				CTaskCopy* task =  &((*pTasks)[tix]);
-				STaskEntry* entry = new STaskEntry();
+				STaskEntry* entry = sched->newEntry();
 				entry->taskcopy = task;
 				entry->taskid = entry->taskcopy->mId;
 				
@@ -1041,7 +961,6 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 
 	// clean up
 	delete[] height_sets;
-	delete[] height;
 	for (int pix=0; pix<pop_num; pix++) {
 		delete pop->back();
 		delete newpop->back();
@@ -1056,3 +975,19 @@ CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTas
 
 	return sched;
 }
+
+CSchedule* CScheduleAlgorithmGeneticMigDyn::compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
+
+	// select the fitness function once, so the evaluation of the populations does not check the fitness type
+	if (mFitnessType == GENETIC_FITNESS_ENERGY) {
+		return computeFitness<GENETIC_FITNESS_ENERGY>(pTasks, runningTasks, interrupt, updated);
+	}
+	return computeFitness<GENETIC_FITNESS_MAKESPAN>(pTasks, runningTasks, interrupt, updated);
+}
+
+static CScheduleAlgorithmRegistrar sRegisterGeneticMigDyn("GeneticMigDyn", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmGeneticMigDyn(rResources, CScheduleAlgorithmGeneticMigDyn::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
+});
+static CScheduleAlgorithmRegistrar sRegisterGeneticEnergyMigDyn("GeneticEnergyMigDyn", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmGeneticMigDyn(rResources, CScheduleAlgorithmGeneticMigDyn::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
+});
@@ -58,6 +58,7 @@ namespace algorithm {
 		protected:
 			CEstimation* mpEstimation;
 			std::mt19937 mRandom;
+			bool mValidate = false; ///< Check schedules after each genetic operation, for tests and debugging
 			char* mpSolverPath = 0;
 			enum EGeneticFitnessType mFitnessType = GENETIC_FITNESS_MAKESPAN;
 
@@ -76,9 +77,15 @@ namespace algorithm {
 
 			void fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
 
-			void fitnessMakespan(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
+			/// @brief Computes the makespan or energy fitness of a schedule
+			/// @tparam Fitness Fitness type, selects the objective at compile time
+			template <enum EGeneticFitnessType Fitness>
+			void fitness(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
 
-			void fitnessEnergy(CGeneticSchedule* sched, int tasks, std::vector<int>* height_sets, int* height, int machines, int height_num, std::vector<CTaskCopy>* pTasks, int max_num, std::unordered_map<int,int>* taskmap, double double_max, std::vector<CTaskCopy*>* runningTasks);
+			/// @brief Computes a schedule with the fitness function of the given fitness type
+			/// compute() selects the instance for the fitness type of the algorithm.
+			template <enum EGeneticFitnessType Fitness>
+			CSchedule* computeFitness(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated);
 
 		public:
 			CScheduleAlgorithmGeneticMigDyn(std::vector<CResource*>& rResources, enum EGeneticFitnessType fitness);
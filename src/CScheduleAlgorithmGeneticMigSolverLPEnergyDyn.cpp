@@ -2,15 +2,18 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include <cstdio>
+#include <cstring>
 #include <unistd.h>
 #include <sys/wait.h>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <ostream>
 #include "CScheduleAlgorithmGeneticMigSolverLPEnergyDyn.h"
 #include "CEstimation.h"
 #include "CLogger.h"
 #include "CConfig.h"
+#include "CLPSolver.h"
 using namespace sched::algorithm;
 using sched::task::CTask;
 using sched::algorithm::CEstimation;
@@ -40,29 +43,33 @@ void CScheduleAlgorithmGeneticMigSolverLPEnergyDyn::solve(CScheduleAlgorithmGene
 	std::vector<CTaskCopy*>* runningTasks,
 	char* solverPath) {
 
-	if (schedule->check() == false) {
-		CLogger::mainlog->debug("Solver: sched check failed");
-	} else {
-		CLogger::mainlog->debug("Solver: sched check ok");
-	}
-
 	// create timestamp
 	std::chrono::time_point<std::chrono::high_resolution_clock> now = std::chrono::high_resolution_clock::now();
 	long long timestamp = now.time_since_epoch().count();
 
 	CConfig* conf = CConfig::getConfig();
-	std::string* lpdest = 0;
-	int ret = conf->conf->getString((char*)"lp_destination", &lpdest);
-	if (ret != 0 || lpdest == 0) {		
-		CLogger::mainlog->error("Solver: lp_destination not defined");
-		return;
+	bool internal = (strcmp(solverPath, "internal") == 0);
+	bool dump = false;
+	if (conf->conf->getBool((char*)"lp_dump", &dump) == -1) {
+		dump = false;
+	}
+	uint64_t timeout = 1000;
+	if (conf->conf->getUint64((char*)"lp_timeout_ms", &timeout) == -1) {
+		timeout = 1000;
 	}
 
 	std::ostringstream lpfilename;
-	lpfilename << *lpdest << "/" << timestamp << ".lp";
-
 	std::ostringstream lpsolutionname;
-	lpsolutionname << *lpdest << "/" << timestamp << ".out";
+	if (internal == false || dump == true) {
+		std::string* lpdest = 0;
+		int ret = conf->conf->getString((char*)"lp_destination", &lpdest);
+		if (ret != 0 || lpdest == 0) {
+			CLogger::mainlog->error("Solver: lp_destination not defined");
+			return;
+		}
+		lpfilename << *lpdest << "/" << timestamp << ".lp";
+		lpsolutionname << *lpdest << "/" << timestamp << ".out";
+	}
 
 	std::ostringstream lpfile;
 
@@ -492,61 +499,73 @@ void CScheduleAlgorithmGeneticMigSolverLPEnergyDyn::solve(CScheduleAlgorithmGene
 	CLogger::mainlog->debug("LP %s", objective.str().c_str());
 	CLogger::mainlog->debug("LP stop");
 
-	// create lp execution arguments
+	std::string model = objective.str() + lpfile.str();
 	std::string lpfil_str = lpfilename.str();
 	std::string lpsol_str = lpsolutionname.str();
 
 	// write lp to file
-	std::ofstream lprealfile;
-	lprealfile.open(lpfil_str);
-	lprealfile << objective.str();
-	lprealfile << lpfile.str();
-	lprealfile.close();
-
-
-	const char* arguments[] = {
-		solverPath,
-		lpfil_str.c_str(),
-		lpsol_str.c_str(),
-		0
-	};
-
-
-	// start lp
-	int status = 0; 
-
-	pid_t pid = fork();
-	if (pid == -1) {
-		// fork failed
-		int error = errno;
-		errno = 0;
-		CLogger::mainlog->debug("GeneticSolver: execute lp_solve failed %d %s", error, strerror(error));
-	} else
-	if (pid == 0) {
-		// child
-		execv(arguments[0], (char* const*) arguments);
-		// execv should never return
-		_exit(1);
+	if (internal == false || dump == true) {
+		std::ofstream lprealfile;
+		lprealfile.open(lpfil_str);
+		lprealfile << model;
+		lprealfile.close();
+	}
 
+	int status = 0;
+	std::stringstream solution;
+	if (internal == true) {
+		// solve in-process, lp_solve compatible status and output
+		status = CLPSolver::solveModel(model, solution, timeout);
+		if (dump == true) {
+			std::ofstream lpsolfile;
+			lpsolfile.open(lpsol_str);
+			lpsolfile << solution.str();
+			lpsolfile.close();
+		}
 	} else {
-		// parent
-		int status_info = 0;
-		pid_t ret = waitpid(pid, &status_info, 0);
-		if (-1 == ret) {
+		const char* arguments[] = {
+			solverPath,
+			lpfil_str.c_str(),
+			lpsol_str.c_str(),
+			0
+		};
+
+		pid_t pid = fork();
+		if (pid == -1) {
+			// fork failed
 			int error = errno;
 			errno = 0;
-			CLogger::mainlog->debug("GeneticSolver: execute lp_solve ok, waitpid failed %d %s", error, strerror(error));
+			CLogger::mainlog->debug("GeneticSolver: execute lp_solve failed %d %s", error, strerror(error));
+		} else
+		if (pid == 0) {
+			// child
+			execv(arguments[0], (char* const*) arguments);
+			// execv should never return
+			_exit(1);
+
 		} else {
-			status = WEXITSTATUS(status_info);
+			// parent
+			int status_info = 0;
+			pid_t ret = waitpid(pid, &status_info, 0);
+			if (-1 == ret) {
+				int error = errno;
+				errno = 0;
+				CLogger::mainlog->debug("GeneticSolver: execute lp_solve ok, waitpid failed %d %s", error, strerror(error));
+			} else {
+				status = WEXITSTATUS(status_info);
+			}
+		}
+		std::ifstream infile(lpsol_str.c_str());
+		if (infile.good() == true) {
+			solution << infile.rdbuf();
 		}
 	}
 
 	CLogger::mainlog->info("GeneticSolver: execute lp_solve = %d", status);
 
 	// read solution
-	std::ifstream infile(lpsolutionname.str().c_str());
 	std::string line;
-	while (std::getline(infile, line))
+	while (std::getline(solution, line))
 	{
 		if (line.size() == 0) {
 			continue;
@@ -6,9 +6,11 @@
 #include <algorithm>
 #include <unordered_map>
 #include "CScheduleAlgorithmHEFT.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CLogger.h"
 using namespace sched::algorithm;
@@ -40,6 +42,7 @@ CSchedule* CScheduleAlgorithmHEFT::compute(std::vector<CTaskCopy>* pTasks, std::
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CSchedule* sched = new CSchedule(tasks, machines, mrResources);
 	sched->mpOTasks = pTasks;
@@ -51,7 +54,7 @@ CSchedule* CScheduleAlgorithmHEFT::compute(std::vector<CTaskCopy>* pTasks, std::
 	}
 
 	// average execution costs
-	double* w = new double[tasks]();
+	double* w = sched->mArena.createArray<double>(tasks);
 	for (int tix = 0; tix < tasks; tix++) {
 		double tix_w = 0.0;
 		CTask* task = &(*pTasks)[tix];
@@ -61,16 +64,16 @@ CSchedule* CScheduleAlgorithmHEFT::compute(std::vector<CTaskCopy>* pTasks, std::
 			if (task->validResource(res) == false) {
 				continue;
 			}
-			tix_w += mpEstimation->taskTimeInit(task, res) +
-					 mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-					 mpEstimation->taskTimeFini(task, res);
+			tix_w += matrix->taskTimeInit(tix, mix) +
+					 matrix->taskTimeCompute(tix, mix) +
+					 matrix->taskTimeFini(tix, mix);
 			validmachines++;
 		}
 		w[tix] = tix_w / validmachines;
 	}
 
 	// upward ranks
-	double* upward = new double[tasks]();
+	double* upward = sched->mArena.createArray<double>(tasks);
 	int changed = 0;
 	do {
 		changed = 0;
@@ -149,8 +152,6 @@ CSchedule* CScheduleAlgorithmHEFT::compute(std::vector<CTaskCopy>* pTasks, std::
 	}
 	*/
 
-	// machine ready times
-	double* R = new double[machines]();
 	std::list<HEFTEntry>* entries = new std::list<HEFTEntry>[machines]();
 
 	int listTasks = tasks;
@@ -227,9 +228,9 @@ CSchedule* CScheduleAlgorithmHEFT::compute(std::vector<CTaskCopy>* pTasks, std::
 			// compute task duration for this machine
 			// (independent of slot)
 			double dur =
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(ix, mix) +
+				matrix->taskTimeCompute(ix, mix) + 
+				matrix->taskTimeFini(ix, mix);
 
 			// find first slot on this machine that
 			// * is large enough for this task
@@ -329,7 +330,7 @@ CSchedule* CScheduleAlgorithmHEFT::compute(std::vector<CTaskCopy>* pTasks, std::
 		while (it != entries[mix].end()) {
 			CTaskCopy* task = &(*pTasks)[(*it).taskix];
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -441,9 +442,6 @@ CSchedule* CScheduleAlgorithmHEFT::compute(std::vector<CTaskCopy>* pTasks, std::
 //	delete[] R;
 
 	//clean up
-	delete[] w;
-	delete[] upward;
-	delete[] R;
 	delete[] entries;
 
 
@@ -452,3 +450,5 @@ CSchedule* CScheduleAlgorithmHEFT::compute(std::vector<CTaskCopy>* pTasks, std::
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterHEFT("HEFT", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmHEFT>);
@@ -2,15 +2,17 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include <limits>
-#include <list>
 #include <algorithm>
 #include <unordered_map>
 #include "CScheduleAlgorithmHEFT2Dyn.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
+#include "CTaskRank.h"
 #include "CLogger.h"
 using namespace sched::algorithm;
 using sched::task::CTask;
@@ -42,90 +44,28 @@ CSchedule* CScheduleAlgorithmHEFT2Dyn::compute(std::vector<CTaskCopy>* pTasks, s
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 	sched->setRunningTasks(runningTasks);
 
-	// average execution costs
-	double* w = new double[tasks]();
-	for (int tix = 0; tix < tasks; tix++) {
-		double tix_w = 0.0;
-		CTask* task = &(*pTasks)[tix];
-		int validmachines = 0;
-		for (int mix = 0; mix < machines; mix++) {
-			CResource* res = mrResources[mix];
-			if (task->validResource(res) == false) {
-				continue;
-			}
-			tix_w += mpEstimation->taskTimeInit(task, res) +
-					 mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-					 mpEstimation->taskTimeFini(task, res);
-			validmachines++;
-		}
-		w[tix] = tix_w / validmachines;
-	}
-
-	// upward ranks
-	double* upward = new double[tasks]();
-	int changed = 0;
-	do {
-		changed = 0;
-		for (int tix = 0; tix < tasks; tix++) {
-			if (upward[tix] != 0) {
-				continue;
-			}
-			CTask* task = &(*pTasks)[tix];
-			// check successors
-			int unmarked = 0;
-			double max_succ_rank = 0.0;
-			for (int succIx = 0; succIx < task->mSuccessorNum; succIx++) {
-				int succId = task->mpSuccessorList[succIx];
-				// find local task index
-				int ix = -1;
-				if (sched->mTaskMap.count(succId) == 0) {
-					continue;
-				}
-				ix = sched->mTaskMap[succId];
-
-				CLogger::mainlog->debug("HEFT tix %d succ %d", tix, ix);
-				if (upward[ix] == 0.0) {
-					unmarked++;
-					break;
-				}
-				if (upward[ix] > max_succ_rank) {
-					max_succ_rank = upward[ix];
-				}
-			}
-			if (unmarked > 0) {
-				continue;
-			}
-			// compute upward rank
-			CLogger::mainlog->debug("HEFT compute upward rank for task %d w %f max_succ_rank %f succ_num %d", tix, w[tix], max_succ_rank, task->mSuccessorNum);
-			upward[tix] = w[tix] + max_succ_rank;
-			changed++;
-		}
-		
-	} while(changed > 0);
-
-	std::list<int> priorityListIx;
-	for (int tix = 0; tix < tasks; tix++) {
-		priorityListIx.push_back(tix);
-	}
-
-	// sort by decreasing upward rank
-	priorityListIx.sort( 
-		[upward](int i, int j) {
-			return upward[i] > upward[j];
-		}
-	);
+	// task priorities by decreasing upward rank
+	CTaskRank rank(sched, mrResources, pTasks, matrix);
+	std::vector<int> priorityListIx;
+	rank.order(rank.upwardRanks(), priorityListIx);
 
 
 	int listTasks = tasks;
 	// for all elements in priority list
 	while (listTasks > 0) {
 
-		int tix = priorityListIx.front();
-		priorityListIx.pop_front();
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("HEFT: stopped with %d tasks left, completing schedule by MCT", listTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, true);
+			break;
+		}
+
+		int tix = priorityListIx[tasks - listTasks];
 		CTaskCopy* task = &(*pTasks)[tix];
 		listTasks--;
 
@@ -148,9 +88,9 @@ CSchedule* CScheduleAlgorithmHEFT2Dyn::compute(std::vector<CTaskCopy>* pTasks, s
 			}
 
 			double preFinish = sched->taskReadyTimeResource(tix, res, mpEstimation);
-			double init = mpEstimation->taskTimeInit(task, res);
-			double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-			double fini = mpEstimation->taskTimeFini(task, res);
+			double init = matrix->taskTimeInit(tix, mix);
+			double compute = matrix->taskTimeCompute(tix, mix);
+			double fini = matrix->taskTimeFini(tix, mix);
 			double dur = init + compute + fini;
 
 			// find first slot on this machine that
@@ -184,7 +124,7 @@ CSchedule* CScheduleAlgorithmHEFT2Dyn::compute(std::vector<CTaskCopy>* pTasks, s
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = entry->taskcopy->mProgress;
@@ -197,11 +137,9 @@ CSchedule* CScheduleAlgorithmHEFT2Dyn::compute(std::vector<CTaskCopy>* pTasks, s
 
 	
 
-	//clean up
-	delete[] w;
-	delete[] upward;
-
 	sched->computeTimes();
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterHEFT2Dyn("HEFT2Dyn", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmHEFT2Dyn>);
@@ -0,0 +1,186 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include "CScheduleAlgorithmHEFTLookahead.h"
+#include "CScheduleAlgorithmRegistry.h"
+#include "CTask.h"
+#include "CTaskCopy.h"
+#include "CEstimation.h"
+#include "CEstimationMatrix.h"
+#include "CSchedule.h"
+#include "CScheduleExt.h"
+#include "CTaskRank.h"
+#include "CLogger.h"
+using namespace sched::algorithm;
+using sched::task::CTask;
+using sched::schedule::STaskEntry;
+using sched::schedule::CSchedule;
+using sched::schedule::CScheduleExt;
+
+
+/// @brief Tentative mapping during lookahead
+struct SLookaheadSlot {
+	int mix;
+	double start;
+	double stop;
+};
+
+/// @brief Finds the first slot that fits into the schedule and does not overlap tentative mappings
+/// A slot overlapping a tentative mapping can only be moved behind it,
+/// so the search restarts after the overlapped mappings until the slot is free.
+static double lookaheadSlot(CScheduleExt* sched, std::vector<SLookaheadSlot>& tentative, int mix, double dur, double ready, double* slotStartOut) {
+
+	double slot_start = 0.0;
+	double slot_stop = 0.0;
+	while (true) {
+		sched->findSlot(mix, dur, ready, 0, &slot_start, &slot_stop);
+		double blocked = -1.0;
+		for (unsigned int tix = 0; tix < tentative.size(); tix++) {
+			SLookaheadSlot& slot = tentative[tix];
+			if (slot.mix == mix && slot_start < slot.stop && slot.start < slot_stop && slot.stop > blocked) {
+				blocked = slot.stop;
+			}
+		}
+		if (blocked < 0.0) {
+			break;
+		}
+		ready = blocked;
+	}
+	*slotStartOut = slot_start;
+	return slot_stop;
+}
+
+CScheduleAlgorithmHEFTLookahead::CScheduleAlgorithmHEFTLookahead(std::vector<CResource*>& rResources)
+	: CScheduleAlgorithm(rResources)
+{
+	mpEstimation = CEstimation::getEstimation();
+}
+
+CScheduleAlgorithmHEFTLookahead::~CScheduleAlgorithmHEFTLookahead() {
+	delete mpEstimation;
+	mpEstimation = 0;
+}
+
+int CScheduleAlgorithmHEFTLookahead::init() {
+	return 0;
+}
+
+void CScheduleAlgorithmHEFTLookahead::fini() {
+}
+
+CSchedule* CScheduleAlgorithmHEFTLookahead::compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
+
+	int tasks = pTasks->size();
+	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
+
+	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
+
+	// task priorities by decreasing upward rank
+	CTaskRank rank(sched, mrResources, pTasks, matrix);
+	std::vector<int> priorityListIx;
+	rank.order(rank.upwardRanks(), priorityListIx);
+	std::vector<int> priority(tasks, 0);
+	for (int pix = 0; pix < tasks; pix++) {
+		priority[priorityListIx[pix]] = pix;
+	}
+
+	std::vector<int> children;
+	std::vector<SLookaheadSlot> tentative;
+
+	int listTasks = tasks;
+	// for all elements in priority list
+	while (listTasks > 0) {
+
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("HEFTLookahead: stopped with %d tasks left, completing schedule by MCT", listTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, false);
+			break;
+		}
+
+		int ix = priorityListIx[tasks - listTasks];
+		CTaskCopy* task = &(*pTasks)[ix];
+		listTasks--;
+
+		// successors in priority order
+		children.clear();
+		for (int six = 0; six < task->mSuccessorNum; six++) {
+			int stix = sched->taskIndexById(task->mpSuccessorList[six]);
+			if (stix != -1) {
+				children.push_back(stix);
+			}
+		}
+		std::sort(children.begin(), children.end(),
+			[&priority](int i, int j) {
+				return priority[i] < priority[j];
+			}
+		);
+
+		double preFinish = sched->taskReadyTime(task);
+
+		// find machine with the earliest finish time of the task's successors
+		int best_mix = -1;
+		double best_finish = 0.0;
+		int best_slot_index = 0;
+		for (int mix = 0; mix < machines; mix++) {
+			CResource* res = mrResources[mix];
+			if (task->validResource(res) == false) {
+				continue;
+			}
+
+			double slot_start = 0.0;
+			double slot_stop = 0.0;
+			int slot_index = sched->findSlot(mix, rank.duration(ix, mix), preFinish, 0, &slot_start, &slot_stop);
+
+			// map successors tentatively by earliest finish time
+			double finish = slot_stop;
+			tentative.clear();
+			tentative.push_back({mix, slot_start, slot_stop});
+			for (unsigned int cix = 0; cix < children.size(); cix++) {
+				int ctix = children[cix];
+				CTask* child = &(*pTasks)[ctix];
+				double ready = std::max(sched->taskReadyTime(ctix), slot_stop);
+				SLookaheadSlot eft = {-1, 0.0, 0.0};
+				for (int cmix = 0; cmix < machines; cmix++) {
+					if (child->validResource(mrResources[cmix]) == false) {
+						continue;
+					}
+					double child_start = 0.0;
+					double child_stop = lookaheadSlot(sched, tentative, cmix, rank.duration(ctix, cmix), ready, &child_start);
+					if (eft.mix == -1 || child_stop < eft.stop) {
+						eft = {cmix, child_start, child_stop};
+					}
+				}
+				if (eft.mix == -1) {
+					continue;
+				}
+				tentative.push_back(eft);
+				if (eft.stop > finish) {
+					finish = eft.stop;
+				}
+			}
+
+			CLogger::mainlog->debug("HEFTLookahead: tid %d mix %d stop %lf successors stop %lf", task->mId, mix, slot_stop, finish);
+			if (best_mix == -1 || finish < best_finish) {
+				best_mix = mix;
+				best_finish = finish;
+				best_slot_index = slot_index;
+			}
+		}
+
+		STaskEntry* entry = sched->newEntry();
+		entry->taskcopy = task;
+		entry->taskid = entry->taskcopy->mId;
+		entry->startProgress = entry->taskcopy->mProgress;
+		entry->stopProgress = entry->taskcopy->mCheckpoints;
+		sched->addEntry(entry, mrResources[best_mix], best_slot_index);
+		CLogger::mainlog->debug("HEFTLookahead: add tid %d to mix %d slot_index %d", task->mId, best_mix, best_slot_index);
+	}
+
+	sched->computeTimes();
+
+	return sched;
+}
+
+static CScheduleAlgorithmRegistrar sRegisterHEFTLookahead("HEFTLookahead", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmHEFTLookahead>);
@@ -0,0 +1,32 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CSCHEDULEALGORITHMHEFTLOOKAHEAD_H__
+#define __CSCHEDULEALGORITHMHEFTLOOKAHEAD_H__
+#include "CScheduleAlgorithm.h"
+
+namespace sched {
+namespace algorithm {
+
+	class CEstimation;
+
+	/// @brief HEFT with one level lookahead
+	/// Tasks are ordered by their upward rank like HEFT.
+	/// For every resource the task is tentatively mapped, then its successors are mapped by earliest finish time.
+	/// The task is mapped to the resource with the smallest maximum finish time of its successors.
+	class CScheduleAlgorithmHEFTLookahead : public CScheduleAlgorithm {
+
+		private:
+			CEstimation* mpEstimation;
+
+		public:
+			CScheduleAlgorithmHEFTLookahead(std::vector<CResource*>& rResources);
+			~CScheduleAlgorithmHEFTLookahead();
+
+			int init();
+			void fini();
+			CSchedule* compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated);
+	};
+
+} }
+#endif
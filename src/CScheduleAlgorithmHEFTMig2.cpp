@@ -2,15 +2,17 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include <limits>
-#include <list>
 #include <algorithm>
 #include <unordered_map>
 #include "CScheduleAlgorithmHEFTMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
+#include "CTaskRank.h"
 #include "CLogger.h"
 using namespace sched::algorithm;
 using sched::task::CTask;
@@ -42,89 +44,27 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 
-	// average execution costs
-	double* w = new double[tasks]();
-	for (int tix = 0; tix < tasks; tix++) {
-		double tix_w = 0.0;
-		CTask* task = &(*pTasks)[tix];
-		int validmachines = 0;
-		for (int mix = 0; mix < machines; mix++) {
-			CResource* res = mrResources[mix];
-			if (task->validResource(res) == false) {
-				continue;
-			}
-			tix_w += mpEstimation->taskTimeInit(task, res) +
-					 mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-					 mpEstimation->taskTimeFini(task, res);
-			validmachines++;
-		}
-		w[tix] = tix_w / validmachines;
-	}
-
-	// upward ranks
-	double* upward = new double[tasks]();
-	int changed = 0;
-	do {
-		changed = 0;
-		for (int tix = 0; tix < tasks; tix++) {
-			if (upward[tix] != 0) {
-				continue;
-			}
-			CTask* task = &(*pTasks)[tix];
-			// check successors
-			int unmarked = 0;
-			double max_succ_rank = 0.0;
-			for (int succIx = 0; succIx < task->mSuccessorNum; succIx++) {
-				int succId = task->mpSuccessorList[succIx];
-				// find local task index
-				int ix = -1;
-				if (sched->mTaskMap.count(succId) == 0) {
-					continue;
-				}
-				ix = sched->mTaskMap[succId];
-
-				CLogger::mainlog->debug("HEFT tix %d succ %d", tix, ix);
-				if (upward[ix] == 0.0) {
-					unmarked++;
-					break;
-				}
-				if (upward[ix] > max_succ_rank) {
-					max_succ_rank = upward[ix];
-				}
-			}
-			if (unmarked > 0) {
-				continue;
-			}
-			// compute upward rank
-			CLogger::mainlog->debug("HEFT compute upward rank for task %d w %f max_succ_rank %f succ_num %d", tix, w[tix], max_succ_rank, task->mSuccessorNum);
-			upward[tix] = w[tix] + max_succ_rank;
-			changed++;
-		}
-		
-	} while(changed > 0);
-
-	std::list<int> priorityListIx;
-	for (int tix = 0; tix < tasks; tix++) {
-		priorityListIx.push_back(tix);
-	}
-
-	// sort by decreasing upward rank
-	priorityListIx.sort( 
-		[upward](int i, int j) {
-			return upward[i] > upward[j];
-		}
-	);
+	// task priorities by decreasing upward rank
+	CTaskRank rank(sched, mrResources, pTasks, matrix);
+	std::vector<int> priorityListIx;
+	rank.order(rank.upwardRanks(), priorityListIx);
 
 
 	int listTasks = tasks;
 	// for all elements in priority list
 	while (listTasks > 0) {
 
-		int ix = priorityListIx.front();
-		priorityListIx.pop_front();
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("HEFT: stopped with %d tasks left, completing schedule by MCT", listTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, false);
+			break;
+		}
+
+		int ix = priorityListIx[tasks - listTasks];
 		CTaskCopy* task = &(*pTasks)[ix];
 		listTasks--;
 
@@ -149,9 +89,9 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 			// compute task duration for this machine
 			// (independent of slot)
 			double dur =
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(ix, mix) +
+				matrix->taskTimeCompute(ix, mix) + 
+				matrix->taskTimeFini(ix, mix);
 
 			// find first slot on this machine that
 			// * is large enough for this task
@@ -208,7 +148,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 
 			// check slots, that fit at least one checkpoint
 			int cur_slot_a = 0;
-			int max_slot_a = (*(sched->mpTasks))[mixA]->size();
+			int max_slot_a = sched->resourceTasks(mixA);
 			do {
 				CLogger::mainlog->debug("HEFT2Mig: mixA %d slot %d / %d", mixA, cur_slot_a, max_slot_a);
 				double startTimeA = 0.0;
@@ -218,8 +158,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 				//double max_slot_time = stopTimeA;
 				// is there a following task?, can the slot be extended?
 				if (new_slot_a < max_slot_a) {
-					STaskEntry* entry = (*((*(sched->mpTasks))[mixA]))[new_slot_a];
-					stopTimeA = entry->timeReady.count() / 1000000000.0;
+					stopTimeA = sched->entryReadyTime(mixA, new_slot_a);
 				} else {
 					// open end, choose full duration
 					// same start time, change stop time
@@ -259,7 +198,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 						cur_slot_b = new_slot_a;
 					}
 
-					int max_slot_b = (*(sched->mpTasks))[mixB]->size();
+					int max_slot_b = sched->resourceTasks(mixB);
 					do {
 						CLogger::mainlog->debug("HEFT2Mig: mixA %d slot %d / %d mixB %d slot %d / %d", mixA, new_slot_a, max_slot_a, mixB, cur_slot_b, max_slot_b);
 						double startTimeB = 0.0;
@@ -271,8 +210,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 							// open end
 							maxStopTimeB = startTimeB + durB;
 						} else {
-							STaskEntry* entry = (*((*(sched->mpTasks))[mixB]))[new_slot_b];
-							maxStopTimeB = entry->timeReady.count() / 1000000000.0;
+							maxStopTimeB = sched->entryReadyTime(mixB, new_slot_b);
 						}
 						// first case: use complete slot a
 						if (stopTimeA >= maxStopTimeB) {
@@ -372,7 +310,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 
 		if (migrate == false) {
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -384,7 +322,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 
 		} else {
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = first_start_progress;
@@ -394,7 +332,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 			CLogger::mainlog->debug("HEFT: add tid %d #1 real ready %lf real stop %lf",
 				task->mId, entry->timeReady.count() / 1000000000.0, entry->timeFinish.count() / 1000000000.0);
 		
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = second_start_progress;
@@ -409,11 +347,9 @@ CSchedule* CScheduleAlgorithmHEFTMig2::compute(std::vector<CTaskCopy>* pTasks, s
 
 	
 
-	//clean up
-	delete[] w;
-	delete[] upward;
-
 	sched->computeTimes();
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterHEFTMig2("HEFTMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmHEFTMig2>);
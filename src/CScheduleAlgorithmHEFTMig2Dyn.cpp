@@ -2,15 +2,17 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include <limits>
-#include <list>
 #include <algorithm>
 #include <unordered_map>
 #include "CScheduleAlgorithmHEFTMig2Dyn.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
+#include "CTaskRank.h"
 #include "CLogger.h"
 using namespace sched::algorithm;
 using sched::task::CTask;
@@ -42,102 +44,32 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 	sched->setRunningTasks(runningTasks);
 
-	// average execution costs
-	double* w = new double[tasks]();
-	for (int tix = 0; tix < tasks; tix++) {
-		double tix_w = 0.0;
-		CTask* task = &(*pTasks)[tix];
-		int validmachines = 0;
-		for (int mix = 0; mix < machines; mix++) {
-			CResource* res = mrResources[mix];
-			if (task->validResource(res) == false) {
-				continue;
-			}
-			tix_w += mpEstimation->taskTimeInit(task, res) +
-					 mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-					 mpEstimation->taskTimeFini(task, res);
-			validmachines++;
-		}
-		w[tix] = tix_w / validmachines;
-	}
-
-	// upward ranks
-	double* upward = new double[tasks]();
-	int changed = 0;
-	do {
-		changed = 0;
-		for (int tix = 0; tix < tasks; tix++) {
-			if (upward[tix] != 0) {
-				continue;
-			}
-			CTask* task = &(*pTasks)[tix];
-			// check successors
-			int unmarked = 0;
-			double max_succ_rank = 0.0;
-			for (int succIx = 0; succIx < task->mSuccessorNum; succIx++) {
-				int succId = task->mpSuccessorList[succIx];
-				// find local task index
-				int ix = -1;
-				if (sched->mTaskMap.count(succId) == 0) {
-					continue;
-				}
-				ix = sched->mTaskMap[succId];
-
-				CLogger::mainlog->debug("HEFT tix %d succ %d", tix, ix);
-				if (upward[ix] == 0.0) {
-					unmarked++;
-					break;
-				}
-				if (upward[ix] > max_succ_rank) {
-					max_succ_rank = upward[ix];
-				}
-			}
-			if (unmarked > 0) {
-				continue;
-			}
-			// compute upward rank
-			CLogger::mainlog->debug("HEFT compute upward rank for task %d w %f max_succ_rank %f succ_num %d", tix, w[tix], max_succ_rank, task->mSuccessorNum);
-			upward[tix] = w[tix] + max_succ_rank;
-			changed++;
-		}
-		
-	} while(changed > 0);
-
-	for (int tix=0; tix<tasks; tix++) {
-		CTask* task = &(*pTasks)[tix];
-		CLogger::mainlog->debug("HEFT: upward rank tix %d tid %d upward %lf",tix, task->mId, upward[tix]);
-	}
-
-	std::list<int> priorityListIx;
-	for (int tix = 0; tix < tasks; tix++) {
-		priorityListIx.push_back(tix);
-	}
-
-	// sort by decreasing upward rank
-	priorityListIx.sort( 
-		[upward](int i, int j) {
-			return upward[i] > upward[j];
-		}
-	);
-
-	std::list<int>::iterator pit = priorityListIx.begin();
-	while(pit != priorityListIx.end()) {
-		int pix = (*pit);
-		CTaskCopy* task = &(*pTasks)[pix];
+	// task priorities by decreasing upward rank
+	CTaskRank rank(sched, mrResources, pTasks, matrix);
+	std::vector<int> priorityListIx;
+	const std::vector<double>& upward = rank.upwardRanks();
+	rank.order(upward, priorityListIx);
+	for (int pix : priorityListIx) {
+		CTask* task = &(*pTasks)[pix];
 		CLogger::mainlog->debug("HEFT: sorted upward rank tix %d tid %d upward %lf",pix, task->mId, upward[pix]);
-		pit++;
 	}
 
 	int listTasks = tasks;
 	// for all elements in priority list
 	while (listTasks > 0) {
 
-		int tix = priorityListIx.front();
-		priorityListIx.pop_front();
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("HEFT: stopped with %d tasks left, completing schedule by MCT", listTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, true);
+			break;
+		}
+
+		int tix = priorityListIx[tasks - listTasks];
 		CTaskCopy* task = &(*pTasks)[tix];
 		listTasks--;
 
@@ -174,9 +106,9 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 
 			// compute task duration for this machine
 			// (independent of slot)
-			double init = mpEstimation->taskTimeInit(task, res);
-			double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-			double fini = mpEstimation->taskTimeFini(task, res);
+			double init = matrix->taskTimeInit(tix, mix);
+			double compute = matrix->taskTimeCompute(tix, mix);
+			double fini = matrix->taskTimeFini(tix, mix);
 			double dur = init + compute + fini;
 
 			// find first slot on this machine that
@@ -250,7 +182,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 
 			// check slots, that fit at least one checkpoint
 			int cur_slot_a = 0;
-			int max_slot_a = (*(sched->mpTasks))[mixA]->size();
+			int max_slot_a = sched->resourceTasks(mixA);
 			do {
 				CLogger::mainlog->debug("HEFT2Mig: mixA %d slot %d / %d", mixA, cur_slot_a, max_slot_a);
 				double startTimeA = 0.0;
@@ -276,8 +208,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 				//double max_slot_time = stopTimeA;
 				// is there a following task?, can the slot be extended?
 				if (new_slot_a < max_slot_a) {
-					STaskEntry* entry = (*((*(sched->mpTasks))[mixA]))[new_slot_a];
-					stopTimeA = entry->timeReady.count() / 1000000000.0;
+					stopTimeA = sched->entryReadyTime(mixA, new_slot_a);
 				} else {
 					// open end, choose full duration
 					// same start time, change stop time
@@ -317,7 +248,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 						cur_slot_b = new_slot_a;
 					}
 
-					int max_slot_b = (*(sched->mpTasks))[mixB]->size();
+					int max_slot_b = sched->resourceTasks(mixB);
 					do {
 						CLogger::mainlog->debug("HEFT2Mig: mixA %d slot %d / %d mixB %d slot %d / %d", mixA, new_slot_a, max_slot_a, mixB, cur_slot_b, max_slot_b);
 						double startTimeB = 0.0;
@@ -329,8 +260,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 							// open end
 							maxStopTimeB = startTimeB + durB;
 						} else {
-							STaskEntry* entry = (*((*(sched->mpTasks))[mixB]))[new_slot_b];
-							maxStopTimeB = entry->timeReady.count() / 1000000000.0;
+							maxStopTimeB = sched->entryReadyTime(mixB, new_slot_b);
 						}
 						// first case: use complete slot a
 						if (stopTimeA >= maxStopTimeB) {
@@ -434,7 +364,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 
 		if (migrate == false) {
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -446,7 +376,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 
 		} else {
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = first_start_progress;
@@ -456,7 +386,7 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 			CLogger::mainlog->debug("HEFT: add tid %d #1 real ready %lf real stop %lf",
 				task->mId, entry->timeReady.count() / 1000000000.0, entry->timeFinish.count() / 1000000000.0);
 		
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = second_start_progress;
@@ -471,11 +401,9 @@ CSchedule* CScheduleAlgorithmHEFTMig2Dyn::compute(std::vector<CTaskCopy>* pTasks
 
 	
 
-	//clean up
-	delete[] w;
-	delete[] upward;
-
 	sched->computeTimes();
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterHEFTMig2Dyn("HEFTMig2Dyn", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmHEFTMig2Dyn>);
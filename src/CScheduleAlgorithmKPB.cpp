@@ -6,6 +6,7 @@
 #include <algorithm>
 #include "CConfig.h"
 #include "CScheduleAlgorithmKPB.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -64,7 +65,7 @@ CSchedule* CScheduleAlgorithmKPB::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 	std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
 
-	double* pResourceReady = new double[machines]();
+	double* pResourceReady = sched->mArena.createArray<double>(machines);
 	// copy previous schedule
 	if (mpPreviousSchedule != 0) {
 		for (int mix=0; mix<machines; mix++) {
@@ -82,7 +83,7 @@ CSchedule* CScheduleAlgorithmKPB::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 				CTaskCopy* task = &((*pTasks)[taskix]);
 
-				STaskEntry* newentry = new STaskEntry();
+				STaskEntry* newentry = sched->newEntry();
 				newentry->taskcopy = task;
 				newentry->taskid = newentry->taskcopy->mId;
 				newentry->stopProgress = newentry->taskcopy->mCheckpoints;
@@ -133,11 +134,11 @@ CSchedule* CScheduleAlgorithmKPB::compute(std::vector<CTaskCopy>* pTasks, std::v
 	std::vector<STaskEntry*> newEntries;
 
 	// completion times
-	double* pResourceCT = new double[machines]();
+	double* pResourceCT = sched->mArena.createArray<double>(machines);
 	// execution times
-	double* pResourceET = new double[machines]();
+	double* pResourceET = sched->mArena.createArray<double>(machines);
 	// machine index
-	int* pResourceIX = new int[machines]();
+	int* pResourceIX = sched->mArena.createArray<int>(machines);
 
 
 	// map tasks
@@ -230,7 +231,7 @@ CSchedule* CScheduleAlgorithmKPB::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 		pResourceReady[selectedMix] = selectedCT;
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -243,12 +244,10 @@ CSchedule* CScheduleAlgorithmKPB::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 	sched->mActiveTasks = tasks;
 	mpPreviousSchedule = sched;
-	delete[] pResourceReady;
-	delete[] pResourceCT;
-	delete[] pResourceET;
-	delete[] pResourceIX;
 
 	sched->computeTimes();
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterKPB("KPB", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmKPB>);
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include "CConfig.h"
 #include "CScheduleAlgorithmKPB2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -76,11 +77,11 @@ CSchedule* CScheduleAlgorithmKPB2::compute(std::vector<CTaskCopy>* pTasks, std::
 	std::vector<STaskEntry*> newEntries;
 
 	// completion times
-	double* pResourceCT = new double[machines]();
+	double* pResourceCT = sched->mArena.createArray<double>(machines);
 	// execution times
-	double* pResourceET = new double[machines]();
+	double* pResourceET = sched->mArena.createArray<double>(machines);
 	// machine index
-	int* pResourceIX = new int[machines]();
+	int* pResourceIX = sched->mArena.createArray<int>(machines);
 
 
 	// map tasks
@@ -146,7 +147,7 @@ CSchedule* CScheduleAlgorithmKPB2::compute(std::vector<CTaskCopy>* pTasks, std::
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = entry->taskcopy->mProgress;
@@ -159,11 +160,10 @@ CSchedule* CScheduleAlgorithmKPB2::compute(std::vector<CTaskCopy>* pTasks, std::
 	}
 
 	mpPreviousSchedule = sched;
-	delete[] pResourceCT;
-	delete[] pResourceET;
-	delete[] pResourceIX;
 
 	sched->computeTimes();
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterKPB2("KPB2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmKPB2>);
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include "CConfig.h"
 #include "CScheduleAlgorithmKPBMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -235,7 +236,7 @@ CSchedule* CScheduleAlgorithmKPBMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 		// add to schedule
 		struct MigOpt* min_mig = &(options[index]);
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = min_mig->parts[0].startProgress;
@@ -248,7 +249,7 @@ CSchedule* CScheduleAlgorithmKPBMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 		if (min_mig->parts[1].mix != -1) {
 			// migration option
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig->parts[1].startProgress;
@@ -271,3 +272,5 @@ CSchedule* CScheduleAlgorithmKPBMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterKPBMig2("KPBMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmKPBMig2>);
@@ -3,6 +3,7 @@
 
 #include <cstring>
 #include "CScheduleAlgorithmLinear.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CLogger.h"
 #include "CResource.h"
 #include "CTask.h"
@@ -45,7 +46,7 @@ CSchedule* CScheduleAlgorithmLinear::compute(std::vector<CTaskCopy>* pTasks, std
 		int id = count++;
 		int res = id % resNum;
 		resId[res]++;
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = &((*pTasks)[i]);
 		entry->taskid = (*pTasks)[i].mId;
 		entry->stopProgress = (*pTasks)[i].mCheckpoints;
@@ -64,3 +65,5 @@ void CScheduleAlgorithmLinear::fini(){
 
 CScheduleAlgorithmLinear::~CScheduleAlgorithmLinear(){
 }
+
+static CScheduleAlgorithmRegistrar sRegisterLinear("Linear", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmLinear>);
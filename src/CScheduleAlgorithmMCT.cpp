@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMCT.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -52,7 +53,7 @@ CSchedule* CScheduleAlgorithmMCT::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 	std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
 
-	double* pResourceReady = new double[machines]();
+	double* pResourceReady = sched->mArena.createArray<double>(machines);
 	// copy previous schedule
 	if (mpPreviousSchedule != 0) {
 		for (int mix=0; mix<machines; mix++) {
@@ -70,7 +71,7 @@ CSchedule* CScheduleAlgorithmMCT::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 				CTaskCopy* task = &((*pTasks)[taskix]);
 
-				STaskEntry* newentry = new STaskEntry();
+				STaskEntry* newentry = sched->newEntry();
 				newentry->taskcopy = task;
 				newentry->taskid = newentry->taskcopy->mId;
 				newentry->stopProgress = newentry->taskcopy->mCheckpoints;
@@ -180,7 +181,7 @@ CSchedule* CScheduleAlgorithmMCT::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 		pResourceReady[selectedMix] = selectedComplete;
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -193,9 +194,10 @@ CSchedule* CScheduleAlgorithmMCT::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 	sched->mActiveTasks = tasks;
 	mpPreviousSchedule = sched;
-	delete[] pResourceReady;
 
 	sched->computeTimes();
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMCT("MCT", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMCT>);
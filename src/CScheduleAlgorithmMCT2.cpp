@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMCT2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -96,7 +97,7 @@ CSchedule* CScheduleAlgorithmMCT2::compute(std::vector<CTaskCopy>* pTasks, std::
 			CLogger::mainlog->debug("MCT: opt taskid %d mix %d ready %lf complete %lf", task->mId, mix, ready, complete);
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -114,3 +115,5 @@ CSchedule* CScheduleAlgorithmMCT2::compute(std::vector<CTaskCopy>* pTasks, std::
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMCT2("MCT2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMCT2>);
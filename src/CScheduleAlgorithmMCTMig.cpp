@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMCTMig.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -52,7 +53,7 @@ CSchedule* CScheduleAlgorithmMCTMig::compute(std::vector<CTaskCopy>* pTasks, std
 
 	std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
 
-	double* pResourceReady = new double[machines]();
+	double* pResourceReady = sched->mArena.createArray<double>(machines);
 	// copy previous schedule
 	if (mpPreviousSchedule != 0) {
 		for (int mix=0; mix<machines; mix++) {
@@ -70,7 +71,7 @@ CSchedule* CScheduleAlgorithmMCTMig::compute(std::vector<CTaskCopy>* pTasks, std
 
 				CTaskCopy* task = &((*pTasks)[taskix]);
 
-				STaskEntry* newentry = new STaskEntry();
+				STaskEntry* newentry = sched->newEntry();
 				newentry->taskcopy = task;
 				newentry->taskid = newentry->taskcopy->mId;
 				newentry->stopProgress = newentry->taskcopy->mCheckpoints;
@@ -292,7 +293,7 @@ CSchedule* CScheduleAlgorithmMCTMig::compute(std::vector<CTaskCopy>* pTasks, std
 			// only add normal option
 			pResourceReady[options[0].mix] = options[0].complete;
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -311,7 +312,7 @@ CSchedule* CScheduleAlgorithmMCTMig::compute(std::vector<CTaskCopy>* pTasks, std
 			pResourceReady[min_mig.parts[0].mix] = min_mig.parts[0].complete;
 			pResourceReady[min_mig.parts[1].mix] = min_mig.parts[1].complete;
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[0].startProgress;
@@ -323,7 +324,7 @@ CSchedule* CScheduleAlgorithmMCTMig::compute(std::vector<CTaskCopy>* pTasks, std
 			min_mig.parts[0].startProgress,
 			min_mig.parts[0].stopProgress);
 
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[1].startProgress;
@@ -345,10 +346,11 @@ CSchedule* CScheduleAlgorithmMCTMig::compute(std::vector<CTaskCopy>* pTasks, std
 
 	sched->mActiveTasks = tasks;
 	mpPreviousSchedule = sched;
-	delete[] pResourceReady;
 	delete[] options;
 
 	sched->computeTimes();
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMCTMig("MCTMig", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMCTMig>);
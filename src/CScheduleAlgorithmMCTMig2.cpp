@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMCTMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -209,7 +210,7 @@ CSchedule* CScheduleAlgorithmMCTMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 			// only add normal option
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -226,7 +227,7 @@ CSchedule* CScheduleAlgorithmMCTMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 			// add migration option
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[0].startProgress;
@@ -237,7 +238,7 @@ CSchedule* CScheduleAlgorithmMCTMig2::compute(std::vector<CTaskCopy>* pTasks, st
 			min_mig.parts[0].startProgress,
 			min_mig.parts[0].stopProgress);
 
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[1].startProgress;
@@ -263,3 +264,5 @@ CSchedule* CScheduleAlgorithmMCTMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMCTMig2("MCTMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMCTMig2>);
@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMET.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -65,7 +66,7 @@ CSchedule* CScheduleAlgorithmMET::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 				CTaskCopy* task = &((*pTasks)[taskix]);
 
-				STaskEntry* newentry = new STaskEntry();
+				STaskEntry* newentry = sched->newEntry();
 				newentry->taskcopy = task;
 				newentry->taskid = newentry->taskcopy->mId;
 				newentry->stopProgress = newentry->taskcopy->mCheckpoints;
@@ -114,7 +115,7 @@ CSchedule* CScheduleAlgorithmMET::compute(std::vector<CTaskCopy>* pTasks, std::v
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -130,3 +131,5 @@ CSchedule* CScheduleAlgorithmMET::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMET("MET", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMET>);
@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMET2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -90,7 +91,7 @@ CSchedule* CScheduleAlgorithmMET2::compute(std::vector<CTaskCopy>* pTasks, std::
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = entry->taskcopy->mProgress;
@@ -107,3 +108,5 @@ CSchedule* CScheduleAlgorithmMET2::compute(std::vector<CTaskCopy>* pTasks, std::
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMET2("MET2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMET2>);
@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMETMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -180,7 +181,7 @@ CSchedule* CScheduleAlgorithmMETMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 		if (migrate == false) {
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -195,7 +196,7 @@ CSchedule* CScheduleAlgorithmMETMig2::compute(std::vector<CTaskCopy>* pTasks, st
 		} else {
 
 			// add migration option
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[0].startProgress;
@@ -206,7 +207,7 @@ CSchedule* CScheduleAlgorithmMETMig2::compute(std::vector<CTaskCopy>* pTasks, st
 			min_mig.parts[0].startProgress,
 			min_mig.parts[0].stopProgress);
 
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[1].startProgress;
@@ -228,3 +229,5 @@ CSchedule* CScheduleAlgorithmMETMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMETMig2("METMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMETMig2>);
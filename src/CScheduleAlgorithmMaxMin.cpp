@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMaxMin.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CLogger.h"
 using namespace sched::algorithm;
@@ -39,19 +41,20 @@ CSchedule* CScheduleAlgorithmMaxMin::compute(std::vector<CTaskCopy>* pTasks, std
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CSchedule* sched = new CSchedule(tasks, machines, mrResources);
 	sched->mpOTasks = pTasks;
 
 
 	// completion time matrix
-	double* C = new double[tasks * machines]();
+	double* C = sched->mArena.createArray<double>(tasks * machines);
 	// list of unmapped tasks
 	// 0 -> unmapped
 	// 1 -> mapped
-	int* active = new int[tasks]();
+	int* active = sched->mArena.createArray<int>(tasks);
 	// machine ready times
-	double* R = new double[machines]();
+	double* R = sched->mArena.createArray<double>(machines);
 
 	int dep[tasks];
 	double depReady[tasks];
@@ -96,9 +99,9 @@ CSchedule* CScheduleAlgorithmMaxMin::compute(std::vector<CTaskCopy>* pTasks, std
 			// fini time
 			double complete = 
 				R[mix] +
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(tix, mix) +
+				matrix->taskTimeCompute(tix, mix) + 
+				matrix->taskTimeFini(tix, mix);
 			C[tix*machines + mix] = complete;
 		}
 	}
@@ -156,7 +159,7 @@ CSchedule* CScheduleAlgorithmMaxMin::compute(std::vector<CTaskCopy>* pTasks, std
 
 		CLogger::mainlog->debug("MaxMin: tix %d tid %d mix %d", max_tix, max_task->mId, max_tix_mix);
 		// add task to machine queue
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = &((*pTasks)[max_tix]);
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -217,9 +220,9 @@ CSchedule* CScheduleAlgorithmMaxMin::compute(std::vector<CTaskCopy>* pTasks, std
 						// fini time
 						double complete = 
 							ready +
-							mpEstimation->taskTimeInit(task, res) +
-							mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-							mpEstimation->taskTimeFini(task, res);
+							matrix->taskTimeInit(tix, mix) +
+							matrix->taskTimeCompute(tix, mix) + 
+							matrix->taskTimeFini(tix, mix);
 						C[tix*machines + mix] = complete;
 					}
 
@@ -252,10 +255,7 @@ CSchedule* CScheduleAlgorithmMaxMin::compute(std::vector<CTaskCopy>* pTasks, std
 	sched->mActiveTasks = tasks;
 	sched->computeTimes();
 
-	// clean up
-	delete[] C;
-	delete[] active;
-	delete[] R;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMaxMin("MaxMin", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMaxMin>);
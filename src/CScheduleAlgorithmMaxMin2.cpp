@@ -2,12 +2,13 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include <limits>
-#include <list>
-#include <algorithm>
 #include "CScheduleAlgorithmMaxMin2.h"
+#include "CScheduleAlgorithmRegistry.h"
+#include "CCompletionQueue.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CLogger.h"
@@ -41,187 +42,50 @@ CSchedule* CScheduleAlgorithmMaxMin2::compute(std::vector<CTaskCopy>* pTasks, st
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 
-
-	// completion time matrix
-	double* C = new double[tasks * machines]();
-
-	
-	// fill matrix
-	for (int tix = 0; tix<tasks; tix++) {
-		if (sched->taskDependencySatisfied(tix) == false) {
-			continue;
-		}
-		CTask* task = (CTask*)  &((*pTasks)[tix]);
-		for (int mix = 0; mix<machines; mix++) {
-			CResource* res = mrResources[mix];
-
-			if (task->validResource(res) == false) {
-				continue;
-			}
-
-			// completion time =
-			// ready time +
-			// init time +
-			// compute time +
-			// fini time
-			double resourceReady = sched->resourceReadyTime(mix);
-			double complete = 
-				resourceReady +
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-				mpEstimation->taskTimeFini(task, res);
-			C[tix*machines + mix] = complete;
-		}
-	}
+	// ready tasks ordered by their best completion time
+	CCompletionQueue<MAX_COMPLETION, false> queue(sched, mrResources, pTasks, matrix, mpEstimation);
 
 	int unmappedTasks = tasks;
 
 	while (unmappedTasks > 0) {
 
-		// task with earliest completion time
-		int max_tix = -1;
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("MaxMin: stopped with %d tasks left, completing schedule by MCT", unmappedTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, false);
+			break;
+		}
+
+		// task with latest completion time
 		int max_tix_mix = -1;
-		double max_tix_comp = 0.0;
-		CTaskCopy* max_task = 0;
-
-		for (int tix = 0; tix<tasks; tix++) {
-			// skip already mapped tasks
-			if (sched->taskLastPartMapped(tix) == true) {
-				continue;
-			}
-			// skip tasks whose predecessors are not ready
-			if (sched->taskDependencySatisfied(tix) == false) {
-				continue;
-			}
-			CTaskCopy* task = &((*pTasks)[tix]);
-			// machine with earliest completion time
-			int min_mix = 0;
-			double min_comp = 0.0;
-			int first = 0;
-
-			for (int mix = 0; mix<machines; mix++) {
-
-				CResource* res = mrResources[mix];
-
-				if (task->validResource(res) == false) {
-					continue;
-				}
-
-				double new_comp = C[tix*machines + mix];
-
-				CLogger::mainlog->debug("MaxMin: tix %d mix %d completion time %lf", tix, mix, new_comp);
-
-				if (first == 0 || new_comp < min_comp) {
-					min_comp = new_comp;
-					min_mix = mix;
-					first = 1;
-				}
-			}
-			if (min_comp > max_tix_comp) {
-				max_tix = tix;
-				max_tix_mix = min_mix;
-				max_tix_comp = min_comp;
-				max_task = task;
-			}
+		int max_tix = queue.top(&max_tix_mix);
+		if (max_tix == -1) {
+			CLogger::mainlog->error("MaxMin: no ready task left, %d tasks unmapped", unmappedTasks);
+			break;
 		}
+		CTaskCopy* max_task = &((*pTasks)[max_tix]);
 
-		CLogger::mainlog->debug("MaxMin: tix %d tid %d mix %d", max_tix, max_task->mId, max_tix_mix);
+		CLogger::mainlog->debug("MaxMin: tix %d tid %d mix %d completion time %lf", max_tix, max_task->mId, max_tix_mix, queue.bestCompletionTime(max_tix));
 		// add task to machine queue
-		STaskEntry* entry = new STaskEntry();
-		entry->taskcopy = &((*pTasks)[max_tix]);
+		STaskEntry* entry = sched->newEntry();
+		entry->taskcopy = max_task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = entry->taskcopy->mProgress;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
 		sched->addEntry(entry, mrResources[max_tix_mix], -1);
 
-		// update ready time
-		double new_ready = max_tix_comp;
-
 		unmappedTasks--;
-		if (unmappedTasks == 0) {
-			break;
-		}
 
-		CResource* max_res = mrResources[max_tix_mix];
-
-		// update completion time matrix
-		for (int tix = 0; tix<tasks; tix++) {
-			if (sched->taskLastPartMapped(tix) == true) {
-				continue;
-			}
-			CTaskCopy* task = &((*pTasks)[tix]);
-			CLogger::mainlog->debug("MaxMin: Check task %d", tix);
-			bool succ = false;
-			for (int six=0; six<max_task->mSuccessorNum; six++) {
-				if (max_task->mpSuccessorList[six] == task->mId) {
-					// successor task found
-					succ = true;
-					break;
-				}
-			}
-			if (succ == true) {
-				if (sched->taskDependencySatisfied(tix) == true) {
-					// task was just freed from dependencies
-					// update ready times
-					CLogger::mainlog->debug("MaxMin: freed task %d", tix);
-
-					for (int mix = 0; mix<machines; mix++) {
-						CResource* res = mrResources[mix];
-
-						if (task->validResource(res) == false) {
-							continue;
-						}
-
-						double depReady = sched->taskReadyTime(tix);
-						double resourceReady = sched->resourceReadyTime(mix);
-						double ready = (depReady > resourceReady ? depReady : resourceReady);
-
-						// completion time =
-						// ready time +
-						// init time +
-						// compute time +
-						// fini time
-						double complete = 
-							ready +
-							mpEstimation->taskTimeInit(task, res) +
-							mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-							mpEstimation->taskTimeFini(task, res);
-						C[tix*machines + mix] = complete;
-					}
-
-
-				}
-			} else {
-
-				if (sched->taskDependencySatisfied(tix) == false) {
-					continue;
-				}
-
-				if (task->validResource(max_res) == false) {
-					continue;
-				}
-
-				double resourceReady = new_ready;
-				double depReady = sched->taskReadyTime(tix);
-				double ready = (depReady > resourceReady ? depReady : resourceReady);
-				double complete = 
-					ready +
-					mpEstimation->taskTimeInit(task, max_res) +
-					mpEstimation->taskTimeCompute(task, max_res, task->mProgress, task->mCheckpoints) + 
-					mpEstimation->taskTimeFini(task, max_res);
-				C[tix*machines + max_tix_mix] = complete;
-
-			}
-		}
+		// update completion times of tasks affected by the resource and freed successors
+		queue.update(max_tix, max_tix_mix);
 	}
 
 	sched->computeTimes();
 
-	// clean up
-	delete[] C;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMaxMin2("MaxMin2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMaxMin2>);
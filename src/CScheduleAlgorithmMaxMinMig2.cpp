@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMaxMinMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CLogger.h"
@@ -41,12 +43,13 @@ CSchedule* CScheduleAlgorithmMaxMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 
 
 	// completion time matrix
-	double* C = new double[tasks * machines]();
+	double* C = sched->mArena.createArray<double>(tasks * machines);
 	
 	// fill matrix
 	for (int tix = 0; tix<tasks; tix++) {
@@ -69,9 +72,9 @@ CSchedule* CScheduleAlgorithmMaxMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 			double resourceReady = sched->resourceReadyTime(mix);
 			double complete = 
 				resourceReady +
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(tix, mix) +
+				matrix->taskTimeCompute(tix, mix) + 
+				matrix->taskTimeFini(tix, mix);
 			C[tix*machines + mix] = complete;
 		}
 	}
@@ -84,6 +87,12 @@ CSchedule* CScheduleAlgorithmMaxMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 
 	while (unmappedTasks > 0) {
 
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("MaxMin: stopped with %d tasks left, completing schedule by MCT", unmappedTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, false);
+			break;
+		}
+
 		max_mig.parts[0].mix = -1;
 
 		for (int tix = 0; tix < tasks; tix++) {
@@ -246,7 +255,7 @@ CSchedule* CScheduleAlgorithmMaxMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 		if (migrate == false) {
 
 			// add task to machine queue
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = &((*pTasks)[max_tix]);
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -259,7 +268,7 @@ CSchedule* CScheduleAlgorithmMaxMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 
 			CTaskCopy* task = &((*pTasks)[max_mig.tix]);
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = max_mig.parts[0].startProgress;
@@ -270,7 +279,7 @@ CSchedule* CScheduleAlgorithmMaxMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 			max_mig.parts[0].startProgress,
 			max_mig.parts[0].stopProgress);
 
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = max_mig.parts[1].startProgress;
@@ -336,9 +345,9 @@ CSchedule* CScheduleAlgorithmMaxMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 						// fini time
 						double complete = 
 							ready +
-							mpEstimation->taskTimeInit(task, res) +
-							mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-							mpEstimation->taskTimeFini(task, res);
+							matrix->taskTimeInit(tix, mix) +
+							matrix->taskTimeCompute(tix, mix) + 
+							matrix->taskTimeFini(tix, mix);
 						C[tix*machines + mix] = complete;
 					}
 
@@ -405,8 +414,7 @@ CSchedule* CScheduleAlgorithmMaxMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 
 	sched->computeTimes();
 
-	// clean up
-	delete[] C;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMaxMinMig2("MaxMinMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMaxMinMig2>);
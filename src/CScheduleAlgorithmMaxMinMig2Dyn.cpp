@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMaxMinMig2Dyn.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CResource.h"
@@ -42,13 +44,14 @@ CSchedule* CScheduleAlgorithmMaxMinMig2Dyn::compute(std::vector<CTaskCopy>* pTas
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 	sched->setRunningTasks(runningTasks);
 
 
 	// completion time matrix
-	double* C = new double[tasks * machines]();
+	double* C = sched->mArena.createArray<double>(tasks * machines);
 
 	// fill matrix
 	for (int tix = 0; tix<tasks; tix++) {
@@ -67,14 +70,14 @@ CSchedule* CScheduleAlgorithmMaxMinMig2Dyn::compute(std::vector<CTaskCopy>* pTas
 
 			// ready time for this task on this resource considering running tasks
 			double ready = sched->taskReadyTimeResource(tix, res, mpEstimation);
-			double init = mpEstimation->taskTimeInit(task, res);
+			double init = matrix->taskTimeInit(tix, mix);
 			if (sched->taskRunningResource(tix) == mix) {
 				// is task already running on resource
 				// ignore init time for first slot on resource
 				init = 0.0;
 			}
-			double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-			double fini = mpEstimation->taskTimeFini(task, res);
+			double compute = matrix->taskTimeCompute(tix, mix);
+			double fini = matrix->taskTimeFini(tix, mix);
 			double complete = sched->taskCompletionTime(tix, res, 0, ready, init, compute, fini);
 			C[tix*machines + mix] = complete;
 		}
@@ -88,6 +91,12 @@ CSchedule* CScheduleAlgorithmMaxMinMig2Dyn::compute(std::vector<CTaskCopy>* pTas
 
 	while (unmappedTasks > 0) {
 
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("MaxMin: stopped with %d tasks left, completing schedule by MCT", unmappedTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, true);
+			break;
+		}
+
 		max_mig.parts[0].mix = -1;
 
 		for (int tix = 0; tix < tasks; tix++) {
@@ -265,7 +274,7 @@ CSchedule* CScheduleAlgorithmMaxMinMig2Dyn::compute(std::vector<CTaskCopy>* pTas
 		if (migrate == false) {
 
 			// add task to machine queue
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = &((*pTasks)[max_tix]);
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -278,7 +287,7 @@ CSchedule* CScheduleAlgorithmMaxMinMig2Dyn::compute(std::vector<CTaskCopy>* pTas
 
 			CTaskCopy* task = &((*pTasks)[max_mig.tix]);
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = max_mig.parts[0].startProgress;
@@ -289,7 +298,7 @@ CSchedule* CScheduleAlgorithmMaxMinMig2Dyn::compute(std::vector<CTaskCopy>* pTas
 			max_mig.parts[0].startProgress,
 			max_mig.parts[0].stopProgress);
 
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = max_mig.parts[1].startProgress;
@@ -340,7 +349,7 @@ CSchedule* CScheduleAlgorithmMaxMinMig2Dyn::compute(std::vector<CTaskCopy>* pTas
 
 						// ready time for this task on this resource considering running tasks
 						double ready = sched->taskReadyTimeResource(tix, res, mpEstimation);
-						double init = mpEstimation->taskTimeInit(task, res);
+						double init = matrix->taskTimeInit(tix, mix);
 						if (sched->taskRunningResource(tix) == mix &&
 							sched->resourceTasks(mix) == 0) {
 							// task already running on resource and
@@ -348,8 +357,8 @@ CSchedule* CScheduleAlgorithmMaxMinMig2Dyn::compute(std::vector<CTaskCopy>* pTas
 							init = 0.0;
 						}
 
-						double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-						double fini = mpEstimation->taskTimeFini(task, res);
+						double compute = matrix->taskTimeCompute(tix, mix);
+						double fini = matrix->taskTimeFini(tix, mix);
 						int nextSlot = sched->resourceTasks(mix);
 						double complete = sched->taskCompletionTime(tix, res, nextSlot, ready, init, compute, fini);
 						C[tix*machines + mix] = complete;
@@ -440,8 +449,7 @@ CSchedule* CScheduleAlgorithmMaxMinMig2Dyn::compute(std::vector<CTaskCopy>* pTas
 
 	sched->computeTimes();
 
-	// clean up
-	delete[] C;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMaxMinMig2Dyn("MaxMinMig2Dyn", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMaxMinMig2Dyn>);
@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMinMin.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CLogger.h"
 using namespace sched::algorithm;
@@ -39,19 +41,20 @@ CSchedule* CScheduleAlgorithmMinMin::compute(std::vector<CTaskCopy>* pTasks, std
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CSchedule* sched = new CSchedule(tasks, machines, mrResources);
 	sched->mpOTasks = pTasks;
 
 
 	// completion time matrix
-	double* C = new double[tasks * machines]();
+	double* C = sched->mArena.createArray<double>(tasks * machines);
 	// list of unmapped tasks
 	// 0 -> unmapped
 	// 1 -> mapped
-	int* active = new int[tasks]();
+	int* active = sched->mArena.createArray<int>(tasks);
 	// machine ready times
-	double* R = new double[machines]();
+	double* R = sched->mArena.createArray<double>(machines);
 
 	int dep[tasks];
 	double depReady[tasks];
@@ -99,9 +102,9 @@ CSchedule* CScheduleAlgorithmMinMin::compute(std::vector<CTaskCopy>* pTasks, std
 			// fini time
 			double complete = 
 				R[mix] +
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(tix, mix) +
+				matrix->taskTimeCompute(tix, mix) + 
+				matrix->taskTimeFini(tix, mix);
 			C[tix*machines + mix] = complete;
 		}
 	}
@@ -159,7 +162,7 @@ CSchedule* CScheduleAlgorithmMinMin::compute(std::vector<CTaskCopy>* pTasks, std
 
 		CLogger::mainlog->debug("MinMin: select tix %d tid %d mix %d", min_tix, min_task->mId, min_tix_mix);
 		// add task to machine queue
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = &((*pTasks)[min_tix]);
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -223,9 +226,9 @@ CSchedule* CScheduleAlgorithmMinMin::compute(std::vector<CTaskCopy>* pTasks, std
 						// fini time
 						double complete = 
 							ready +
-							mpEstimation->taskTimeInit(task, res) +
-							mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-							mpEstimation->taskTimeFini(task, res);
+							matrix->taskTimeInit(tix, mix) +
+							matrix->taskTimeCompute(tix, mix) + 
+							matrix->taskTimeFini(tix, mix);
 						C[tix*machines + mix] = complete;
 					}
 
@@ -258,10 +261,7 @@ CSchedule* CScheduleAlgorithmMinMin::compute(std::vector<CTaskCopy>* pTasks, std
 	sched->mActiveTasks = tasks;
 	sched->computeTimes();
 
-	// clean up
-	delete[] C;
-	delete[] active;
-	delete[] R;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMinMin("MinMin", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMinMin>);
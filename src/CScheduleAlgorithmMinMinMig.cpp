@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMinMinMig.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -45,13 +46,13 @@ CSchedule* CScheduleAlgorithmMinMinMig::compute(std::vector<CTaskCopy>* pTasks,
 
 
 	// completion time matrix
-	double* C = new double[tasks * machines]();
+	double* C = sched->mArena.createArray<double>(tasks * machines);
 	// list of unmapped tasks
 	// 0 -> unmapped
 	// 1 -> mapped
-	int* active = new int[tasks]();
+	int* active = sched->mArena.createArray<int>(tasks);
 	// machine ready times
-	double* R = new double[machines]();
+	double* R = sched->mArena.createArray<double>(machines);
 
 	int dep[tasks];
 	double depReady[tasks];
@@ -264,7 +265,7 @@ CSchedule* CScheduleAlgorithmMinMinMig::compute(std::vector<CTaskCopy>* pTasks,
 		if (migrate == false) {
 
 			// add task to machine queue
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = &((*pTasks)[min_tix]);
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -288,7 +289,7 @@ CSchedule* CScheduleAlgorithmMinMinMig::compute(std::vector<CTaskCopy>* pTasks,
 
 			CTaskCopy* task = &((*pTasks)[min_mig.tix]);
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[0].startProgress;
@@ -300,7 +301,7 @@ CSchedule* CScheduleAlgorithmMinMinMig::compute(std::vector<CTaskCopy>* pTasks,
 			min_mig.parts[0].startProgress,
 			min_mig.parts[0].stopProgress);
 
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[1].startProgress;
@@ -439,10 +440,7 @@ CSchedule* CScheduleAlgorithmMinMinMig::compute(std::vector<CTaskCopy>* pTasks,
 	sched->mActiveTasks = tasks;
 	sched->computeTimes();
 
-	// clean up
-	delete[] C;
-	delete[] active;
-	delete[] R;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMinMinMig("MinMinMig", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMinMinMig>);
@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmMinMinMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CLogger.h"
@@ -41,12 +43,13 @@ CSchedule* CScheduleAlgorithmMinMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 
 
 	// completion time matrix
-	double* C = new double[tasks * machines]();
+	double* C = sched->mArena.createArray<double>(tasks * machines);
 
 	// fill matrix
 	for (int tix = 0; tix<tasks; tix++) {
@@ -69,9 +72,9 @@ CSchedule* CScheduleAlgorithmMinMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 			double resourceReady = sched->resourceReadyTime(mix);
 			double complete = 
 				resourceReady +
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(tix, mix) +
+				matrix->taskTimeCompute(tix, mix) + 
+				matrix->taskTimeFini(tix, mix);
 			C[tix*machines + mix] = complete;
 		}
 	}
@@ -84,6 +87,12 @@ CSchedule* CScheduleAlgorithmMinMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 
 	while (unmappedTasks > 0) {
 
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("MinMin: stopped with %d tasks left, completing schedule by MCT", unmappedTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, false);
+			break;
+		}
+
 		min_mig.parts[0].mix = -1;
 
 		for (int tix = 0; tix < tasks; tix++) {
@@ -236,7 +245,7 @@ CSchedule* CScheduleAlgorithmMinMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 		if (migrate == false) {
 
 			// add task to machine queue
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = &((*pTasks)[min_tix]);
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -249,7 +258,7 @@ CSchedule* CScheduleAlgorithmMinMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 
 			CTaskCopy* task = &((*pTasks)[min_mig.tix]);
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[0].startProgress;
@@ -260,7 +269,7 @@ CSchedule* CScheduleAlgorithmMinMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 			min_mig.parts[0].startProgress,
 			min_mig.parts[0].stopProgress);
 
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[1].startProgress;
@@ -326,9 +335,9 @@ CSchedule* CScheduleAlgorithmMinMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 						// fini time
 						double complete = 
 							ready +
-							mpEstimation->taskTimeInit(task, res) +
-							mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-							mpEstimation->taskTimeFini(task, res);
+							matrix->taskTimeInit(tix, mix) +
+							matrix->taskTimeCompute(tix, mix) + 
+							matrix->taskTimeFini(tix, mix);
 						C[tix*machines + mix] = complete;
 					}
 
@@ -395,8 +404,7 @@ CSchedule* CScheduleAlgorithmMinMinMig2::compute(std::vector<CTaskCopy>* pTasks,
 
 	sched->computeTimes();
 
-	// clean up
-	delete[] C;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterMinMinMig2("MinMinMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmMinMinMig2>);
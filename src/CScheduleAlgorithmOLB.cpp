@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmOLB.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -52,7 +53,7 @@ CSchedule* CScheduleAlgorithmOLB::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 	std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
 
-	double* pResourceReady = new double[machines]();
+	double* pResourceReady = sched->mArena.createArray<double>(machines);
 	// copy previous schedule
 	if (mpPreviousSchedule != 0) {
 		for (int mix=0; mix<machines; mix++) {
@@ -70,7 +71,7 @@ CSchedule* CScheduleAlgorithmOLB::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 				CTaskCopy* task = &((*pTasks)[taskix]);
 
-				STaskEntry* newentry = new STaskEntry();
+				STaskEntry* newentry = sched->newEntry();
 				newentry->taskcopy = task;
 				newentry->taskid = newentry->taskcopy->mId;
 				newentry->stopProgress = newentry->taskcopy->mCheckpoints;
@@ -182,7 +183,7 @@ CSchedule* CScheduleAlgorithmOLB::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 		pResourceReady[selectedMix] = selectedComplete;
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -195,9 +196,10 @@ CSchedule* CScheduleAlgorithmOLB::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 	sched->mActiveTasks = tasks;
 	mpPreviousSchedule = sched;
-	delete[] pResourceReady;
 
 	sched->computeTimes();
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterOLB("OLB", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmOLB>);
@@ -24,6 +24,7 @@ namespace algorithm {
 
 			int init();
 			void fini();
+			bool reusesSchedule() { return true; }
 			CSchedule* compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated);
 	};
 
@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmOLB2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -84,7 +85,7 @@ CSchedule* CScheduleAlgorithmOLB2::compute(std::vector<CTaskCopy>* pTasks, std::
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = entry->taskcopy->mProgress;
@@ -101,3 +102,5 @@ CSchedule* CScheduleAlgorithmOLB2::compute(std::vector<CTaskCopy>* pTasks, std::
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterOLB2("OLB2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmOLB2>);
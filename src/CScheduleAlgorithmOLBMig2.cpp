@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmOLBMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -185,7 +186,7 @@ CSchedule* CScheduleAlgorithmOLBMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 		if (migrate == false) {
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -201,7 +202,7 @@ CSchedule* CScheduleAlgorithmOLBMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 			// add migration option
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[0].startProgress;
@@ -212,7 +213,7 @@ CSchedule* CScheduleAlgorithmOLBMig2::compute(std::vector<CTaskCopy>* pTasks, st
 			min_mig.parts[0].startProgress,
 			min_mig.parts[0].stopProgress);
 
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[1].startProgress;
@@ -234,3 +235,5 @@ CSchedule* CScheduleAlgorithmOLBMig2::compute(std::vector<CTaskCopy>* pTasks, st
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterOLBMig2("OLBMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmOLBMig2>);
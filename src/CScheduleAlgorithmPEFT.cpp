@@ -0,0 +1,108 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "CScheduleAlgorithmPEFT.h"
+#include "CScheduleAlgorithmRegistry.h"
+#include "CTask.h"
+#include "CTaskCopy.h"
+#include "CEstimation.h"
+#include "CEstimationMatrix.h"
+#include "CSchedule.h"
+#include "CScheduleExt.h"
+#include "CTaskRank.h"
+#include "CLogger.h"
+using namespace sched::algorithm;
+using sched::task::CTask;
+using sched::schedule::STaskEntry;
+using sched::schedule::CSchedule;
+using sched::schedule::CScheduleExt;
+
+
+
+CScheduleAlgorithmPEFT::CScheduleAlgorithmPEFT(std::vector<CResource*>& rResources)
+	: CScheduleAlgorithm(rResources)
+{
+	mpEstimation = CEstimation::getEstimation();
+}
+
+CScheduleAlgorithmPEFT::~CScheduleAlgorithmPEFT() {
+	delete mpEstimation;
+	mpEstimation = 0;
+}
+
+int CScheduleAlgorithmPEFT::init() {
+	return 0;
+}
+
+void CScheduleAlgorithmPEFT::fini() {
+}
+
+CSchedule* CScheduleAlgorithmPEFT::compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
+
+	int tasks = pTasks->size();
+	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
+
+	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
+
+	// task priorities by decreasing optimistic cost
+	// the rank is the average of the task's table row, which is the same for all resources
+	CTaskRank rank(sched, mrResources, pTasks, matrix);
+	const std::vector<double>& oct = rank.optimisticCosts();
+	std::vector<int> priorityListIx;
+	rank.order(oct, priorityListIx);
+
+	int listTasks = tasks;
+	// for all elements in priority list
+	while (listTasks > 0) {
+
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("PEFT: stopped with %d tasks left, completing schedule by MCT", listTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, false);
+			break;
+		}
+
+		int ix = priorityListIx[tasks - listTasks];
+		CTaskCopy* task = &(*pTasks)[ix];
+		listTasks--;
+
+		double preFinish = sched->taskReadyTime(task);
+
+		// find slot with smallest optimistic finish time over all machines
+		int best_mix = -1;
+		double best_oeft = 0.0;
+		int best_slot_index = 0;
+		for (int mix = 0; mix < machines; mix++) {
+			CResource* res = mrResources[mix];
+			if (task->validResource(res) == false) {
+				continue;
+			}
+
+			double slot_start = 0.0;
+			double slot_stop = 0.0;
+			int slot_index = sched->findSlot(mix, rank.duration(ix, mix), preFinish, 0, &slot_start, &slot_stop);
+
+			double oeft = slot_stop + oct[ix];
+			CLogger::mainlog->debug("PEFT: tid %d mix %d stop %lf oeft %lf", task->mId, mix, slot_stop, oeft);
+			if (best_mix == -1 || oeft < best_oeft) {
+				best_mix = mix;
+				best_oeft = oeft;
+				best_slot_index = slot_index;
+			}
+		}
+
+		STaskEntry* entry = sched->newEntry();
+		entry->taskcopy = task;
+		entry->taskid = entry->taskcopy->mId;
+		entry->startProgress = entry->taskcopy->mProgress;
+		entry->stopProgress = entry->taskcopy->mCheckpoints;
+		sched->addEntry(entry, mrResources[best_mix], best_slot_index);
+		CLogger::mainlog->debug("PEFT: add tid %d to mix %d slot_index %d", task->mId, best_mix, best_slot_index);
+	}
+
+	sched->computeTimes();
+
+	return sched;
+}
+
+static CScheduleAlgorithmRegistrar sRegisterPEFT("PEFT", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmPEFT>);
@@ -0,0 +1,31 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CSCHEDULEALGORITHMPEFT_H__
+#define __CSCHEDULEALGORITHMPEFT_H__
+#include "CScheduleAlgorithm.h"
+
+namespace sched {
+namespace algorithm {
+
+	class CEstimation;
+
+	/// @brief Predict Earliest Finish Time list scheduling
+	/// Tasks are ordered by their average optimistic cost and mapped to the resource
+	/// with the smallest sum of earliest finish time and optimistic cost, using insertion into idle slots.
+	class CScheduleAlgorithmPEFT : public CScheduleAlgorithm {
+
+		private:
+			CEstimation* mpEstimation;
+
+		public:
+			CScheduleAlgorithmPEFT(std::vector<CResource*>& rResources);
+			~CScheduleAlgorithmPEFT();
+
+			int init();
+			void fini();
+			CSchedule* compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated);
+	};
+
+} }
+#endif
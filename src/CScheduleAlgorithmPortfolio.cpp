@@ -0,0 +1,152 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <cstring>
+#include <sstream>
+#include "CScheduleAlgorithmPortfolio.h"
+#include "CTaskCopy.h"
+#include "CSchedule.h"
+#include "CConfig.h"
+#include "CLogger.h"
+using namespace sched::algorithm;
+using sched::schedule::CSchedule;
+
+
+CScheduleAlgorithmPortfolio::CScheduleAlgorithmPortfolio(std::vector<CResource*>& rResources)
+	: CScheduleAlgorithm(rResources)
+{
+}
+
+CScheduleAlgorithmPortfolio::~CScheduleAlgorithmPortfolio() {
+	for (unsigned int aix=0; aix<mMembers.size(); aix++) {
+		delete mMembers[aix].algorithm;
+	}
+	mMembers.clear();
+}
+
+void CScheduleAlgorithmPortfolio::addMember(const char* name, CScheduleAlgorithm* pAlgorithm) {
+	SMember member = {std::string(name), pAlgorithm, 0};
+	mMembers.push_back(member);
+}
+
+int CScheduleAlgorithmPortfolio::init() {
+
+	if (mMembers.size() == 0) {
+		CLogger::mainlog->error("Portfolio: no algorithms");
+		return -1;
+	}
+
+	CConfig* config = CConfig::getConfig();
+	std::string* objective_str = 0;
+	int ret = config->conf->getString((char*)"portfolio_objective", &objective_str);
+	if (-1 == ret) {
+		CLogger::mainlog->info("Portfolio: config key \"portfolio_objective\" not found, using default: makespan");
+		mObjective = PORTFOLIO_MAKESPAN;
+	} else
+	if (strcmp("makespan", objective_str->c_str()) == 0) {
+		mObjective = PORTFOLIO_MAKESPAN;
+	} else
+	if (strcmp("energy", objective_str->c_str()) == 0) {
+		mObjective = PORTFOLIO_ENERGY;
+	} else {
+		CLogger::mainlog->warn("Portfolio: invalid \"portfolio_objective\" %s, using default: makespan", objective_str->c_str());
+		mObjective = PORTFOLIO_MAKESPAN;
+	}
+	CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"portfolio_objective\",\"value\":\"%s\"", mObjective == PORTFOLIO_ENERGY ? "energy" : "makespan");
+
+	for (unsigned int aix=0; aix<mMembers.size(); aix++) {
+		CLogger::mainlog->info("Portfolio: algorithm %s", mMembers[aix].name.c_str());
+		CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"portfolio_algorithm\",\"value\":\"%s\"", mMembers[aix].name.c_str());
+		if (mMembers[aix].algorithm->init() == -1) {
+			CLogger::mainlog->error("Portfolio: init of algorithm %s failed", mMembers[aix].name.c_str());
+			return -1;
+		}
+	}
+	return 0;
+}
+
+void CScheduleAlgorithmPortfolio::fini() {
+	for (unsigned int aix=0; aix<mMembers.size(); aix++) {
+		mMembers[aix].algorithm->fini();
+	}
+}
+
+double CScheduleAlgorithmPortfolio::objective(CSchedule* schedule) {
+
+	if (mObjective == PORTFOLIO_ENERGY) {
+		return schedule->mTotalEnergy;
+	}
+	return schedule->mDuration.count() / 1000000000.0;
+
+}
+
+CSchedule* CScheduleAlgorithmPortfolio::compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
+
+	int members = mMembers.size();
+
+	// each member owns its task list, running tasks point into the member's list,
+	// an aborting member frees its list with its partial schedule
+	std::vector<std::vector<CTaskCopy>*> tasks(members, 0);
+	std::vector<std::vector<CTaskCopy*>> running(members);
+	tasks[0] = pTasks;
+	running[0] = *runningTasks;
+	for (int aix=1; aix<members; aix++) {
+		tasks[aix] = new std::vector<CTaskCopy>(*pTasks);
+		for (unsigned int mix=0; mix<runningTasks->size(); mix++) {
+			CTaskCopy* task = (*runningTasks)[mix];
+			running[aix].push_back(task == 0 ? 0 : &((*tasks[aix])[task - pTasks->data()]));
+		}
+	}
+
+	std::vector<CSchedule*> schedules(members, 0);
+	std::vector<double> durations(members, 0.0);
+	parallelFor(members,
+		[&](int aix, unsigned int thread) {
+			CScheduleAlgorithm* algorithm = mMembers[aix].algorithm;
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			shareDeadline(algorithm);
+			schedules[aix] = algorithm->compute(tasks[aix], &(running[aix]), interrupt, updated);
+			std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+			durations[aix] = duration.count();
+		}
+	);
+
+	// smallest objective wins, ties go to the earlier member
+	int best = -1;
+	for (int aix=0; aix<members; aix++) {
+		if (schedules[aix] == 0) {
+			continue;
+		}
+		if (best == -1 || objective(schedules[aix]) < objective(schedules[best])) {
+			best = aix;
+		}
+	}
+	if (best == -1) {
+		CLogger::mainlog->debug("Portfolio: no algorithm returned a schedule");
+		return 0;
+	}
+	mRuns++;
+	mMembers[best].wins++;
+
+	std::ostringstream ss;
+	for (int aix=0; aix<members; aix++) {
+		SMember& member = mMembers[aix];
+		ss << (aix == 0 ? "" : ",") << "{\"algorithm\":\"" << member.name << "\"";
+		if (schedules[aix] != 0) {
+			ss << ",\"makespan\":" << schedules[aix]->mDuration.count() / 1000000000.0
+				<< ",\"energy\":" << schedules[aix]->mTotalEnergy;
+		}
+		ss << ",\"duration\":" << durations[aix]
+			<< ",\"wins\":" << member.wins
+			<< ",\"win_rate\":" << (double) member.wins / mRuns << "}";
+	}
+	CLogger::mainlog->info("Portfolio: %s wins with objective %f", mMembers[best].name.c_str(), objective(schedules[best]));
+	CLogger::eventlog->info("\"event\":\"PORTFOLIO\",\"winner\":\"%s\",\"algorithms\":[%s]", mMembers[best].name.c_str(), ss.str().c_str());
+
+	for (int aix=0; aix<members; aix++) {
+		if (aix != best) {
+			delete schedules[aix];
+		}
+	}
+	return schedules[best];
+}
@@ -0,0 +1,61 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CSCHEDULEALGORITHMPORTFOLIO_H__
+#define __CSCHEDULEALGORITHMPORTFOLIO_H__
+#include <string>
+#include "CScheduleAlgorithm.h"
+
+namespace sched {
+namespace algorithm {
+
+	/// @brief Races several algorithms and returns the best schedule
+	///
+	/// All member algorithms compute a schedule for copies of the same task list,
+	/// concurrently on the thread pool and with the same time budget.
+	/// The schedule with the smallest makespan or energy is returned, the other schedules are deleted.
+	/// Members run their own loops serially.
+	/// Since members update their estimation matrices concurrently, each member creates a private matrix on first use
+	/// and keeps it between computations. The shared matrix and thread pool of the computer only reach the portfolio.
+	/// Algorithms that build on their previous schedule cannot be members,
+	/// since the previous schedule of a member is usually not executed.
+	class CScheduleAlgorithmPortfolio : public CScheduleAlgorithm {
+
+		public:
+			/// @brief Schedule property compared between the members
+			enum EPortfolioObjective {
+				PORTFOLIO_MAKESPAN, ///< Smallest makespan wins
+				PORTFOLIO_ENERGY ///< Smallest total energy wins
+			};
+
+		private:
+			/// @brief Algorithm in the portfolio
+			struct SMember {
+				std::string name;
+				CScheduleAlgorithm* algorithm;
+				unsigned long wins; ///< Number of computations won
+			};
+
+			std::vector<SMember> mMembers;
+			EPortfolioObjective mObjective = PORTFOLIO_MAKESPAN;
+			unsigned long mRuns = 0; ///< Number of computations with at least one schedule
+
+			/// @brief Returns the objective value of a schedule, smaller is better
+			double objective(CSchedule* schedule);
+
+		public:
+			CScheduleAlgorithmPortfolio(std::vector<CResource*>& rResources);
+			~CScheduleAlgorithmPortfolio();
+
+			/// @brief Adds an algorithm, the portfolio takes ownership
+			/// @param name Algorithm name for logging
+			/// @param pAlgorithm Algorithm, not initialized yet
+			void addMember(const char* name, CScheduleAlgorithm* pAlgorithm);
+
+			int init();
+			void fini();
+			CSchedule* compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated);
+	};
+
+} }
+#endif
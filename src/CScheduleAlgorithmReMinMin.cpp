@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmReMinMin.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CLogger.h"
 using namespace sched::algorithm;
@@ -40,18 +42,19 @@ CSchedule* CScheduleAlgorithmReMinMin::compute(std::vector<CTaskCopy>* pTasks, s
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CSchedule* sched = new CSchedule(tasks, machines, mrResources);
 	sched->mpOTasks = pTasks;
 
 	// task resource energy
-	double* E = new double[tasks*machines]();
+	double* E = sched->mArena.createArray<double>(tasks*machines);
 	// task resource execution time
-	double* ETC = new double[tasks*machines]();
+	double* ETC = sched->mArena.createArray<double>(tasks*machines);
 	// list of unmapped tasks
 	// 0 -> unmapped
 	// 1 -> mapped
-	int* active = new int[tasks]();
+	int* active = sched->mArena.createArray<int>(tasks);
 
 	int dep[tasks];
 	double depReady[tasks];
@@ -89,17 +92,17 @@ CSchedule* CScheduleAlgorithmReMinMin::compute(std::vector<CTaskCopy>* pTasks, s
 
 			// compute execution time
 			double dur =
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(tix, mix) +
+				matrix->taskTimeCompute(tix, mix) +
+				matrix->taskTimeFini(tix, mix);
 
 			ETC[tasks*mix + tix] = dur;
 
 			// compute energy
 			double energy =
-				mpEstimation->taskEnergyInit(task, res) +
-				mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints) +
-				mpEstimation->taskEnergyFini(task, res);
+				matrix->taskEnergyInit(tix, mix) +
+				matrix->taskEnergyCompute(tix, mix) +
+				matrix->taskEnergyFini(tix, mix);
 
 			E[tasks*mix + tix] = energy;
 
@@ -108,10 +111,10 @@ CSchedule* CScheduleAlgorithmReMinMin::compute(std::vector<CTaskCopy>* pTasks, s
 
 	// remaining tasks
 	// 0 -> remaining, 1 -> done
-	int* rtasks = new int[tasks]();
+	int* rtasks = sched->mArena.createArray<int>(tasks);
 	int rtasks_num = tasks;
 	// machine ready times
-	double* ready = new double[machines]();
+	double* ready = sched->mArena.createArray<double>(machines);
 	double makespan = 0.0;
 	double E_dynamic = 0.0;
 	double res_idle_power = 0.0;
@@ -192,7 +195,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 
 		// add entry to schedule
 		CTaskCopy* task = &((*pTasks)[min_tix]);
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -236,12 +239,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 	sched->mActiveTasks = tasks;
 	sched->computeTimes();
 
-	// clean up
-	delete[] E;
-	delete[] ETC;
-	delete[] ready;
-	delete[] rtasks;
-	delete[] active;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterReMinMin("ReMinMin", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmReMinMin>);
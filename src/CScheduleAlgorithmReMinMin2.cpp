@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmReMinMin2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CLogger.h"
@@ -42,13 +44,14 @@ CSchedule* CScheduleAlgorithmReMinMin2::compute(std::vector<CTaskCopy>* pTasks,
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 
 	// task resource energy
-	double* E = new double[tasks*machines]();
+	double* E = sched->mArena.createArray<double>(tasks*machines);
 	// task resource execution time
-	double* ETC = new double[tasks*machines]();
+	double* ETC = sched->mArena.createArray<double>(tasks*machines);
 
 	// fill arrays
 	for (int tix = 0; tix < tasks; tix++) {
@@ -62,17 +65,17 @@ CSchedule* CScheduleAlgorithmReMinMin2::compute(std::vector<CTaskCopy>* pTasks,
 
 			// compute execution time
 			double dur =
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(tix, mix) +
+				matrix->taskTimeCompute(tix, mix) +
+				matrix->taskTimeFini(tix, mix);
 
 			ETC[tasks*mix + tix] = dur;
 
 			// compute energy
 			double energy =
-				mpEstimation->taskEnergyInit(task, res) +
-				mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints) +
-				mpEstimation->taskEnergyFini(task, res);
+				matrix->taskEnergyInit(tix, mix) +
+				matrix->taskEnergyCompute(tix, mix) +
+				matrix->taskEnergyFini(tix, mix);
 
 			E[tasks*mix + tix] = energy;
 
@@ -93,6 +96,12 @@ CSchedule* CScheduleAlgorithmReMinMin2::compute(std::vector<CTaskCopy>* pTasks,
 	}
 	while (rtasks_num > 0) {
 
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("ScheduleAlgorithmReMinMin: stopped with %d tasks left, completing schedule by MCT", rtasks_num);
+			completeMCT(sched, pTasks, matrix, mpEstimation, false);
+			break;
+		}
+
 		int min_mix = 0;
 		int min_tix = 0;
 		double min_E_total = 0.0;
@@ -157,7 +166,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 
 		// add entry to schedule
 		CTaskCopy* task = &((*pTasks)[min_tix]);
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = entry->taskcopy->mProgress;
@@ -170,9 +179,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 
 	sched->computeTimes();
 
-	// clean up
-	delete[] E;
-	delete[] ETC;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterReMinMin2("ReMinMin2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmReMinMin2>);
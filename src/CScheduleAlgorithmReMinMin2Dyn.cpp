@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmReMinMin2Dyn.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CLogger.h"
@@ -42,14 +44,15 @@ CSchedule* CScheduleAlgorithmReMinMin2Dyn::compute(std::vector<CTaskCopy>* pTask
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 	sched->setRunningTasks(runningTasks);
 
 	// task resource energy
-	double* E = new double[tasks*machines]();
+	double* E = sched->mArena.createArray<double>(tasks*machines);
 	// task resource execution time
-	double* ETC = new double[tasks*machines]();
+	double* ETC = sched->mArena.createArray<double>(tasks*machines);
 
 	// fill arrays
 	for (int tix = 0; tix < tasks; tix++) {
@@ -62,14 +65,14 @@ CSchedule* CScheduleAlgorithmReMinMin2Dyn::compute(std::vector<CTaskCopy>* pTask
 			}
 
 			// compute execution time
-			double init = mpEstimation->taskTimeInit(task, res);
-			double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-			double fini = mpEstimation->taskTimeFini(task, res);
+			double init = matrix->taskTimeInit(tix, mix);
+			double compute = matrix->taskTimeCompute(tix, mix);
+			double fini = matrix->taskTimeFini(tix, mix);
 
 			// compute energy
-			double initEnergy = mpEstimation->taskEnergyInit(task, res);
-			double computeEnergy = mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints);
-			double finiEnergy = mpEstimation->taskEnergyFini(task, res);
+			double initEnergy = matrix->taskEnergyInit(tix, mix);
+			double computeEnergy = matrix->taskEnergyCompute(tix, mix);
+			double finiEnergy = matrix->taskEnergyFini(tix, mix);
 			if (sched->taskRunningResource(tix) == mix &&
 				sched->resourceTasks(mix) == 0) {
 				// task already running on resource and
@@ -101,6 +104,12 @@ CSchedule* CScheduleAlgorithmReMinMin2Dyn::compute(std::vector<CTaskCopy>* pTask
 	}
 	while (rtasks_num > 0) {
 
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("ScheduleAlgorithmReMinMin: stopped with %d tasks left, completing schedule by MCT", rtasks_num);
+			completeMCT(sched, pTasks, matrix, mpEstimation, true);
+			break;
+		}
+
 		int min_mix = 0;
 		int min_tix = 0;
 		double min_E_total = 0.0;
@@ -163,7 +172,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 
 		// add entry to schedule
 		CTaskCopy* task = &((*pTasks)[min_tix]);
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = entry->taskcopy->mProgress;
@@ -187,17 +196,15 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 			}
 			if (tix != -1) {
 
-				CResource* res = mrResources[min_mix];
-
 				// compute execution time
-				double init = mpEstimation->taskTimeInit(task, res);
-				double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-				double fini = mpEstimation->taskTimeFini(task, res);
+				double init = matrix->taskTimeInit(tix, min_mix);
+				double compute = matrix->taskTimeCompute(tix, min_mix);
+				double fini = matrix->taskTimeFini(tix, min_mix);
 
 				// compute energy
-				double initEnergy = mpEstimation->taskEnergyInit(task, res);
-				double computeEnergy = mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints);
-				double finiEnergy = mpEstimation->taskEnergyFini(task, res);
+				double initEnergy = matrix->taskEnergyInit(tix, min_mix);
+				double computeEnergy = matrix->taskEnergyCompute(tix, min_mix);
+				double finiEnergy = matrix->taskEnergyFini(tix, min_mix);
 
 				double dur = init + compute + fini;
 				ETC[tasks*min_mix + tix] = dur;
@@ -212,9 +219,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 
 	sched->computeTimes();
 
-	// clean up
-	delete[] E;
-	delete[] ETC;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterReMinMin2Dyn("ReMinMin2Dyn", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmReMinMin2Dyn>);
@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmReMinMinMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CLogger.h"
@@ -42,13 +44,14 @@ CSchedule* CScheduleAlgorithmReMinMinMig2::compute(std::vector<CTaskCopy>* pTask
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 
 	// task resource energy
-	double* E = new double[tasks*machines]();
+	double* E = sched->mArena.createArray<double>(tasks*machines);
 	// task resource execution time
-	double* ETC = new double[tasks*machines]();
+	double* ETC = sched->mArena.createArray<double>(tasks*machines);
 
 	// fill arrays
 	for (int tix = 0; tix < tasks; tix++) {
@@ -62,17 +65,17 @@ CSchedule* CScheduleAlgorithmReMinMinMig2::compute(std::vector<CTaskCopy>* pTask
 
 			// compute execution time
 			double dur =
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(tix, mix) +
+				matrix->taskTimeCompute(tix, mix) +
+				matrix->taskTimeFini(tix, mix);
 
 			ETC[tasks*mix + tix] = dur;
 
 			// compute energy
 			double energy =
-				mpEstimation->taskEnergyInit(task, res) +
-				mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints) +
-				mpEstimation->taskEnergyFini(task, res);
+				matrix->taskEnergyInit(tix, mix) +
+				matrix->taskEnergyCompute(tix, mix) +
+				matrix->taskEnergyFini(tix, mix);
 
 			E[tasks*mix + tix] = energy;
 
@@ -97,6 +100,12 @@ CSchedule* CScheduleAlgorithmReMinMinMig2::compute(std::vector<CTaskCopy>* pTask
 
 	while (rtasks_num > 0) {
 
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("ReMinMin: stopped with %d tasks left, completing schedule by MCT", rtasks_num);
+			completeMCT(sched, pTasks, matrix, mpEstimation, false);
+			break;
+		}
+
 		min_mig.parts[0].mix = -1;
 
 		// check migration options
@@ -283,7 +292,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 
 		CTaskCopy* task = &((*pTasks)[min_mig.tix]);
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = min_mig.parts[0].startProgress;
@@ -297,7 +306,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 		// migration option
 		if (min_mig.parts[1].mix != -1) {
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[1].startProgress;
@@ -312,9 +321,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 
 	sched->computeTimes();
 
-	// clean up
-	delete[] E;
-	delete[] ETC;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterReMinMinMig2("ReMinMinMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmReMinMinMig2>);
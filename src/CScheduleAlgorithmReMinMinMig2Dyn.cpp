@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmReMinMinMig2Dyn.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CLogger.h"
@@ -42,6 +44,7 @@ CSchedule* CScheduleAlgorithmReMinMinMig2Dyn::compute(std::vector<CTaskCopy>* pT
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	CScheduleExt* sched = new CScheduleExt(tasks, machines, mrResources, pTasks);
 	sched->setRunningTasks(runningTasks);
@@ -64,17 +67,17 @@ CSchedule* CScheduleAlgorithmReMinMinMig2Dyn::compute(std::vector<CTaskCopy>* pT
 
 			// compute execution time
 			double dur =
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) +
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(tix, mix) +
+				matrix->taskTimeCompute(tix, mix) +
+				matrix->taskTimeFini(tix, mix);
 
 			ETC[tasks*mix + tix] = dur;
 
 			// compute energy
 			double energy =
-				mpEstimation->taskEnergyInit(task, res) +
-				mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints) +
-				mpEstimation->taskEnergyFini(task, res);
+				matrix->taskEnergyInit(tix, mix) +
+				matrix->taskEnergyCompute(tix, mix) +
+				matrix->taskEnergyFini(tix, mix);
 
 			E[tasks*mix + tix] = energy;
 
@@ -99,6 +102,12 @@ CSchedule* CScheduleAlgorithmReMinMinMig2Dyn::compute(std::vector<CTaskCopy>* pT
 
 	while (rtasks_num > 0) {
 
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("ReMinMin: stopped with %d tasks left, completing schedule by MCT", rtasks_num);
+			completeMCT(sched, pTasks, matrix, mpEstimation, true);
+			break;
+		}
+
 		min_mig.parts[0].mix = -1;
 
 		// check migration options
@@ -253,13 +262,13 @@ CSchedule* CScheduleAlgorithmReMinMinMig2Dyn::compute(std::vector<CTaskCopy>* pT
 				double ready = sched->taskReadyTimeResource(tix, res, mpEstimation);
 
 
-				double init = mpEstimation->taskTimeInit(task, res);
-				double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-				double fini = mpEstimation->taskTimeFini(task, res);
+				double init = matrix->taskTimeInit(tix, mix);
+				double compute = matrix->taskTimeCompute(tix, mix);
+				double fini = matrix->taskTimeFini(tix, mix);
 
-				double initEnergy = mpEstimation->taskEnergyInit(task, res);
-				double computeEnergy = mpEstimation->taskEnergyCompute(task, res, task->mProgress, task->mCheckpoints);
-				double finiEnergy = mpEstimation->taskEnergyFini(task, res);
+				double initEnergy = matrix->taskEnergyInit(tix, mix);
+				double computeEnergy = matrix->taskEnergyCompute(tix, mix);
+				double finiEnergy = matrix->taskEnergyFini(tix, mix);
 				if (sched->taskRunningResource(tix) == mix &&
 					sched->resourceTasks(mix) == 0) {
 					// task already running on resource and
@@ -309,7 +318,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 
 		CTaskCopy* task = &((*pTasks)[min_mig.tix]);
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = min_mig.parts[0].startProgress;
@@ -323,7 +332,7 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 		// migration option
 		if (min_mig.parts[1].mix != -1) {
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[1].startProgress;
@@ -344,3 +353,5 @@ CLogger::mainlog->debug("ScheduleAlgorithmReMinMin: pick task %d", tix);
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterReMinMinMig2Dyn("ReMinMinMig2Dyn", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmReMinMinMig2Dyn>);
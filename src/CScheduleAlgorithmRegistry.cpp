@@ -0,0 +1,93 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <dlfcn.h>
+#include "CScheduleAlgorithmRegistry.h"
+#include "CLogger.h"
+using namespace sched::algorithm;
+
+
+const unsigned int CScheduleAlgorithmRegistry::sPluginAbi;
+const char* const CScheduleAlgorithmRegistry::sPluginEntry = "sched_algorithm_plugin";
+
+CScheduleAlgorithmRegistry* CScheduleAlgorithmRegistry::getRegistry(){
+
+	// constructed on first use, registrars run during static initialization
+	static CScheduleAlgorithmRegistry registry;
+	return &registry;
+
+}
+
+int CScheduleAlgorithmRegistry::add(const char* name, FCreate create){
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mAlgorithms.emplace(name, create).second == true ? 0 : -1;
+
+}
+
+CScheduleAlgorithm* CScheduleAlgorithmRegistry::create(const char* name, std::vector<CResource*>& rResources){
+
+	FCreate create = 0;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto it = mAlgorithms.find(name);
+		if (it == mAlgorithms.end()) {
+			return 0;
+		}
+		create = it->second;
+	}
+	return create(rResources);
+
+}
+
+int CScheduleAlgorithmRegistry::loadPlugin(const char* path){
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	if (mPlugins.find(path) != mPlugins.end()) {
+		return 0;
+	}
+	lock.unlock();
+
+	void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+	if (handle == 0) {
+		CLogger::mainlog->error("AlgorithmRegistry: failed to load plugin %s: %s", path, dlerror());
+		return -1;
+	}
+	FPluginEntry entry = (FPluginEntry) dlsym(handle, sPluginEntry);
+	if (entry == 0) {
+		CLogger::mainlog->error("AlgorithmRegistry: plugin %s has no entry point %s", path, sPluginEntry);
+		dlclose(handle);
+		return -1;
+	}
+	// the entry point registers the algorithms with add()
+	int res = entry(sPluginAbi, this);
+
+	// algorithms registered before a failure refer to the plugin, so it stays loaded
+	lock.lock();
+	mPlugins[path] = handle;
+	lock.unlock();
+	if (res != 0) {
+		CLogger::mainlog->error("AlgorithmRegistry: plugin %s failed to register, executable interface version %u", path, sPluginAbi);
+		return -1;
+	}
+	CLogger::mainlog->info("AlgorithmRegistry: loaded plugin %s", path);
+	return 0;
+
+}
+
+void CScheduleAlgorithmRegistry::getNames(std::vector<std::string>& rNames){
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (auto it = mAlgorithms.begin(); it != mAlgorithms.end(); it++) {
+		rNames.push_back(it->first);
+	}
+	std::sort(rNames.begin(), rNames.end());
+
+}
+
+CScheduleAlgorithmRegistrar::CScheduleAlgorithmRegistrar(const char* name, CScheduleAlgorithmRegistry::FCreate create){
+
+	CScheduleAlgorithmRegistry::getRegistry()->add(name, create);
+
+}
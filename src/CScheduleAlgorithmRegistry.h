@@ -0,0 +1,95 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CSCHEDULEALGORITHMREGISTRY_H__
+#define __CSCHEDULEALGORITHMREGISTRY_H__
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+namespace sched {
+namespace schedule {
+	class CResource;
+} }
+
+
+namespace sched {
+namespace algorithm {
+
+	using sched::schedule::CResource;
+
+	class CScheduleAlgorithm;
+
+	/// @brief Maps algorithm names to factory functions
+	///
+	/// Algorithms register themselves with a static CScheduleAlgorithmRegistrar in their source file.
+	/// Further algorithms are loaded from shared objects with loadPlugin().
+	/// A plugin exports the C function named by sPluginEntry with the signature FPluginEntry.
+	/// The function is called with sPluginAbi and the registry, checks the version and adds its algorithms with add().
+	/// The executables export their symbols, so plugin algorithms derive from CScheduleAlgorithm like built-in algorithms.
+	class CScheduleAlgorithmRegistry {
+
+		public:
+			/// @brief Creates an algorithm instance
+			/// @param rResources List of resources
+			/// @return New algorithm
+			typedef CScheduleAlgorithm* (*FCreate)(std::vector<CResource*>& rResources);
+
+			/// @brief Plugin entry point
+			/// @param abi Plugin interface version of the executable
+			/// @param pRegistry Registry to add algorithms to
+			/// @return 0 on success, -1 on error
+			typedef int (*FPluginEntry)(unsigned int abi, CScheduleAlgorithmRegistry* pRegistry);
+
+			static const unsigned int sPluginAbi = 1; ///< Plugin interface version, changes with CScheduleAlgorithm
+			static const char* const sPluginEntry; ///< Name of the plugin entry point
+
+		private:
+			std::mutex mMutex;
+			std::unordered_map<std::string, FCreate> mAlgorithms; ///< Factory per algorithm name
+			std::unordered_map<std::string, void*> mPlugins; ///< Handle per loaded plugin path, plugins stay loaded until exit
+
+		public:
+			/// @brief Returns the registry of the process
+			static CScheduleAlgorithmRegistry* getRegistry();
+
+			/// @brief Registers an algorithm
+			/// @param name Algorithm name as used in the config
+			/// @param create Factory function
+			/// @return 0 on success, -1 if the name is already registered
+			int add(const char* name, FCreate create);
+
+			/// @brief Creates an algorithm by name
+			/// @param name Algorithm name
+			/// @param rResources List of resources
+			/// @return New algorithm or null if the name is unknown
+			CScheduleAlgorithm* create(const char* name, std::vector<CResource*>& rResources);
+
+			/// @brief Loads a plugin and registers its algorithms
+			/// Loading a path a second time has no effect.
+			/// @param path Path of the shared object
+			/// @return 0 on success, -1 on error
+			int loadPlugin(const char* path);
+
+			/// @brief Returns the registered algorithm names in sorted order
+			/// @param rNames Vector to store the names into
+			void getNames(std::vector<std::string>& rNames);
+	};
+
+	/// @brief Registers an algorithm during static initialization
+	class CScheduleAlgorithmRegistrar {
+
+		public:
+			/// @param name Algorithm name as used in the config
+			/// @param create Factory function
+			CScheduleAlgorithmRegistrar(const char* name, CScheduleAlgorithmRegistry::FCreate create);
+
+			/// @brief Factory function for algorithms constructed from the resource list only
+			template<class T>
+			static CScheduleAlgorithm* construct(std::vector<CResource*>& rResources) {
+				return new T(rResources);
+			}
+	};
+
+} }
+#endif
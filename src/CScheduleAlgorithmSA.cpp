@@ -6,6 +6,7 @@
 #include <algorithm>
 #include "CConfig.h"
 #include "CScheduleAlgorithmSA.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -92,7 +93,7 @@ CSchedule* CScheduleAlgorithmSA::compute(std::vector<CTaskCopy>* pTasks, std::ve
 
 	std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
 
-	double* pResourceReady = new double[machines]();
+	double* pResourceReady = sched->mArena.createArray<double>(machines);
 	// copy previous schedule
 	if (mpPreviousSchedule != 0) {
 		for (int mix=0; mix<machines; mix++) {
@@ -110,7 +111,7 @@ CSchedule* CScheduleAlgorithmSA::compute(std::vector<CTaskCopy>* pTasks, std::ve
 
 				CTaskCopy* task = &((*pTasks)[taskix]);
 
-				STaskEntry* newentry = new STaskEntry();
+				STaskEntry* newentry = sched->newEntry();
 				newentry->taskcopy = task;
 				newentry->taskid = newentry->taskcopy->mId;
 				newentry->stopProgress = newentry->taskcopy->mCheckpoints;
@@ -231,7 +232,7 @@ CSchedule* CScheduleAlgorithmSA::compute(std::vector<CTaskCopy>* pTasks, std::ve
 
 		pResourceReady[selectedMix] = selectedComplete;
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -245,7 +246,8 @@ CSchedule* CScheduleAlgorithmSA::compute(std::vector<CTaskCopy>* pTasks, std::ve
 
 	sched->mActiveTasks = tasks;
 	mpPreviousSchedule = sched;
-	delete[] pResourceReady;
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterSA("SA", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmSA>);
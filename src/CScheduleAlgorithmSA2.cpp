@@ -6,6 +6,7 @@
 #include <algorithm>
 #include "CConfig.h"
 #include "CScheduleAlgorithmSA2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -149,7 +150,7 @@ CSchedule* CScheduleAlgorithmSA2::compute(std::vector<CTaskCopy>* pTasks, std::v
 		}
 
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = entry->taskcopy->mProgress;
@@ -168,3 +169,5 @@ CSchedule* CScheduleAlgorithmSA2::compute(std::vector<CTaskCopy>* pTasks, std::v
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterSA2("SA2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmSA2>);
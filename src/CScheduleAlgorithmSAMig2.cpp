@@ -6,6 +6,7 @@
 #include <algorithm>
 #include "CConfig.h"
 #include "CScheduleAlgorithmSAMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -246,7 +247,7 @@ CSchedule* CScheduleAlgorithmSAMig2::compute(std::vector<CTaskCopy>* pTasks, std
 
 			// only add normal option
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = entry->taskcopy->mProgress;
@@ -262,7 +263,7 @@ CSchedule* CScheduleAlgorithmSAMig2::compute(std::vector<CTaskCopy>* pTasks, std
 
 			// add migration option
 
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[0].startProgress;
@@ -273,7 +274,7 @@ CSchedule* CScheduleAlgorithmSAMig2::compute(std::vector<CTaskCopy>* pTasks, std
 			min_mig.parts[0].startProgress,
 			min_mig.parts[0].stopProgress);
 
-			entry = new STaskEntry();
+			entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_mig.parts[1].startProgress;
@@ -296,3 +297,5 @@ CSchedule* CScheduleAlgorithmSAMig2::compute(std::vector<CTaskCopy>* pTasks, std
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterSAMig2("SAMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmSAMig2>);
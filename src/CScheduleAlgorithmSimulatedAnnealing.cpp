@@ -1,10 +1,12 @@
 // Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
 // SPDX-License-Identifier: BSD-2-Clause
 
+#include <cmath>
 #include <limits>
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmSimulatedAnnealing.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -44,6 +46,8 @@ int CScheduleAlgorithmSimulatedAnnealing::init() {
 
 	mRandom = std::mt19937(seed);
 
+	mValidate = loadValidate("ScheduleAlgorithmSimulatedAnnealing");
+
 
 	ret = config->conf->getDouble((char*)"simann_init_prob", &mInitialProb);
 	if (-1 == ret) {
@@ -87,11 +91,113 @@ void CScheduleAlgorithmSimulatedAnnealing::fini() {
 	CScheduleAlgorithmGenetic::fini();
 }
 
-void CScheduleAlgorithmSimulatedAnnealing::randomize(CGeneticSchedule* schedule, int* height, int machines, int height_num, std::vector<int>* height_sets, int max_num){
+void CScheduleAlgorithmSimulatedAnnealing::randomize(CGeneticSchedule* schedule, int* height, int machines, int height_num, std::vector<int>* height_sets, int max_num, SGeneticSwap* swap){
 
 	// single mutate
-	mutate(schedule, height, machines, height_num, height_sets, max_num);
+	mutate(mRandom, schedule, height, machines, height_num, height_sets, max_num, swap);
+
+}
+
+template <enum CScheduleAlgorithmGenetic::EGeneticFitnessType Fitness>
+CScheduleAlgorithm::EComputeState CScheduleAlgorithmSimulatedAnnealing::anneal(CGeneticSchedule* solution, CGeneticSchedule* bestSolution, SGeneticProblem* problem, int loops_num, double* temperature, volatile int* interrupt) {
+
+	int lowProbCount = 0; // number of moves with low acceptance probability
+
+	EComputeState state = COMPUTE_CONTINUE;
+
+	SFitnessCache cache;
+	fitnessCacheInit<Fitness>(&cache, solution, problem);
+	SGeneticSwap swap;
+
+	do {
+		lowProbCount = 0;
+
+		for (int loopIx = 0; loopIx < loops_num; loopIx++) {
+
+			double prob = 0.0;
+
+			// compute new neighbor
+			randomize(solution, problem->height, problem->machines, problem->height_num, problem->height_sets, problem->max_num, &swap);
+			if (mValidate == true && solution->check() == false) {
+				CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: oops");
+				solution->print();
+			}
+			// cost difference = cost(solution) - cost(neighbor)
+			double neighborFitness = fitnessCacheTrial<Fitness>(&cache, &swap, problem);
+			if (mValidate == true) {
+				// the incremental evaluation has to agree with the full evaluation of the neighbor
+				double solutionFitness = solution->fitness;
+				fitness<Fitness>(solution, &mScratch[0], problem->tasks, problem->height_sets, problem->height, problem->machines, problem->height_num, problem->pTasks, problem->max_num, problem->taskmap, problem->double_max, problem->runningTasks);
+				if (std::fabs(solution->fitness - neighborFitness) > 1e-9 * (1.0 + std::fabs(solution->fitness))) {
+					CLogger::mainlog->error("ScheduleAlgorithmSimulatedAnnealing: cached fitness %lf differs from full fitness %lf", neighborFitness, solution->fitness);
+				}
+				solution->fitness = solutionFitness;
+			}
+
+			double diff = solution->fitness - neighborFitness;
+			// probability to adopt the neighbor, in case of diff > 0.0
+			// use e^(d/T) instead of e^(d/T), because positive diff is uphill
+			// negative diff is downhill
+			// 0 diff -> 1.0 prob, 0.5T diff -> 0.6 prob, 1T diff -> 0.36 prob
+			prob = exp( (diff / *temperature));
+			if (diff == 0.0) {
+				prob = 1.0;
+			}
+
+			bool adopt = false;
+			if (diff >= 0.0) {
+				// downhill move, solution gets better
+				adopt = true;
+			} else {
+				// uphill move, neighbor is worse
+				// diff < 0.0, adopt with probability e^(diff/temperature)
+				double pick = ((double)mRandom()) / ((double)mRandom.max());
+				if (pick < prob) {
+					adopt = true;
+				}
+			}
+
+			CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: fitness %lf neighbor %lf diff %lf prob %lf temp %lf", 
+			solution->fitness, neighborFitness, diff, prob, *temperature);
+			if (adopt == true) {
+				// adopt
+				fitnessCacheCommit<Fitness>(&cache);
+				solution->fitness = neighborFitness;
+			} else
+			if (swap.tix != -1) {
+				// revert swap
+				solution->queue(swap.mix)[swap.rix] = swap.tix;
+				solution->queue(swap.mix2)[swap.rix2] = swap.tix2;
+			}
 
+			// count low acceptance moves
+			CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: mMinProb - prob %.40lf", mMinProb - prob);
+			if (prob < mMinProb) {
+				CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: prob %lf minProb %lf lowProbCount %d", prob, mMinProb, lowProbCount);
+				lowProbCount++;
+			}
+
+			// save best solution
+			if (solution->fitness < bestSolution->fitness) {
+				solution->transfer(bestSolution);
+			}
+
+			state = computeState(interrupt);
+			if (state != COMPUTE_CONTINUE) {
+				break;
+			}
+		}
+
+		// reduce temperature
+		*temperature = mReduce * *temperature;
+
+		if (*temperature == 0.0) {
+			break;
+		}
+		
+	} while( lowProbCount < 5 && state == COMPUTE_CONTINUE );
+
+	return state;
 }
 
 CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>* pTasks, std::vector<CTaskCopy*>* runningTasks, volatile int* interrupt, int updated) {
@@ -123,7 +229,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -131,7 +237,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 		return sched;
 	}
 
-
+	prepareFitness(pTasks);
 
 	// generate map for global id to local id conversion
 	std::unordered_map<int,int> taskmap;
@@ -141,13 +247,13 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 
 	// prepare tasks
 	// compute height for every task
-	int* height = new int[tasks]();
+	int* height = sched->mArena.createArray<int>(tasks);
 	for (int ix=0; ix<tasks; ix++) {
 		height[ix] = -1;
 	}
 	int max_height = -1;
 	// for each task traverse successor tasks to set height
-	int* stack = new int[tasks*2](); // taskid, height
+	int* stack = sched->mArena.createArray<int>(tasks*2); // taskid, height
 	int stackIx = 0; // next element
 	for (int ix=0; ix<tasks; ix++) {
 		if (height[ix] != -1) {
@@ -206,7 +312,6 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 			}
 		}
 	}
-	delete[] stack;
 
 	// all tasks have height 0 ?
 	if (tasks > 0 && max_height == -1) {
@@ -374,7 +479,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 
 	// compute initial solution
 
-	CGeneticSchedule* initialSolution = generateSchedule(height_sets, height_num, machines, max_num, pTasks);
+	CGeneticSchedule* initialSolution = generateSchedule(mRandom, height_sets, height_num, machines, max_num, pTasks);
 
 
 	double double_max = 1000000000.0; // punishment value for invalid schedules for the initial run
@@ -382,13 +487,11 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 	CGeneticSchedule* solution = new CGeneticSchedule(max_num, machines);
 	initialSolution->transfer(solution);
 	
-	fitness(solution, tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
+	fitness(solution, &(mScratch[0]), tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
 
 	CGeneticSchedule* bestSolution = new CGeneticSchedule(max_num, machines);
 	solution->transfer(bestSolution);
 
-	CGeneticSchedule* neighbor = new CGeneticSchedule(max_num, machines);
-
 
 	// initial run to compute temperature for initial probability
 	int initialRun_num = 2*loops_num;
@@ -399,27 +502,48 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 	//double avgFitness = 0.0;
 	int posDiffIx = 0;
 
-	for (int loopIx = 0; loopIx < initialRun_num; loopIx++) {
+	// neighbors are generated in order from the random stream,
+	// their fitness is evaluated in parallel in batches
+	int batch_num = getThreads() * 8;
+	if (batch_num > initialRun_num) {
+		batch_num = initialRun_num;
+	}
+	std::vector<CGeneticSchedule*> neighbors;
+	for (int bix=0; bix<batch_num; bix++) {
+		neighbors.push_back(new CGeneticSchedule(max_num, machines));
+	}
+
+	for (int loopIx = 0; loopIx < initialRun_num; loopIx += batch_num) {
 
-		// compute new solution
-		// compute new neighbor
-		solution->transfer(neighbor);
-		for (int i=0; i<1; i++) {
-			randomize(neighbor, height, machines, height_num, height_sets, max_num);
+		int num = initialRun_num - loopIx;
+		if (num > batch_num) {
+			num = batch_num;
 		}
 
-		// cost difference = cost(solution) - cost(neighbor)
-		fitness(neighbor, tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
-		double diff = solution->fitness - neighbor->fitness;
+		// compute new neighbors
+		for (int bix=0; bix<num; bix++) {
+			solution->transfer(neighbors[bix]);
+			randomize(neighbors[bix], height, machines, height_num, height_sets, max_num);
+		}
+
+		parallelFor(num, [&](int bix, unsigned int thread) {
+			fitness(neighbors[bix], &(mScratch[thread]), tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
+		});
+
+		for (int bix=0; bix<num; bix++) {
+			// cost difference = cost(solution) - cost(neighbor)
+			double diff = solution->fitness - neighbors[bix]->fitness;
+
+			// save cost differences for worse neighbors
+			initialDiff[posDiffIx] = abs(diff);
+			posDiffIx++;
 
-		// save cost differences for worse neighbors
-		//if (diff < 0.0) {
-		initialDiff[posDiffIx] = abs(diff);
-		posDiffIx++;
-		//}
-		//avgFitness += cost_neighbor / loops_num;
+			CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: loopIx %d fitness %lf diff %lf", loopIx + bix, neighbors[bix]->fitness, diff);
+		}
+	}
 
-		CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: loopIx %d fitness %lf diff %lf", loopIx, neighbor->fitness, diff);
+	for (int bix=0; bix<batch_num; bix++) {
+		delete neighbors[bix];
 	}
 
 	// compute initial temperature
@@ -445,101 +569,44 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 
 	CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: initial temperature %lf", temperature);
 
-	int lowProbCount = 0; // number of moves with low acceptance probability
-
-	bool interrupted = false;
-
 	// punishment value for invalid schedules for the real run
 	//double_max = std::numeric_limits<double>::max(); 
 	double_max = 1000000000000000000.0;
 
-	do {
-		lowProbCount = 0;
-
-		for (int loopIx = 0; loopIx < loops_num; loopIx++) {
-
-			double prob = 0.0;
-
-			// compute new neighbor
-			solution->transfer(neighbor);
-			for (int i=0; i<1; i++) {
-				randomize(neighbor, height, machines, height_num, height_sets, max_num);
-				if (neighbor->check() == false) {
-					CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: oops");
-					solution->print();
-					neighbor->print();
-				}
-			}
-			// cost difference = cost(solution) - cost(neighbor)
-				fitness(neighbor, tasks, height_sets, height, machines, height_num, pTasks, max_num, &taskmap, double_max, runningTasks);
-
-			double diff = solution->fitness - neighbor->fitness;
-			// probability to adopt the neighbor, in case of diff > 0.0
-			// use e^(d/T) instead of e^(d/T), because positive diff is uphill
-			// negative diff is downhill
-			// 0 diff -> 1.0 prob, 0.5T diff -> 0.6 prob, 1T diff -> 0.36 prob
-			prob = exp( (diff / temperature));
-			if (diff == 0.0) {
-				prob = 1.0;
-			}
-
-			bool adopt = false;
-			if (diff >= 0.0) {
-				// downhill move, solution gets better
-				adopt = true;
-			} else {
-				// uphill move, neighbor is worse
-				// diff < 0.0, adopt with probability e^(diff/temperature)
-				double pick = ((double)mRandom()) / ((double)mRandom.max());
-				if (pick < prob) {
-					adopt = true;
-				}
-			}
-
-			CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: fitness %lf neighbor %lf diff %lf prob %lf temp %lf", 
-			solution->fitness, neighbor->fitness, diff, prob, temperature);
-			if (adopt == true) {
-				// adopt
-				neighbor->transfer(solution);
-			}
-
-			// count low acceptance moves
-			CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: mMinProb - prob %.40lf", mMinProb - prob);
-			if (prob < mMinProb) {
-				CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: prob %lf minProb %lf lowProbCount %d", prob, mMinProb, lowProbCount);
-				lowProbCount++;
-			}
-
-			// save best solution
-			if (solution->fitness < bestSolution->fitness) {
-				solution->transfer(bestSolution);
-			}
-
-			if (*interrupt == 1) {
-				// oops
-				interrupted = true;
-				//	CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: oops");
-				break;
-			}
-		}
-
-		// reduce temperature
-		temperature = mReduce * temperature;
-
-		if (temperature == 0.0) {
-			break;
-		}
-		
-	} while( lowProbCount < 5 && interrupted == false );
+	// neighbors differ from the solution in one swap,
+	// so they are applied to the solution in place and evaluated incrementally
+	SGeneticProblem problem;
+	problem.tasks = tasks;
+	problem.machines = machines;
+	problem.max_num = max_num;
+	problem.height_num = height_num;
+	problem.height = height;
+	problem.height_sets = height_sets;
+	problem.pTasks = pTasks;
+	problem.taskmap = &taskmap;
+	problem.double_max = double_max;
+	problem.runningTasks = runningTasks;
+
+	EComputeState state = COMPUTE_CONTINUE;
+	if (getFitnessType() == GENETIC_FITNESS_ENERGY) {
+		state = anneal<GENETIC_FITNESS_ENERGY>(solution, bestSolution, &problem, loops_num, &temperature, interrupt);
+	} else {
+		state = anneal<GENETIC_FITNESS_MAKESPAN>(solution, bestSolution, &problem, loops_num, &temperature, interrupt);
+	}
 
 	bestSolution->print();
 
-	if (interrupted == false) {
+	if (state == COMPUTE_STOP) {
+		CLogger::mainlog->info("ScheduleAlgorithmSimulatedAnnealing: stopped at temperature %e, using best schedule so far", temperature);
+	}
+
+	if (state != COMPUTE_ABORT) {
 		// add task to machine queue
 		for (int mix=0; mix<machines; mix++) {
+			int* queue = bestSolution->queue(mix);
 			for (int rix=0; rix<bestSolution->num[mix]; rix++) {
-				int tix = bestSolution->tasks[max_num*mix + rix];
-				STaskEntry* entry = new STaskEntry();
+				int tix = queue[rix];
+				STaskEntry* entry = sched->newEntry();
 				entry->taskcopy = &((*pTasks)[tix]);
 				entry->taskid = entry->taskcopy->mId;
 				entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -554,7 +621,6 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 
 	// clean up
 	delete[] height_sets;
-	delete[] height;
 /*
 	for (int pix=0; pix<pop_num; pix++) {
 		delete pop->back();
@@ -574,7 +640,13 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealing::compute(std::vector<CTaskCopy>*
 	delete initialSolution;
 	delete bestSolution;
 	delete solution;
-	delete neighbor;
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterSimulatedAnnealing("SimulatedAnnealing", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmSimulatedAnnealing(rResources, CScheduleAlgorithmGenetic::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
+});
+static CScheduleAlgorithmRegistrar sRegisterSimulatedAnnealingEnergy("SimulatedAnnealingEnergy", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmSimulatedAnnealing(rResources, CScheduleAlgorithmGenetic::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
+});
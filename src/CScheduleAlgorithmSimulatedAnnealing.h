@@ -113,7 +113,18 @@ namespace algorithm {
 
 		private:
 
-			void randomize(CGeneticSchedule* schedule, int* height, int machines, int height_num, std::vector<int>* height_sets, int max_num);
+			/// @brief Applies a random swap to the schedule
+			/// @param[out] swap Applied swap, optional
+			void randomize(CGeneticSchedule* schedule, int* height, int machines, int height_num, std::vector<int>* height_sets, int max_num, SGeneticSwap* swap = 0);
+
+			/// @brief Anneals the solution until the acceptance probability stays low or the computation is stopped
+			/// @tparam Fitness Fitness type of the incremental evaluation
+			/// @param[in,out] solution Current solution, fitness has to be computed
+			/// @param[out] bestSolution Best solution found, fitness has to be computed
+			/// @param[in,out] temperature Initial temperature, final temperature on return
+			/// @return Compute state at the end of the annealing
+			template <enum EGeneticFitnessType Fitness>
+			EComputeState anneal(CGeneticSchedule* solution, CGeneticSchedule* bestSolution, SGeneticProblem* problem, int loops_num, double* temperature, volatile int* interrupt);
 
 		public:
 			CScheduleAlgorithmSimulatedAnnealing(std::vector<CResource*>& rResources, enum EGeneticFitnessType fitness);
@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmSimulatedAnnealingDyn.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -44,6 +45,8 @@ int CScheduleAlgorithmSimulatedAnnealingDyn::init() {
 
 	mRandom = std::mt19937(seed);
 
+	mValidate = loadValidate("ScheduleAlgorithmSimulatedAnnealingDyn");
+
 
 	ret = config->conf->getDouble((char*)"simann_init_prob", &mInitialProb);
 	if (-1 == ret) {
@@ -123,7 +126,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingDyn::compute(std::vector<CTaskCop
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -141,13 +144,13 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingDyn::compute(std::vector<CTaskCop
 
 	// prepare tasks
 	// compute height for every task
-	int* height = new int[tasks]();
+	int* height = sched->mArena.createArray<int>(tasks);
 	for (int ix=0; ix<tasks; ix++) {
 		height[ix] = -1;
 	}
 	int max_height = -1;
 	// for each task traverse successor tasks to set height
-	int* stack = new int[tasks*2](); // taskid, height
+	int* stack = sched->mArena.createArray<int>(tasks*2); // taskid, height
 	int stackIx = 0; // next element
 	for (int ix=0; ix<tasks; ix++) {
 		if (height[ix] != -1) {
@@ -206,7 +209,6 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingDyn::compute(std::vector<CTaskCop
 			}
 		}
 	}
-	delete[] stack;
 
 	// all tasks have height 0 ?
 	if (tasks > 0 && max_height == -1) {
@@ -447,7 +449,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingDyn::compute(std::vector<CTaskCop
 
 	int lowProbCount = 0; // number of moves with low acceptance probability
 
-	bool interrupted = false;
+	EComputeState state = COMPUTE_CONTINUE;
 
 	// punishment value for invalid schedules for the real run
 	//double_max = std::numeric_limits<double>::max(); 
@@ -464,7 +466,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingDyn::compute(std::vector<CTaskCop
 			solution->transfer(neighbor);
 			for (int i=0; i<1; i++) {
 				randomize(neighbor, height, machines, height_num, height_sets, max_num);
-				if (neighbor->check() == false) {
+				if (mValidate == true && neighbor->check() == false) {
 					CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: oops");
 					solution->print();
 					neighbor->print();
@@ -515,10 +517,8 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingDyn::compute(std::vector<CTaskCop
 				solution->transfer(bestSolution);
 			}
 
-			if (*interrupt == 1) {
-				// oops
-				interrupted = true;
-				//	CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: oops");
+			state = computeState(interrupt);
+			if (state != COMPUTE_CONTINUE) {
 				break;
 			}
 		}
@@ -530,16 +530,20 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingDyn::compute(std::vector<CTaskCop
 			break;
 		}
 		
-	} while( lowProbCount < 5 && interrupted == false );
+	} while( lowProbCount < 5 && state == COMPUTE_CONTINUE );
 
 	bestSolution->print();
 
-	if (interrupted == false) {
+	if (state == COMPUTE_STOP) {
+		CLogger::mainlog->info("ScheduleAlgorithmSimulatedAnnealing: stopped at temperature %e, using best schedule so far", temperature);
+	}
+
+	if (state != COMPUTE_ABORT) {
 		// add task to machine queue
 		for (int mix=0; mix<machines; mix++) {
 			for (int rix=0; rix<bestSolution->num[mix]; rix++) {
 				int tix = bestSolution->tasks[max_num*mix + rix];
-				STaskEntry* entry = new STaskEntry();
+				STaskEntry* entry = sched->newEntry();
 				entry->taskcopy = &((*pTasks)[tix]);
 				entry->taskid = entry->taskcopy->mId;
 				entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -554,7 +558,6 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingDyn::compute(std::vector<CTaskCop
 
 	// clean up
 	delete[] height_sets;
-	delete[] height;
 /*
 	for (int pix=0; pix<pop_num; pix++) {
 		delete pop->back();
@@ -578,3 +581,10 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingDyn::compute(std::vector<CTaskCop
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterSimulatedAnnealingDyn("SimulatedAnnealingDyn", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmSimulatedAnnealingDyn(rResources, CScheduleAlgorithmGeneticDyn::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
+});
+static CScheduleAlgorithmRegistrar sRegisterSimulatedAnnealingEnergyDyn("SimulatedAnnealingEnergyDyn", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmSimulatedAnnealingDyn(rResources, CScheduleAlgorithmGeneticDyn::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
+});
@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmSimulatedAnnealingMig.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -44,6 +45,14 @@ int CScheduleAlgorithmSimulatedAnnealingMig::init() {
 
 	mRandom = std::mt19937(seed);
 
+	ret = config->conf->getBool((char*)"genetic_validate", &mValidate);
+	if (-1 == ret) {
+		mValidate = false;
+		CLogger::mainlog->info("ScheduleAlgorithmSimulatedAnnealing: config key \"genetic_validate\" not found, using default: false");
+	}
+	CLogger::mainlog->info("ScheduleAlgorithmSimulatedAnnealing: genetic_validate: %s", mValidate == true ? "true" : "false");
+	CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"genetic_validate\",\"value\":%s", mValidate == true ? "true" : "false");
+
 
 	ret = config->conf->getDouble((char*)"simann_init_prob", &mInitialProb);
 	if (-1 == ret) {
@@ -128,7 +137,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 			}
 		}
 
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -146,13 +155,13 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 
 	// prepare tasks
 	// compute height for every task
-	int* height = new int[tasks]();
+	int* height = sched->mArena.createArray<int>(tasks);
 	for (int ix=0; ix<tasks; ix++) {
 		height[ix] = -1;
 	}
 	int max_height = -1;
 	// for each task traverse successor tasks to set height
-	int* stack = new int[tasks*2](); // taskid, height
+	int* stack = sched->mArena.createArray<int>(tasks*2); // taskid, height
 	int stackIx = 0; // next element
 	for (int ix=0; ix<tasks; ix++) {
 		if (height[ix] != -1) {
@@ -211,7 +220,6 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 			}
 		}
 	}
-	delete[] stack;
 
 	// all tasks have height 0 ?
 	if (tasks > 0 && max_height == -1) {
@@ -452,7 +460,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 
 	int lowProbCount = 0; // number of moves with low acceptance probability
 
-	bool interrupted = false;
+	EComputeState state = COMPUTE_CONTINUE;
 
 	// punishment value for invalid schedules for the real run
 	//double_max = std::numeric_limits<double>::max(); 
@@ -469,7 +477,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 			solution->transfer(neighbor);
 			for (int i=0; i<1; i++) {
 				randomize(neighbor, height, machines, height_num, height_sets, max_num*2);
-				if (neighbor->check() == false) {
+				if (mValidate == true && neighbor->check() == false) {
 					CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: oops");
 					solution->print();
 					neighbor->print();
@@ -520,10 +528,8 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 				solution->transfer(bestSolution);
 			}
 
-			if (*interrupt == 1) {
-				// oops
-				interrupted = true;
-				//	CLogger::mainlog->debug("ScheduleAlgorithmSimulatedAnnealing: oops");
+			state = computeState(interrupt);
+			if (state != COMPUTE_CONTINUE) {
 				break;
 			}
 		}
@@ -535,11 +541,15 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 			break;
 		}
 		
-	} while( lowProbCount < 5 && interrupted == false );
+	} while( lowProbCount < 5 && state == COMPUTE_CONTINUE );
 
 	bestSolution->print();
 
-	if (interrupted == false) {
+	if (state == COMPUTE_STOP) {
+		CLogger::mainlog->info("ScheduleAlgorithmSimulatedAnnealing: stopped at temperature %e, using best schedule so far", temperature);
+	}
+
+	if (state != COMPUTE_ABORT) {
 		// add task to machine queue
 		for (int mix=0; mix<machines; mix++) {
 			for (int rix=0; rix<bestSolution->num[mix]; rix++) {
@@ -554,7 +564,7 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 				}
 
 				CTaskCopy* task =  &((*pTasks)[tix]);
-				STaskEntry* entry = new STaskEntry();
+				STaskEntry* entry = sched->newEntry();
 				entry->taskcopy = task;
 				entry->taskid = entry->taskcopy->mId;
 				
@@ -583,7 +593,6 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 
 	// clean up
 	delete[] height_sets;
-	delete[] height;
 /*
 	for (int pix=0; pix<pop_num; pix++) {
 		delete pop->back();
@@ -607,3 +616,10 @@ CSchedule* CScheduleAlgorithmSimulatedAnnealingMig::compute(std::vector<CTaskCop
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterSimulatedAnnealingMig("SimulatedAnnealingMig", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmSimulatedAnnealingMig(rResources, CScheduleAlgorithmGeneticMig::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
+});
+static CScheduleAlgorithmRegistrar sRegisterSimulatedAnnealingEnergyMig("SimulatedAnnealingEnergyMig", [](std::vector<CResource*>& rResources) -> CScheduleAlgorithm* {
+	return new CScheduleAlgorithmSimulatedAnnealingMig(rResources, CScheduleAlgorithmGeneticMig::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
+});
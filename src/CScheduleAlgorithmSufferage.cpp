@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmSufferage.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CLogger.h"
 using namespace sched::algorithm;
@@ -39,6 +41,7 @@ CSchedule* CScheduleAlgorithmSufferage::compute(std::vector<CTaskCopy>* pTasks,
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	if (machines < 2) {
 		CLogger::mainlog->error("Sufferage: less than 2 resources !!!");
@@ -48,17 +51,17 @@ CSchedule* CScheduleAlgorithmSufferage::compute(std::vector<CTaskCopy>* pTasks,
 	sched->mpOTasks = pTasks;
 
 	// completion time matrix
-	double* C = new double[tasks * machines]();
+	double* C = sched->mArena.createArray<double>(tasks * machines);
 	// list of unmapped tasks
 	// 0 -> unmapped
 	// 1 -> mapped
-	int* activeTasks = new int[tasks]();
+	int* activeTasks = sched->mArena.createArray<int>(tasks);
 	// machine ready times
-	double* R = new double[machines]();
+	double* R = sched->mArena.createArray<double>(machines);
 	// array for chosen machine in first pass
 	//int* chosenMachine = new int[tasks];
-	int* activeMachines = new int[machines]();
-	double* sufferage = new double[machines]();
+	int* activeMachines = sched->mArena.createArray<int>(machines);
+	double* sufferage = sched->mArena.createArray<double>(machines);
 
 	int dep[tasks];
 	double depReady[tasks];
@@ -104,9 +107,9 @@ CSchedule* CScheduleAlgorithmSufferage::compute(std::vector<CTaskCopy>* pTasks,
 			// fini time
 			double complete = 
 				R[mix] +
-				mpEstimation->taskTimeInit(task, res) +
-				mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-				mpEstimation->taskTimeFini(task, res);
+				matrix->taskTimeInit(tix, mix) +
+				matrix->taskTimeCompute(tix, mix) + 
+				matrix->taskTimeFini(tix, mix);
 			C[tix*machines + mix] = complete;
 		}
 	}
@@ -176,8 +179,6 @@ CSchedule* CScheduleAlgorithmSufferage::compute(std::vector<CTaskCopy>* pTasks,
 		// assign tasks for all marked machines
 		for (int mix = 0; mix < machines; mix++) {
 
-			CResource* res = mrResources[mix];
-
 			if (activeMachines[mix] == -1) {
 				continue;
 			}
@@ -187,7 +188,7 @@ CSchedule* CScheduleAlgorithmSufferage::compute(std::vector<CTaskCopy>* pTasks,
 			CLogger::mainlog->debug("Sufferage: tix %d tid %d mix %d", tix, mapped_task->mId, mix);
 
 			// add task to machine queue
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = &((*pTasks)[tix]);
 			entry->taskid = entry->taskcopy->mId;
 			entry->stopProgress = entry->taskcopy->mCheckpoints;
@@ -248,9 +249,9 @@ CSchedule* CScheduleAlgorithmSufferage::compute(std::vector<CTaskCopy>* pTasks,
 								// fini time
 								double complete = 
 									ready +
-									mpEstimation->taskTimeInit(task, res) +
-									mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-									mpEstimation->taskTimeFini(task, res);
+									matrix->taskTimeInit(tix, mix) +
+									matrix->taskTimeCompute(tix, mix) + 
+									matrix->taskTimeFini(tix, mix);
 								C[tix*machines + mix] = complete;
 							}
 
@@ -264,9 +265,9 @@ CSchedule* CScheduleAlgorithmSufferage::compute(std::vector<CTaskCopy>* pTasks,
 					double ready = (depReady[tix] > resourceReady ? depReady[tix] : resourceReady);
 					double complete = 
 						ready +
-						mpEstimation->taskTimeInit(task, res) +
-						mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints) + 
-						mpEstimation->taskTimeFini(task, res);
+						matrix->taskTimeInit(tix, mix) +
+						matrix->taskTimeCompute(tix, mix) + 
+						matrix->taskTimeFini(tix, mix);
 					C[tix*machines + mix] = complete;
 
 				}
@@ -279,12 +280,7 @@ CSchedule* CScheduleAlgorithmSufferage::compute(std::vector<CTaskCopy>* pTasks,
 	sched->mActiveTasks = tasks;
 	sched->computeTimes();
 
-	// clean up
-	delete[] C;
-	delete[] activeTasks;
-	delete[] R;
-	delete[] activeMachines;
-	delete[] sufferage;
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterSufferage("Sufferage", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmSufferage>);
@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmSufferageMig2.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CLogger.h"
@@ -41,6 +43,7 @@ CSchedule* CScheduleAlgorithmSufferageMig2::compute(std::vector<CTaskCopy>* pTas
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	if (machines < 2) {
 		CLogger::mainlog->error("Sufferage: less than 2 resources !!!");
@@ -55,6 +58,12 @@ CSchedule* CScheduleAlgorithmSufferageMig2::compute(std::vector<CTaskCopy>* pTas
 
 	while (unmappedTasks > 0) {
 
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("Sufferage: stopped with %d tasks left, completing schedule by MCT", unmappedTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, false);
+			break;
+		}
+
 		// reset best option
 		min_suff_mig.parts[0].mix = -1;
 
@@ -182,9 +191,9 @@ CSchedule* CScheduleAlgorithmSufferageMig2::compute(std::vector<CTaskCopy>* pTas
 					CLogger::mainlog->debug("Sufferage ready mix %d mixtasks %d tix %d ready %lf",
 						mix, sched->resourceTasks(mix),
 						tix, ready);
-				double init = mpEstimation->taskTimeInit(task, res);
-				double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-				double fini = mpEstimation->taskTimeFini(task, res);
+				double init = matrix->taskTimeInit(tix, mix);
+				double compute = matrix->taskTimeCompute(tix, mix);
+				double fini = matrix->taskTimeFini(tix, mix);
 				double complete = ready + init + compute + fini;
 
 				if (min_ct_mig.parts[0].mix == -1 || min_ct_mig.complete > complete) {
@@ -219,7 +228,7 @@ CSchedule* CScheduleAlgorithmSufferageMig2::compute(std::vector<CTaskCopy>* pTas
 
 
 		CTaskCopy* task = &((*pTasks)[min_suff_mig.tix]);
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = min_suff_mig.parts[0].startProgress;
@@ -234,7 +243,7 @@ CSchedule* CScheduleAlgorithmSufferageMig2::compute(std::vector<CTaskCopy>* pTas
 		if (min_suff_mig.parts[1].mix != -1) {
 
 			CTaskCopy* task = &((*pTasks)[min_suff_mig.tix]);
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_suff_mig.parts[1].startProgress;
@@ -256,7 +265,7 @@ CSchedule* CScheduleAlgorithmSufferageMig2::compute(std::vector<CTaskCopy>* pTas
 
 	sched->computeTimes();
 
-	// clean up
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterSufferageMig2("SufferageMig2", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmSufferageMig2>);
@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmSufferageMig2Dyn.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
+#include "CEstimationMatrix.h"
 #include "CSchedule.h"
 #include "CScheduleExt.h"
 #include "CResource.h"
@@ -42,6 +44,7 @@ CSchedule* CScheduleAlgorithmSufferageMig2Dyn::compute(std::vector<CTaskCopy>* p
 
 	int tasks = pTasks->size();
 	int machines = mrResources.size();
+	CEstimationMatrix* matrix = getEstimationMatrix(pTasks);
 
 	if (machines < 2) {
 		CLogger::mainlog->error("Sufferage: less than 2 resources !!!");
@@ -57,6 +60,12 @@ CSchedule* CScheduleAlgorithmSufferageMig2Dyn::compute(std::vector<CTaskCopy>* p
 
 	while (unmappedTasks > 0) {
 
+		if (computeState(interrupt) == COMPUTE_STOP) {
+			CLogger::mainlog->info("Sufferage: stopped with %d tasks left, completing schedule by MCT", unmappedTasks);
+			completeMCT(sched, pTasks, matrix, mpEstimation, true);
+			break;
+		}
+
 		// reset best option
 		min_suff_mig.parts[0].mix = -1;
 
@@ -186,7 +195,7 @@ CSchedule* CScheduleAlgorithmSufferageMig2Dyn::compute(std::vector<CTaskCopy>* p
 					CLogger::mainlog->debug("Sufferage ready mix %d mixtasks %d tix %d ready %lf",
 						mix, sched->resourceTasks(mix),
 						tix, ready);
-				double init = mpEstimation->taskTimeInit(task, res);
+				double init = matrix->taskTimeInit(tix, mix);
 				if (sched->taskRunningResource(tix) == mix &&
 					sched->resourceTasks(mix) == 0) {
 					// task already running on resource and
@@ -194,8 +203,8 @@ CSchedule* CScheduleAlgorithmSufferageMig2Dyn::compute(std::vector<CTaskCopy>* p
 					init = 0.0;
 				}
 
-				double compute = mpEstimation->taskTimeCompute(task, res, task->mProgress, task->mCheckpoints);
-				double fini = mpEstimation->taskTimeFini(task, res);
+				double compute = matrix->taskTimeCompute(tix, mix);
+				double fini = matrix->taskTimeFini(tix, mix);
 				double complete = ready + init + compute + fini;
 
 				if (min_ct_mig.parts[0].mix == -1 || min_ct_mig.complete > complete) {
@@ -230,7 +239,7 @@ CSchedule* CScheduleAlgorithmSufferageMig2Dyn::compute(std::vector<CTaskCopy>* p
 
 
 		CTaskCopy* task = &((*pTasks)[min_suff_mig.tix]);
-		STaskEntry* entry = new STaskEntry();
+		STaskEntry* entry = sched->newEntry();
 		entry->taskcopy = task;
 		entry->taskid = entry->taskcopy->mId;
 		entry->startProgress = min_suff_mig.parts[0].startProgress;
@@ -245,7 +254,7 @@ CSchedule* CScheduleAlgorithmSufferageMig2Dyn::compute(std::vector<CTaskCopy>* p
 		if (min_suff_mig.parts[1].mix != -1) {
 
 			CTaskCopy* task = &((*pTasks)[min_suff_mig.tix]);
-			STaskEntry* entry = new STaskEntry();
+			STaskEntry* entry = sched->newEntry();
 			entry->taskcopy = task;
 			entry->taskid = entry->taskcopy->mId;
 			entry->startProgress = min_suff_mig.parts[1].startProgress;
@@ -267,7 +276,7 @@ CSchedule* CScheduleAlgorithmSufferageMig2Dyn::compute(std::vector<CTaskCopy>* p
 
 	sched->computeTimes();
 
-	// clean up
-
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterSufferageMig2Dyn("SufferageMig2Dyn", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmSufferageMig2Dyn>);
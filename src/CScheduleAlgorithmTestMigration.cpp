@@ -5,6 +5,7 @@
 #include <list>
 #include <algorithm>
 #include "CScheduleAlgorithmTestMigration.h"
+#include "CScheduleAlgorithmRegistry.h"
 #include "CTask.h"
 #include "CTaskCopy.h"
 #include "CEstimation.h"
@@ -53,14 +54,14 @@ CSchedule* CScheduleAlgorithmTestMigration::compute(std::vector<CTaskCopy>* pTas
 	CTaskCopy* task = &((*pTasks)[0]);
 
 	// add first part
-	STaskEntry* entry = new STaskEntry();
+	STaskEntry* entry = sched->newEntry();
 	entry->taskcopy = task;
 	entry->taskid = entry->taskcopy->mId;
 	entry->stopProgress = entry->taskcopy->mCheckpoints/2;
 	(*(sched->mpTasks))[0]->push_back(entry);
 
 	// add second part
-	entry = new STaskEntry();
+	entry = sched->newEntry();
 	entry->taskcopy = task;
 	entry->taskid = entry->taskcopy->mId;
 	entry->startProgress = entry->taskcopy->mCheckpoints/2;
@@ -71,3 +72,5 @@ CSchedule* CScheduleAlgorithmTestMigration::compute(std::vector<CTaskCopy>* pTas
 
 	return sched;
 }
+
+static CScheduleAlgorithmRegistrar sRegisterTestMigration("TestMigration", &CScheduleAlgorithmRegistrar::construct<CScheduleAlgorithmTestMigration>);
@@ -1,64 +1,19 @@
 // Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
 // SPDX-License-Identifier: BSD-2-Clause
 
+#include <algorithm>
 #include <signal.h>
 #include <unistd.h>
+#include <unordered_map>
 #include <sys/syscall.h>
 #include "CScheduleComputerMain.h"
 #include "CConfig.h"
 #include "CLogger.h"
-#include "CScheduleAlgorithmLinear.h"
-#include "CScheduleAlgorithmTestMigration.h"
-#include "CScheduleAlgorithmMinMin.h"
-#include "CScheduleAlgorithmMinMin2.h"
-#include "CScheduleAlgorithmMinMin2Dyn.h"
-#include "CScheduleAlgorithmMinMinMig.h"
-#include "CScheduleAlgorithmMinMinMig2.h"
-#include "CScheduleAlgorithmMinMinMig2Dyn.h"
-#include "CScheduleAlgorithmMaxMin.h"
-#include "CScheduleAlgorithmMaxMin2.h"
-#include "CScheduleAlgorithmMaxMin2Dyn.h"
-#include "CScheduleAlgorithmMaxMinMig2.h"
-#include "CScheduleAlgorithmMaxMinMig2Dyn.h"
-#include "CScheduleAlgorithmSufferage.h"
-#include "CScheduleAlgorithmSufferage2.h"
-#include "CScheduleAlgorithmSufferage2Dyn.h"
-#include "CScheduleAlgorithmSufferageMig2.h"
-#include "CScheduleAlgorithmSufferageMig2Dyn.h"
-#include "CScheduleAlgorithmHEFT.h"
-#include "CScheduleAlgorithmHEFT2.h"
-#include "CScheduleAlgorithmHEFT2Dyn.h"
-#include "CScheduleAlgorithmHEFTMig2.h"
-#include "CScheduleAlgorithmHEFTMig2Dyn.h"
-#include "CScheduleAlgorithmGenetic.h"
-#include "CScheduleAlgorithmGeneticDyn.h"
-#include "CScheduleAlgorithmGeneticMig.h"
-#include "CScheduleAlgorithmGeneticMigDyn.h"
-#include "CScheduleAlgorithmMCT.h"
-#include "CScheduleAlgorithmMCT2.h"
-#include "CScheduleAlgorithmMCTMig.h"
-#include "CScheduleAlgorithmMCTMig2.h"
-#include "CScheduleAlgorithmMET.h"
-#include "CScheduleAlgorithmMET2.h"
-#include "CScheduleAlgorithmMETMig2.h"
-#include "CScheduleAlgorithmOLB.h"
-#include "CScheduleAlgorithmOLB2.h"
-#include "CScheduleAlgorithmOLBMig2.h"
-#include "CScheduleAlgorithmSA.h"
-#include "CScheduleAlgorithmSA2.h"
-#include "CScheduleAlgorithmSAMig2.h"
-#include "CScheduleAlgorithmKPB.h"
-#include "CScheduleAlgorithmKPB2.h"
-#include "CScheduleAlgorithmKPBMig2.h"
-#include "CScheduleAlgorithmReMinMin.h"
-#include "CScheduleAlgorithmReMinMin2.h"
-#include "CScheduleAlgorithmReMinMin2Dyn.h"
-#include "CScheduleAlgorithmReMinMinMig2.h"
-#include "CScheduleAlgorithmReMinMinMig2Dyn.h"
-#include "CScheduleAlgorithmSimulatedAnnealing.h"
-#include "CScheduleAlgorithmSimulatedAnnealingDyn.h"
-#include "CScheduleAlgorithmSimulatedAnnealingMig.h"
-#include "CScheduleAlgorithmSimulatedAnnealingMigDyn.h"
+#include "CThreadPool.h"
+#include "CScheduleAlgorithmPortfolio.h"
+#include "CScheduleAlgorithmRegistry.h"
+#include "CEstimationMatrix.h"
+#include "CEstimationFeedback.h"
 #include "CTaskDatabase.h"
 #include "CFeedback.h"
 #include "CSchedule.h"
@@ -71,58 +26,9 @@ using sched::task::CTaskWrapper;
 using sched::task::CTaskCopy;
 using sched::task::CResource;
 
-using sched::algorithm::CScheduleAlgorithmLinear;
-using sched::algorithm::CScheduleAlgorithmTestMigration;
-using sched::algorithm::CScheduleAlgorithmMinMin;
-using sched::algorithm::CScheduleAlgorithmMinMin2;
-using sched::algorithm::CScheduleAlgorithmMinMin2Dyn;
-using sched::algorithm::CScheduleAlgorithmMinMinMig;
-using sched::algorithm::CScheduleAlgorithmMinMinMig2;
-using sched::algorithm::CScheduleAlgorithmMinMinMig2Dyn;
-using sched::algorithm::CScheduleAlgorithmMaxMin;
-using sched::algorithm::CScheduleAlgorithmMaxMin2;
-using sched::algorithm::CScheduleAlgorithmMaxMin2Dyn;
-using sched::algorithm::CScheduleAlgorithmMaxMinMig2;
-using sched::algorithm::CScheduleAlgorithmMaxMinMig2Dyn;
-using sched::algorithm::CScheduleAlgorithmSufferage;
-using sched::algorithm::CScheduleAlgorithmSufferage2;
-using sched::algorithm::CScheduleAlgorithmSufferage2Dyn;
-using sched::algorithm::CScheduleAlgorithmSufferageMig2;
-using sched::algorithm::CScheduleAlgorithmSufferageMig2Dyn;
-using sched::algorithm::CScheduleAlgorithmHEFT;
-using sched::algorithm::CScheduleAlgorithmHEFT2;
-using sched::algorithm::CScheduleAlgorithmHEFT2Dyn;
-using sched::algorithm::CScheduleAlgorithmHEFTMig2;
-using sched::algorithm::CScheduleAlgorithmHEFTMig2Dyn;
-using sched::algorithm::CScheduleAlgorithmGenetic;
-using sched::algorithm::CScheduleAlgorithmGeneticDyn;
-using sched::algorithm::CScheduleAlgorithmGeneticMig;
-using sched::algorithm::CScheduleAlgorithmGeneticMigDyn;
-using sched::algorithm::CScheduleAlgorithmMCT;
-using sched::algorithm::CScheduleAlgorithmMCT2;
-using sched::algorithm::CScheduleAlgorithmMCTMig;
-using sched::algorithm::CScheduleAlgorithmMCTMig2;
-using sched::algorithm::CScheduleAlgorithmMET;
-using sched::algorithm::CScheduleAlgorithmMET2;
-using sched::algorithm::CScheduleAlgorithmMETMig2;
-using sched::algorithm::CScheduleAlgorithmOLB;
-using sched::algorithm::CScheduleAlgorithmOLB2;
-using sched::algorithm::CScheduleAlgorithmOLBMig2;
-using sched::algorithm::CScheduleAlgorithmSA;
-using sched::algorithm::CScheduleAlgorithmSA2;
-using sched::algorithm::CScheduleAlgorithmSAMig2;
-using sched::algorithm::CScheduleAlgorithmKPB;
-using sched::algorithm::CScheduleAlgorithmKPB2;
-using sched::algorithm::CScheduleAlgorithmKPBMig2;
-using sched::algorithm::CScheduleAlgorithmReMinMin;
-using sched::algorithm::CScheduleAlgorithmReMinMin2;
-using sched::algorithm::CScheduleAlgorithmReMinMin2Dyn;
-using sched::algorithm::CScheduleAlgorithmReMinMinMig2;
-using sched::algorithm::CScheduleAlgorithmReMinMinMig2Dyn;
-using sched::algorithm::CScheduleAlgorithmSimulatedAnnealing;
-using sched::algorithm::CScheduleAlgorithmSimulatedAnnealingDyn;
-using sched::algorithm::CScheduleAlgorithmSimulatedAnnealingMig;
-using sched::algorithm::CScheduleAlgorithmSimulatedAnnealingMigDyn;
+using sched::algorithm::CScheduleAlgorithmPortfolio;
+using sched::algorithm::CScheduleAlgorithmRegistry;
+using sched::algorithm::CEstimationFeedback;
 
 CScheduleComputerMain::CScheduleComputerMain(std::vector<CResource*>& rResources, CFeedback& rFeedback, CTaskDatabase& rTaskDatabase):
 	mrResources(rResources),
@@ -182,6 +88,41 @@ CScheduleComputerMain::CScheduleComputerMain(std::vector<CResource*>& rResources
 		CLogger::mainlog->info("ScheduleComputer: wait for %ld applications before computing schedule", appCount);
 		mRequiredApplicationCount = appCount;
 	}
+
+	uint64_t threads = 0;
+	res = config->conf->getUint64((char*)"computer_threads", &threads);
+	if (-1 == res) {
+		CLogger::mainlog->info("ScheduleComputer: config key \"computer_threads\" not found, using default: 0");
+		threads = 0;
+	}
+	if (threads == 0) {
+		// one thread per core
+		threads = std::thread::hardware_concurrency();
+	}
+	mThreads = threads > 0 ? threads : 1;
+	CLogger::mainlog->info("ScheduleComputer: %u threads for algorithms", mThreads);
+
+	uint64_t deadline = 0;
+	res = config->conf->getUint64((char*)"compute_deadline_ms", &deadline);
+	if (-1 == res) {
+		CLogger::mainlog->info("ScheduleComputer: config key \"compute_deadline_ms\" not found, using default: 0");
+		deadline = 0;
+	}
+	mDeadlineMs = deadline;
+	if (mDeadlineMs > 0) {
+		CLogger::mainlog->info("ScheduleComputer: anytime mode, time budget %lu ms per schedule computation", mDeadlineMs);
+	}
+
+	bool speculative = false;
+	res = config->conf->getBool((char*)"computer_speculative", &speculative);
+	if (-1 == res) {
+		CLogger::mainlog->info("ScheduleComputer: config key \"computer_speculative\" not found, using default: false");
+		speculative = false;
+	}
+	mSpeculative = speculative;
+	if (mSpeculative == true) {
+		CLogger::mainlog->info("ScheduleComputer: speculative mode, next schedule is computed ahead");
+	}
 }
 
 int CScheduleComputerMain::loadAlgorithm(){
@@ -198,189 +139,56 @@ int CScheduleComputerMain::loadAlgorithm(){
 		scheduler = scheduler_str->c_str();
 	}
 	
+	// Load plugins with additional algorithms
+	CScheduleAlgorithmRegistry* registry = CScheduleAlgorithmRegistry::getRegistry();
+	std::vector<CConf*>* plugin_list = 0;
+	res = config->conf->getList((char*)"scheduler_plugins", &plugin_list);
+	if (0 == res) {
+		for (unsigned int i=0; i<plugin_list->size(); i++) {
+			CConf* entry = (*plugin_list)[i];
+			if (entry->mType != EConfType::String) {
+				CLogger::mainlog->error("ScheduleComputer: entry in \"scheduler_plugins\" is no path");
+				return -1;
+			}
+			if (registry->loadPlugin(entry->mData.mpString->c_str()) == -1) {
+				return -1;
+			}
+		}
+	}
+
 	// Load scheduler
 	CScheduleAlgorithm* alg = 0;
-	if (strcmp("Linear",scheduler) == 0) {
-		alg = new CScheduleAlgorithmLinear(mrResources);
-	} else
-	if (strcmp("TestMigration",scheduler) == 0) {
-		alg = new CScheduleAlgorithmTestMigration(mrResources);
-	} else
-	if (strcmp("MinMin",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMinMin(mrResources);
-	} else
-	if (strcmp("MinMin2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMinMin2(mrResources);
-	} else
-	if (strcmp("MinMin2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMinMin2Dyn(mrResources);
-	} else
-	if (strcmp("MinMinMig",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMinMinMig(mrResources);
-	} else
-	if (strcmp("MinMinMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMinMinMig2(mrResources);
-	} else
-	if (strcmp("MinMinMig2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMinMinMig2Dyn(mrResources);
-	} else
-	if (strcmp("MaxMin",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMaxMin(mrResources);
-	} else
-	if (strcmp("MaxMin2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMaxMin2(mrResources);
-	} else
-	if (strcmp("MaxMin2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMaxMin2Dyn(mrResources);
-	} else
-	if (strcmp("MaxMinMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMaxMinMig2(mrResources);
-	} else
-	if (strcmp("MaxMinMig2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMaxMinMig2Dyn(mrResources);
-	} else
-	if (strcmp("Sufferage",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSufferage(mrResources);
-	} else
-	if (strcmp("Sufferage2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSufferage2(mrResources);
-	} else
-	if (strcmp("Sufferage2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSufferage2Dyn(mrResources);
-	} else
-	if (strcmp("SufferageMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSufferageMig2(mrResources);
-	} else
-	if (strcmp("SufferageMig2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSufferageMig2Dyn(mrResources);
-	} else
-	if (strcmp("HEFT",scheduler) == 0) {
-		alg = new CScheduleAlgorithmHEFT(mrResources);
-	} else
-	if (strcmp("HEFT2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmHEFT2(mrResources);
-	} else
-	if (strcmp("HEFT2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmHEFT2Dyn(mrResources);
-	} else
-	if (strcmp("HEFTMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmHEFTMig2(mrResources);
-	} else
-	if (strcmp("HEFTMig2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmHEFTMig2Dyn(mrResources);
-	} else
-	if (strcmp("Genetic",scheduler) == 0) {
-		alg = new CScheduleAlgorithmGenetic(mrResources, CScheduleAlgorithmGenetic::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
-	} else
-	if (strcmp("GeneticDyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmGeneticDyn(mrResources, CScheduleAlgorithmGeneticDyn::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
-	} else
-	if (strcmp("GeneticEnergy",scheduler) == 0) {
-		alg = new CScheduleAlgorithmGenetic(mrResources, CScheduleAlgorithmGenetic::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
-	} else
-	if (strcmp("GeneticEnergyDyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmGeneticDyn(mrResources, CScheduleAlgorithmGeneticDyn::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
-	} else
-	if (strcmp("GeneticMig",scheduler) == 0) {
-		alg = new CScheduleAlgorithmGeneticMig(mrResources, CScheduleAlgorithmGeneticMig::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
-	} else
-	if (strcmp("GeneticMigDyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmGeneticMigDyn(mrResources, CScheduleAlgorithmGeneticMigDyn::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
-	} else
-	if (strcmp("GeneticEnergyMig",scheduler) == 0) {
-		alg = new CScheduleAlgorithmGeneticMig(mrResources, CScheduleAlgorithmGeneticMig::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
-	} else
-	if (strcmp("GeneticEnergyMigDyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmGeneticMigDyn(mrResources, CScheduleAlgorithmGeneticMigDyn::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
-	} else
-	if (strcmp("MCT",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMCT(mrResources);
-	} else
-	if (strcmp("MCT2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMCT2(mrResources);
-	} else
-	if (strcmp("MCTMig",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMCTMig(mrResources);
-	} else
-	if (strcmp("MCTMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMCTMig2(mrResources);
-	} else
-	if (strcmp("MET",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMET(mrResources);
-	} else
-	if (strcmp("MET2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMET2(mrResources);
-	} else
-	if (strcmp("METMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmMETMig2(mrResources);
-	} else
-	if (strcmp("OLB",scheduler) == 0) {
-		alg = new CScheduleAlgorithmOLB(mrResources);
-	} else
-	if (strcmp("OLB2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmOLB2(mrResources);
-	} else
-	if (strcmp("OLBMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmOLBMig2(mrResources);
-	} else
-	if (strcmp("SA",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSA(mrResources);
-	} else
-	if (strcmp("SA2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSA2(mrResources);
-	} else
-	if (strcmp("SAMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSAMig2(mrResources);
-	} else
-	if (strcmp("KPB",scheduler) == 0) {
-		alg = new CScheduleAlgorithmKPB(mrResources);
-	} else
-	if (strcmp("KPB2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmKPB2(mrResources);
-	} else
-	if (strcmp("KPBMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmKPBMig2(mrResources);
-	} else
-	if (strcmp("ReMinMin",scheduler) == 0) {
-		alg = new CScheduleAlgorithmReMinMin(mrResources);
-	} else
-	if (strcmp("ReMinMin2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmReMinMin2(mrResources);
-	} else
-	if (strcmp("ReMinMin2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmReMinMin2Dyn(mrResources);
-	} else
-	if (strcmp("ReMinMinMig2",scheduler) == 0) {
-		alg = new CScheduleAlgorithmReMinMinMig2(mrResources);
-	} else
-	if (strcmp("ReMinMinMig2Dyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmReMinMinMig2Dyn(mrResources);
-	} else
-	if (strcmp("SimulatedAnnealing",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSimulatedAnnealing(mrResources, CScheduleAlgorithmGenetic::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
-	} else
-	if (strcmp("SimulatedAnnealingDyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSimulatedAnnealingDyn(mrResources, CScheduleAlgorithmGeneticDyn::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
-	} else
-	if (strcmp("SimulatedAnnealingMig",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSimulatedAnnealingMig(mrResources, CScheduleAlgorithmGeneticMig::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
-	} else
-	if (strcmp("SimulatedAnnealingMigDyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSimulatedAnnealingMigDyn(mrResources, CScheduleAlgorithmGeneticMigDyn::EGeneticFitnessType::GENETIC_FITNESS_MAKESPAN);
-	} else
-	if (strcmp("SimulatedAnnealingEnergy",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSimulatedAnnealing(mrResources, CScheduleAlgorithmGenetic::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
-	} else
-	if (strcmp("SimulatedAnnealingEnergyDyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSimulatedAnnealingDyn(mrResources, CScheduleAlgorithmGeneticDyn::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
-	} else
-	if (strcmp("SimulatedAnnealingEnergyMig",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSimulatedAnnealingMig(mrResources, CScheduleAlgorithmGeneticMig::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
-	} else
-	if (strcmp("SimulatedAnnealingEnergyMigDyn",scheduler) == 0) {
-		alg = new CScheduleAlgorithmSimulatedAnnealingMigDyn(mrResources, CScheduleAlgorithmGeneticMigDyn::EGeneticFitnessType::GENETIC_FITNESS_ENERGY);
+	std::vector<CConf*>* portfolio_list = 0;
+	res = config->conf->getList((char*)"scheduler_portfolio", &portfolio_list);
+	if (0 == res && portfolio_list->size() > 0) {
+		// race several algorithms
+		CScheduleAlgorithmPortfolio* portfolio = new CScheduleAlgorithmPortfolio(mrResources);
+		for (unsigned int i=0; i<portfolio_list->size(); i++) {
+			CConf* entry = (*portfolio_list)[i];
+			if (entry->mType != EConfType::String) {
+				CLogger::mainlog->error("ScheduleComputer: entry in \"scheduler_portfolio\" is no algorithm name");
+				delete portfolio;
+				return -1;
+			}
+			const char* name = entry->mData.mpString->c_str();
+			CScheduleAlgorithm* member = registry->create(name, mrResources);
+			if (member == 0) {
+				CLogger::mainlog->error("ScheduleComputer: unknown algorithm %s in \"scheduler_portfolio\"", name);
+				delete portfolio;
+				return -1;
+			}
+			if (member->reusesSchedule() == true) {
+				CLogger::mainlog->warn("ScheduleComputer: algorithm %s builds on its previous schedule, not usable in portfolio", name);
+				delete member;
+				continue;
+			}
+			portfolio->addMember(name, member);
+		}
+		alg = portfolio;
+		scheduler = "Portfolio";
+	} else {
+		alg = registry->create(scheduler, mrResources);
 	}
-
 	if (0 != alg) {
 		CLogger::mainlog->info("ScheduleComputer: found algorithm: %s", scheduler);
 		CLogger::eventlog->info("\"event\":\"ALGORITHM\",\"algorithm\":\"%s\"", scheduler);
@@ -389,11 +197,31 @@ int CScheduleComputerMain::loadAlgorithm(){
 			delete alg;
 			return -1;
 		}
+		mpEstimationMatrix = new CEstimationMatrix(mrResources);
+		alg->setEstimationMatrix(mpEstimationMatrix);
+		mpThreadPool = new CThreadPool(mThreads);
+		alg->setThreadPool(mpThreadPool);
+		alg->setDeadline(mDeadlineMs);
+		CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"compute_deadline_ms\",\"value\":%lu", mDeadlineMs);
+		if (mSpeculative == true && alg->reusesSchedule() == true) {
+			CLogger::mainlog->warn("ScheduleComputer: algorithm %s builds on its previous schedule, speculative mode disabled", scheduler);
+			mSpeculative = false;
+		}
+		CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"computer_speculative\",\"value\":%d", mSpeculative == true ? 1 : 0);
+		CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"computer_batch_window_ms\",\"value\":%lu", mBatchPolicy.windowMs());
+		CLogger::eventlog->info("\"event\":\"ALGORITHM_PARAM\",\"name\":\"computer_batch_max_pending\",\"value\":%u", mBatchPolicy.maxPending());
 		mpAlgorithm = alg;
 		return 0;
 	}
 	
 	CLogger::mainlog->error("ScheduleComputer: no valid algorithm found in config");
+	std::vector<std::string> names;
+	registry->getNames(names);
+	std::string list;
+	for (unsigned int i=0; i<names.size(); i++) {
+		list += (i == 0 ? "" : " ") + names[i];
+	}
+	CLogger::mainlog->error("ScheduleComputer: available algorithms: %s", list.c_str());
 	return -1;
 }
 
@@ -404,6 +232,22 @@ CScheduleComputerMain::~CScheduleComputerMain(){
 		delete mpAlgorithm;
 		mpAlgorithm = 0;
 	}
+	if (mpEstimationMatrix != 0) {
+		delete mpEstimationMatrix;
+		mpEstimationMatrix = 0;
+	}
+	if (mpThreadPool != 0) {
+		delete mpThreadPool;
+		mpThreadPool = 0;
+	}
+	if (mpSpeculativeSchedule != 0) {
+		delete mpSpeculativeSchedule;
+		mpSpeculativeSchedule = 0;
+	}
+	if (mpProjectedTasks != 0) {
+		delete mpProjectedTasks;
+		mpProjectedTasks = 0;
+	}
 
 }
 
@@ -414,6 +258,9 @@ void CScheduleComputerMain::computeSchedule(){
 		mMessage = mMessage | ComputerMessage::UPDATE;
 		mAlgorithmInterrupt = 1;
 		CLogger::eventlog->info("\"event\":\"COMPUTER_UPDATE\"");
+		if (mBatching == true && mBatchPolicy.enabled() == true) {
+			mBatchPolicy.arrival(std::chrono::steady_clock::now());
+		}
 
 		// do required number of applications check
 		// do check here instead in the message loop to avoid race condition that leads to double schedule computation
@@ -518,6 +365,13 @@ void CScheduleComputerMain::compute(){
 					break;
 				}
 
+				// coalesce update requests
+				if (mBatching == true && mBatchPolicy.enabled() == true) {
+					if (waitForBatch() == 1) {
+						break;
+					}
+				}
+
 				// mode
 				if (mExecutorInterrupt == EExecutorInterrupt::GETPROGRESS) {
 					// getprogress: get progress of current tasks
@@ -543,6 +397,11 @@ void CScheduleComputerMain::compute(){
 
 			}
 
+			// compute the next schedule ahead until the next update
+			if (ret == 1 && mSpeculative == true) {
+				speculate();
+			}
+
 		}
 
 	}
@@ -587,6 +446,8 @@ int CScheduleComputerMain::computeAlgorithm(){
 
 	// compute new schedule
 	mAlgorithmInterrupt = 0;
+	// observations since the last computation correct the estimations, the factors stay fixed until the next computation
+	CEstimationFeedback::applyObservations();
 	// copy tasks
 	std::vector<CTaskCopy>* unfinishedTasks = mrTaskDatabase.copyUnfinishedTasks();
 
@@ -613,8 +474,34 @@ int CScheduleComputerMain::computeAlgorithm(){
 		}
 	}
 
-	// execute algorithm
-	newSchedule = mpAlgorithm->compute(unfinishedTasks, &runningTasks, &mAlgorithmInterrupt, mTaskUpdate);
+	// tasks projected as finished that still run are continued by patch(),
+	// a task that waits instead has no place in the schedule computed ahead
+	if (mpSpeculativeSchedule != 0) {
+		for (unsigned int tix=0; tix<unfinishedTasks->size(); tix++) {
+			CTaskCopy* task = &((*unfinishedTasks)[tix]);
+			if (std::find(mProjectedFinished.begin(), mProjectedFinished.end(), task->mId) != mProjectedFinished.end() &&
+				std::find(runningTasks.begin(), runningTasks.end(), task) == runningTasks.end()) {
+				CLogger::mainlog->info("ScheduleComputer: task %d projected as finished is not running, speculative schedule discarded", task->mId);
+				delete mpSpeculativeSchedule;
+				mpSpeculativeSchedule = 0;
+				break;
+			}
+		}
+	}
+
+	bool patched = false;
+	if (mpSpeculativeSchedule != 0) {
+		// adapt the schedule computed ahead to the actual tasks
+		patched = true;
+		newSchedule = mpAlgorithm->patch(mpSpeculativeSchedule, unfinishedTasks, &runningTasks, mTaskUpdate);
+		delete mpSpeculativeSchedule;
+		mpSpeculativeSchedule = 0;
+		CLogger::mainlog->info("ScheduleAlgorithm: patched speculative schedule");
+	} else {
+		// execute algorithm
+		mpAlgorithm->startDeadline(mAlgorithmStart);
+		newSchedule = mpAlgorithm->compute(unfinishedTasks, &runningTasks, &mAlgorithmInterrupt, mTaskUpdate);
+	}
 
 	if (newSchedule == 0) {
 		CLogger::mainlog->debug("ScheduleComputer: algorithm interrupted");
@@ -630,6 +517,11 @@ int CScheduleComputerMain::computeAlgorithm(){
 	newSchedule->mComputeStart = mAlgorithmStart;
 	newSchedule->mComputeStop = mAlgorithmStop;
 	newSchedule->mComputeDuration = mAlgorithmDuration;
+	if (patched == false) {
+		// patching is no algorithm run, its duration does not predict the next one
+		std::lock_guard<std::mutex> lg(mMessageMutex);
+		mBatchPolicy.observe(mAlgorithmDuration);
+	}
 
 
 	CLogger::mainlog->info("ScheduleAlgorithm: duration %f s, %d tasks", nseconds, newSchedule->mActiveTasks);
@@ -641,11 +533,184 @@ int CScheduleComputerMain::computeAlgorithm(){
 	std::ostringstream scheduleJson;
 	newSchedule->printJson(scheduleJson);
 	CLogger::eventlog->infoStream() << "\"event\":\"SCHEDULE\",\"schedule\":" << scheduleJson.str();
+	if (mSpeculative == true) {
+		// the executor owns the schedule after the update
+		project(newSchedule, newSchedule->mpOTasks);
+	}
 	mpScheduleExecutor->updateSchedule(newSchedule);
 	newSchedule = 0;
 	return 1;
 }
 
+void CScheduleComputerMain::project(CSchedule* pSchedule, std::vector<CTaskCopy>* pTasks){
+
+	if (mpProjectedTasks != 0) {
+		delete mpProjectedTasks;
+		mpProjectedTasks = 0;
+	}
+	mProjectedRunning.assign(mrResources.size(), -1);
+	mProjectedFinished.clear();
+
+	// first task completion
+	bool found = false;
+	std::chrono::steady_clock::duration projected = {};
+	for (int mix=0; mix<pSchedule->mResourceNum; mix++) {
+		std::vector<STaskEntry*>* queue = (*(pSchedule->mpTasks))[mix];
+		for (unsigned int qix=0; qix<queue->size(); qix++) {
+			STaskEntry* entry = (*queue)[qix];
+			if (entry->stopProgress == entry->taskcopy->mCheckpoints &&
+				(found == false || entry->timeFinish < projected)) {
+				projected = entry->timeFinish;
+				found = true;
+			}
+		}
+	}
+	if (found == false) {
+		return;
+	}
+
+	// expected progress at the projected time
+	std::unordered_map<int,unsigned int> progress;
+	std::unordered_map<int,bool> finished;
+	for (int mix=0; mix<pSchedule->mResourceNum; mix++) {
+		std::vector<STaskEntry*>* queue = (*(pSchedule->mpTasks))[mix];
+		for (unsigned int qix=0; qix<queue->size(); qix++) {
+			STaskEntry* entry = (*queue)[qix];
+			if (entry->timeReady > projected) {
+				break;
+			}
+			unsigned int entryProgress = entry->startProgress;
+			if (entry->timeFinish <= projected) {
+				// part done
+				entryProgress = entry->stopProgress;
+				if (entry->stopProgress == entry->taskcopy->mCheckpoints) {
+					finished[entry->taskid] = true;
+				}
+			} else {
+				// part running
+				mProjectedRunning[mix] = entry->taskid;
+				std::chrono::steady_clock::duration computed = projected - entry->timeReady - entry->durInit;
+				if (computed.count() > 0 && entry->durCompute.count() > 0) {
+					double ratio = (double) computed.count() / entry->durCompute.count();
+					if (ratio > 1.0) {
+						ratio = 1.0;
+					}
+					entryProgress += (unsigned int) ((entry->stopProgress - entry->startProgress) * ratio);
+				}
+			}
+			if (progress.count(entry->taskid) == 0 || progress[entry->taskid] < entryProgress) {
+				progress[entry->taskid] = entryProgress;
+			}
+		}
+	}
+
+	mpProjectedTasks = new std::vector<CTaskCopy>();
+	mpProjectedTasks->reserve(pTasks->size());
+	for (unsigned int tix=0; tix<pTasks->size(); tix++) {
+		CTaskCopy& task = (*pTasks)[tix];
+		if (finished.count(task.mId) > 0) {
+			mProjectedFinished.push_back(task.mId);
+			continue;
+		}
+		mpProjectedTasks->push_back(task);
+		std::unordered_map<int,unsigned int>::const_iterator it = progress.find(task.mId);
+		if (it != progress.end() && it->second > task.mProgress) {
+			mpProjectedTasks->back().mProgress = it->second;
+		}
+	}
+	CLogger::mainlog->debug("ScheduleComputer: projected %lu of %lu tasks to %f s", mpProjectedTasks->size(), pTasks->size(), projected.count() / 1000000000.0);
+
+}
+
+void CScheduleComputerMain::speculate(){
+
+	if (mpProjectedTasks == 0) {
+		return;
+	}
+	std::vector<CTaskCopy>* projectedTasks = mpProjectedTasks;
+	mpProjectedTasks = 0;
+	{
+		std::lock_guard<std::mutex> lg(mMessageMutex);
+		if (mMessage != 0) {
+			// update already pending, projection is outdated
+			delete projectedTasks;
+			return;
+		}
+		mAlgorithmInterrupt = 0;
+	}
+
+	// projected running tasks
+	std::vector<CTaskCopy*> runningTasks;
+	for (unsigned int mix=0; mix<mrResources.size(); mix++) {
+		CTaskCopy* realtask = 0;
+		for (unsigned int tix=0; tix<projectedTasks->size() && mProjectedRunning[mix] != -1; tix++) {
+			if ((*projectedTasks)[tix].mId == mProjectedRunning[mix]) {
+				realtask = &((*projectedTasks)[tix]);
+				break;
+			}
+		}
+		runningTasks.push_back(realtask);
+	}
+
+	CEstimationFeedback::applyObservations();
+	CLogger::mainlog->info("ScheduleAlgorithm: start speculative schedule algorithm");
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	mpAlgorithm->startDeadline(start);
+	CSchedule* schedule = mpAlgorithm->compute(projectedTasks, &runningTasks, &mAlgorithmInterrupt, 1);
+	std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - start;
+	double nseconds = double(duration.count())
+		* std::chrono::steady_clock::period::num
+		/ std::chrono::steady_clock::period::den;
+
+	if (schedule == 0) {
+		CLogger::mainlog->debug("ScheduleComputer: speculative algorithm interrupted");
+		return;
+	}
+	if (mpSpeculativeSchedule != 0) {
+		delete mpSpeculativeSchedule;
+	}
+	mpSpeculativeSchedule = schedule;
+	CLogger::mainlog->info("ScheduleAlgorithm: speculative duration %f s, %d tasks", nseconds, schedule->mActiveTasks);
+	CLogger::eventlog->info("\"event\":\"COMPUTER_SPECULATIVE\",\"duration\":%f", nseconds);
+
+}
+
+
+int CScheduleComputerMain::waitForBatch(){
+
+	std::unique_lock<std::mutex> ul(mMessageMutex);
+	if (mBatchPolicy.pending() == 0) {
+		return 0;
+	}
+	std::chrono::steady_clock::time_point waitStart = std::chrono::steady_clock::now();
+	while (mStopThread == 0 && (mMessage & ComputerMessage::EXIT) == 0) {
+		std::chrono::steady_clock::time_point due = mBatchPolicy.due();
+		if (std::chrono::steady_clock::now() >= due) {
+			break;
+		}
+		mMessageCondVar.wait_until(ul, due);
+	}
+	if (mStopThread == 1 || (mMessage & ComputerMessage::EXIT) != 0) {
+		return 1;
+	}
+	// the following computation covers all requests up to now
+	mMessage = mMessage & ~ComputerMessage::UPDATE;
+	unsigned int arrivals = mBatchPolicy.pending();
+	mBatchPolicy.start();
+	std::chrono::duration<double> waited = std::chrono::steady_clock::now() - waitStart;
+	CLogger::eventlog->info("\"event\":\"COMPUTER_BATCH\",\"arrivals\":%u,\"wait\":%f,\"predicted\":%f", arrivals, waited.count(), mBatchPolicy.predicted());
+	return 0;
+
+}
+
+CBatchPolicy& CScheduleComputerMain::getBatchPolicy() {
+	return mBatchPolicy;
+}
+
+void CScheduleComputerMain::setBatching(bool batching) {
+	std::lock_guard<std::mutex> lg(mMessageMutex);
+	mBatching = batching;
+}
 
 int CScheduleComputerMain::getRequiredApplicationCount() {
 	return this->mRequiredApplicationCount;
@@ -9,15 +9,19 @@
 #include <chrono>
 #include <vector>
 #include "CScheduleComputer.h"
+#include "CBatchPolicy.h"
 namespace sched {
 namespace task {
 	class CTaskDatabase;
+	class CTaskCopy;
 } }
 
 
 namespace sched {
 namespace algorithm {
 	class CScheduleAlgorithm;
+	class CEstimationMatrix;
+	class CThreadPool;
 } }
 
 
@@ -25,8 +29,11 @@ namespace sched {
 namespace schedule {
 
 	using sched::task::CTaskDatabase;
+	using sched::task::CTaskCopy;
 
 	using sched::algorithm::CScheduleAlgorithm;
+	using sched::algorithm::CEstimationMatrix;
+	using sched::algorithm::CThreadPool;
 
 	class CSchedule;
 	class CScheduleExecutor;
@@ -73,6 +80,8 @@ namespace schedule {
 			int mAlgorithmInterrupt = 0; ///< Flag to interrupt algorithm computation
 			int mScheduleNum = 0; ///< Number of computed schedules
 			CScheduleAlgorithm* mpAlgorithm = 0;
+			CEstimationMatrix* mpEstimationMatrix = 0; ///< Estimations shared between schedule computations
+			CThreadPool* mpThreadPool = 0; ///< Threads for data-parallel loops of the algorithm
 			std::chrono::steady_clock::time_point mAlgorithmStart;
 			std::chrono::steady_clock::time_point mAlgorithmStop;
 			std::chrono::steady_clock::duration mAlgorithmDuration;
@@ -80,12 +89,38 @@ namespace schedule {
 			// configuration
 			int mRequiredApplicationCount = 0;
 			int mRegisteredApplications = 0;
+			unsigned int mThreads = 1; ///< Number of threads in the thread pool
+			unsigned long mDeadlineMs = 0; ///< Time budget per schedule computation in milliseconds, 0 if unlimited
+			bool mSpeculative = false; ///< Compute the next schedule ahead while the executor runs the current one
+			CBatchPolicy mBatchPolicy; ///< Coalesces update requests, guarded by mMessageMutex
+			bool mBatching = true; ///< Apply the batch policy in real time, the simulation models it itself
+
+			// speculative schedule
+			std::vector<CTaskCopy>* mpProjectedTasks = 0; ///< Tasks as expected at the next task completion of the current schedule
+			std::vector<int> mProjectedRunning; ///< Task id expected to run per resource at the projected time, -1 if idle
+			std::vector<int> mProjectedFinished; ///< Ids of tasks expected to be finished at the projected time
+			CSchedule* mpSpeculativeSchedule = 0; ///< Schedule computed for the projected tasks
 
 		private:
 			void compute();
 			int computeAlgorithm();
 			int suspendExecutor();
 
+			/// @brief Projects the tasks of a new schedule to its first task completion
+			/// Tasks finishing until then are removed, the progress of the other tasks is estimated from the entry times.
+			/// @param pSchedule New schedule
+			/// @param pTasks Task list of the schedule
+			void project(CSchedule* pSchedule, std::vector<CTaskCopy>* pTasks);
+
+			/// @brief Computes a schedule for the projected tasks
+			/// The computation is interrupted by the next schedule update.
+			void speculate();
+
+			/// @brief Waits until the computation for the pending update requests is due
+			/// Requests arriving during the wait are included in the following computation.
+			/// @return Returns 1 on shutdown, else 0
+			int waitForBatch();
+
 		public:
 			// object registration
 			void setScheduleExecutor(CScheduleExecutor* pScheduleExecutor);
@@ -98,6 +133,10 @@ namespace schedule {
 			int loadAlgorithm();
 			int getRequiredApplicationCount();
 			int getRegisteredApplications();
+			/// @brief Returns the batch policy, its runtime prediction is updated by every computed schedule
+			CBatchPolicy& getBatchPolicy();
+			/// @brief Enables or disables the batching of update requests by the computer thread
+			void setBatching(bool batching);
 			virtual ~CScheduleComputerMain();
 	};
 
@@ -45,8 +45,12 @@ CScheduleExecutorMain::CScheduleExecutorMain(std::vector<CResource*>& rResources
 
 CScheduleExecutorMain::~CScheduleExecutorMain(){
 
-	for (unsigned int i=0; i<mLastSchedules.size(); i++) {
-		delete mLastSchedules[i];
+	for (unsigned int i=0; i<mRetiredSchedules.size(); i++) {
+		delete mRetiredSchedules[i];
+	}
+	if (mpCurrentSchedule != 0) {
+		delete mpCurrentSchedule;
+		mpCurrentSchedule = 0;
 	}
 }
 
@@ -185,6 +189,7 @@ void CScheduleExecutorMain::execute(){
 			if (manageResources == 1) {
 				int activeResources = 0;
 				activeResources = this->manageResources();
+				reclaimSchedules();
 				if (mState == EScheduleState::INACTIVE && activeResources == 0) {
 					mpScheduleComputer->executorSuspended();
 					CLogger::eventlog->info("\"event\":\"EXECUTOR_SUSPENDED\"");
@@ -210,13 +215,55 @@ void CScheduleExecutorMain::execute(){
 
 void CScheduleExecutorMain::setupSchedule(CSchedule* pSchedule){
 	
-	mLastSchedules.push_back(pSchedule);
+	if (mpCurrentSchedule != 0) {
+		// resources may still run entries of the old schedule
+		mRetiredSchedules.push_back(mpCurrentSchedule);
+	}
 	mpCurrentSchedule = pSchedule;
 
 	CLogger::mainlog->debug("ScheduleExecutor: setup new schedule");
 	
 }
 
+void CScheduleExecutorMain::reclaimSchedules(){
+
+	if (mRetiredSchedules.size() == 0) {
+		return;
+	}
+
+	// collect entries in use
+	// only the executor thread assigns entries to resources,
+	// resources can only drop their entry in the meantime
+	std::vector<STaskEntry*> entries;
+	for (unsigned int resId = 0; resId<mrResources.size(); resId++) {
+		STaskEntry* entry = 0;
+		mrResources[resId]->getStatus(0, &entry, 0, 0);
+		if (entry != 0) {
+			entries.push_back(entry);
+		}
+	}
+
+	unsigned int kept = 0;
+	for (unsigned int six = 0; six<mRetiredSchedules.size(); six++) {
+		CSchedule* schedule = mRetiredSchedules[six];
+		bool used = false;
+		for (unsigned int eix = 0; eix<entries.size(); eix++) {
+			if (schedule->ownsEntry(entries[eix]) == true) {
+				used = true;
+				break;
+			}
+		}
+		if (used == true) {
+			mRetiredSchedules[kept++] = schedule;
+		} else {
+			CLogger::mainlog->debug("ScheduleExecutor: free retired schedule %d", schedule->mId);
+			delete schedule;
+		}
+	}
+	mRetiredSchedules.resize(kept);
+
+}
+
 int CScheduleExecutorMain::manageResources(){
 
 
@@ -53,7 +53,7 @@ namespace schedule {
 			unsigned int mMessage = 0;
 			CSchedule* mpNewSchedule = 0;
 			CSchedule* mpCurrentSchedule = 0;
-			std::vector<CSchedule*> mLastSchedules; ///< List of old schedules, saved because of dangling pointers
+			std::vector<CSchedule*> mRetiredSchedules; ///< Replaced schedules that may still be referenced by resources
 			EScheduleState mState = EScheduleState::ACTIVE;
 			std::mutex mLoopMutex;
 			std::condition_variable mLoopCondVar;
@@ -64,6 +64,12 @@ namespace schedule {
 			/// @brief Executor thread main function
 			void execute();
 			void setupSchedule(CSchedule* pSchedule);
+			/// @brief Frees retired schedules that are no longer referenced
+			/// Resources keep pointers to the entry of their current task and read the current schedule while holding their mutex.
+			/// Every retired schedule was replaced before the resources are checked here.
+			/// Taking each resource's mutex once therefore ensures that no resource still reads a retired schedule,
+			/// and the entry reported by the resource tells which retired schedule is still in use.
+			void reclaimSchedules();
 			/// @brief Compare schedule and resource state and react accordingly
 			/// @return Number of active resources
 			int manageResources();
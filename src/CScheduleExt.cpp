@@ -1,6 +1,7 @@
 // Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
 // SPDX-License-Identifier: BSD-2-Clause
 
+#include <algorithm>
 #include "CScheduleExt.h"
 #include "CTaskCopy.h"
 #include "CResource.h"
@@ -18,13 +19,18 @@ CScheduleExt::CScheduleExt(
 CSchedule(tasks, resources, rResources)
 {
 	mpOTasks = tasklist;
+	int num = mpOTasks->size();
+	mTaskExist.assign(num, false);
+	mTaskLastPart.assign(num, false);
+	mTaskDep.assign(num, false);
+	mTaskReady.assign(num, 0.0);
+	mTaskParts.assign(num, 0);
+	mTaskMap.reserve(num);
 	// fill maps
 	for (unsigned int ix=0; ix<mpOTasks->size(); ix++) {
 		CTaskCopy* task = &((*mpOTasks)[ix]);
 		int id = task->mId;
 		mTaskMap[id] = ix;
-		mTaskReady[id] = 0.0;
-		mTaskLastPart[id] = false;
 		int preNum = 0;
 		std::unordered_map<int,int>::const_iterator ix_it;
 		for (int pix = 0; pix<task->mPredecessorNum; pix++) {
@@ -36,12 +42,12 @@ CSchedule(tasks, resources, rResources)
 			}
 		}
 		if (preNum == 0) {
-			mTaskDep[id] = true;
-		} else {
-			mTaskDep[id] = false;
+			mTaskDep[ix] = true;
 		}
 	}
 	mActiveTasks = tasklist->size();
+	mQueueTimes.resize(resources);
+	mGapIndex.resize(resources);
 }
 
 
@@ -49,24 +55,66 @@ CScheduleExt::~CScheduleExt(){
 
 }
 
+int CScheduleExt::taskIndex(CTask* task) {
+
+	// copies from the task list are located by their address
+	CTaskCopy* first = mpOTasks->data();
+	const char* ptr = (const char*) task;
+	if (ptr >= (const char*) first && ptr < (const char*) (first + mpOTasks->size())) {
+		return static_cast<CTaskCopy*>(task) - first;
+	}
+	return taskIndexById(task->mId);
+
+}
+
+int CScheduleExt::taskIndexById(int taskid) {
+
+	std::unordered_map<int,int>::const_iterator it = mTaskMap.find(taskid);
+	if (it == mTaskMap.end()) {
+		return -1;
+	}
+	return it->second;
+
+}
+
 int CScheduleExt::resourceTasks(int mix) {
-	return (*mpTasks)[mix]->size();
+	return mQueueTimes[mix].ready.size();
+}
+
+void CScheduleExt::syncQueueTimes() {
+
+	for (int mix=0; mix<mResourceNum; mix++) {
+		std::vector<STaskEntry*>* queue = (*mpTasks)[mix];
+		SQueueTimes& times = mQueueTimes[mix];
+		times.ready.resize(queue->size());
+		times.finish.resize(queue->size());
+		times.taskid.resize(queue->size());
+		for (unsigned int qix=0; qix<queue->size(); qix++) {
+			STaskEntry* entry = (*queue)[qix];
+			times.ready[qix] = entry->timeReady.count() / 1000000000.0;
+			times.finish[qix] = entry->timeFinish.count() / 1000000000.0;
+			times.taskid[qix] = entry->taskid;
+		}
+		// rebuilt on demand
+		mGapIndex[mix].clear();
+	}
+
+}
+
+void CScheduleExt::computeTimes() {
+
+	CSchedule::computeTimes();
+	syncQueueTimes();
+
 }
 
 double CScheduleExt::taskReadyTimeResource(int tix, CResource* res, CEstimation* est) {
 
 	CTaskCopy* task = &((*mpOTasks)[tix]);
-	int taskid = task->mId;
 	double taskReady = taskReadyTime(tix); // max finish time of task predecessors
 	double taskFiniTime = est->taskTimeFini(task, res);
-	int taskRunningMix = -1;
 	// find out if task is already running
-	for (unsigned int mix=0; mix<mrResources.size(); mix++) {
-		if (mRunningTasks[mix] != 0 && mRunningTasks[mix]->mId == taskid) {
-			taskRunningMix = mix;
-			break;
-		}
-	}
+	int taskRunningMix = taskRunningResourceTid(task->mId);
 
 	double resLastTaskReady = resourceReadyTime(res); // last finish time in resource queue
 	// find out if resource has already running task
@@ -116,17 +164,8 @@ double CScheduleExt::taskReadyTimeResource(int tix, CResource* res, CEstimation*
 
 double CScheduleExt::taskCompletionTime(int tix, CResource* res, int slot, double ready, double init, double compute, double fini) {
 
-	CTaskCopy* task = &((*mpOTasks)[tix]);
-	int taskid = task->mId;
-	int runningMix = -1;
-
 	// find out if task is already running
-	for (unsigned int mix=0; mix<mrResources.size(); mix++) {
-		if (mRunningTasks[mix] != 0 && mRunningTasks[mix]->mId == taskid) {
-			runningMix = mix;
-			break;
-		}
-	}
+	int runningMix = taskRunningResource(tix);
 
 	if (runningMix == res->mId && slot == 0) {
 		// task continues running on resource it already runs on
@@ -142,6 +181,7 @@ void CScheduleExt::addEntry(STaskEntry* entry, CResource* res, int position) {
 	// get resource index
 	int mix = res->mId;
 	std::vector<STaskEntry*>* queue = (*mpTasks)[mix];
+	SQueueTimes& times = mQueueTimes[mix];
 
 	// compute times
 	computeExecutionTime(entry, res, position);
@@ -149,24 +189,12 @@ void CScheduleExt::addEntry(STaskEntry* entry, CResource* res, int position) {
 	double ready = 0.0;
 	// find previous part
 	// get local index
-	std::pair<
-		std::unordered_map<int,STaskEntry*>::iterator,
-		std::unordered_map<int,STaskEntry*>::iterator
-	> entry_range = mTaskParts.equal_range(entry->taskid);
+	int tix = taskIndex(entry->taskcopy);
 	STaskEntry* prevEntry = 0;
-	std::unordered_map<int,STaskEntry*>::iterator entry_it = entry_range.first;
-	while(entry_it != mTaskParts.end()) {
-		int pTaskid = (*entry_it).first;
-		// range contains pairs with different keys
-		if (pTaskid != entry->taskid) {
-			entry_it++;
-			continue;
-		}
-		STaskEntry* pEntry = (*entry_it).second;
+	for (STaskEntry* pEntry = mTaskParts[tix]; pEntry != 0; pEntry = pEntry->nextPart) {
 		if (pEntry->stopProgress == entry->startProgress) {
 			prevEntry = pEntry;
 		}
-		entry_it++;
 	}
 	// previous part found ?
 	if (prevEntry != 0) {
@@ -188,8 +216,7 @@ void CScheduleExt::addEntry(STaskEntry* entry, CResource* res, int position) {
 			resReady = 0.0;
 		} else
 		if ( (long) queue->size() > position-1) {
-			STaskEntry* preEntry = (*queue)[position-1];
-			resReady = preEntry->timeFinish.count() / 1000000000.0;
+			resReady = times.finish[position-1];
 		} else {
 			CLogger::mainlog->warn("ScheduleExt: addEntry invalid position %d for queue of length %d, max ok position: %d", position, queue->size(), queue->size());
 			resReady = resourceReadyTime(res);
@@ -201,7 +228,7 @@ void CScheduleExt::addEntry(STaskEntry* entry, CResource* res, int position) {
 	if (resReady > ready) {
 		ready = resReady;
 	}
-	double taskReady = taskReadyTime(entry->taskcopy);
+	double taskReady = mTaskReady[tix];
 	if (taskReady > ready) {
 		ready = taskReady;
 	}
@@ -211,62 +238,81 @@ void CScheduleExt::addEntry(STaskEntry* entry, CResource* res, int position) {
 	CLogger::mainlog->debug("ScheduleExt: entry ready %ld dur %ld finish %ld", entry->timeReady.count(), entry->durTotal.count(), entry->timeFinish.count());
 
 	// add to queue
+	double entryReady = entry->timeReady.count() / 1000000000.0;
+	double entryFinish = entry->timeFinish.count() / 1000000000.0;
 	if (position == -1) {
 		//position = queue->size();
 		queue->push_back(entry);
+		times.ready.push_back(entryReady);
+		times.finish.push_back(entryFinish);
+		times.taskid.push_back(entry->taskid);
 	} else {
 		std::vector<STaskEntry*>::iterator it = queue->begin()+position;
 		queue->insert(it, entry);
+		times.ready.insert(times.ready.begin()+position, entryReady);
+		times.finish.insert(times.finish.begin()+position, entryFinish);
+		times.taskid.insert(times.taskid.begin()+position, entry->taskid);
+	}
+	CGapIndex& index = mGapIndex[mix];
+	if (index.built() == true) {
+		int slot = (position == -1 ? times.ready.size() - 1 : position);
+		index.insert(slot, entryGap(times, slot));
+		if (slot + 1 < (int) times.ready.size()) {
+			// gap in front of the following entry shrinks
+			index.set(slot + 1, entryGap(times, slot + 1));
+		}
 	}
 
 	CLogger::mainlog->debug("ScheduleExt: new res ready time %d %lf", res->mId, resourceReadyTime(res));
 
 
 	// add to task exist map
-	mTaskExist[entry->taskid] = true;
+	mTaskExist[tix] = true;
 
 	// final part ?
 	if (entry->stopProgress == entry->taskcopy->mCheckpoints) {
-		mTaskLastPart[entry->taskid] = true;
+		mTaskLastPart[tix] = true;
 		CTaskCopy* task = entry->taskcopy;
-		double finish = entry->timeFinish.count() / 1000000000.0;
+		double finish = entryFinish;
 		// check satisfied dependencies
 		for (int six=0; six<task->mSuccessorNum; six++) {
 			int sid = task->mpSuccessorList[six];
 
 			// task in task set ?
-			if (mTaskMap.count(sid) == 0) {
+			int stix = taskIndexById(sid);
+			if (stix == -1) {
 				continue;
 			}
 
 			// update ready time
-			if (mTaskReady[sid] < finish) {
-				mTaskReady[sid] = finish;
+			if (mTaskReady[stix] < finish) {
+				mTaskReady[stix] = finish;
 			}
 
 			// check if successor task is dependency free now
-			CTaskCopy* stask = &((*mpOTasks)[mTaskMap[sid]]);
+			CTaskCopy* stask = &((*mpOTasks)[stix]);
 			bool free = true;
 			for (int pix = 0; pix<stask->mPredecessorNum; pix++) {
 				int pid = stask->mpPredecessorList[pix];			
-				if (mTaskMap.count(pid) == 0) {
+				int ptix = taskIndexById(pid);
+				if (ptix == -1) {
 					continue;
 				}
-				if (mTaskLastPart[pid] == false) {
+				if (mTaskLastPart[ptix] == false) {
 					free = false;
 					break;
 				}
 			}
 			if (free == true) {
 				CLogger::mainlog->debug("CScheduleExt: task %d dep freed", sid);
-				mTaskDep[sid] = true;
+				mTaskDep[stix] = true;
 			}
 		}
 	}
 
 	// add to part list
-	std::pair<int, STaskEntry*> partEntry(entry->taskid, entry);
-	mTaskParts.insert(partEntry);
+	entry->nextPart = mTaskParts[tix];
+	mTaskParts[tix] = entry;
 
 
 }
@@ -280,41 +326,53 @@ double CScheduleExt::resourceReadyTime(CResource* res) {
 
 double CScheduleExt::resourceReadyTime(int mix) {
 
-	std::vector<STaskEntry*>* queue = (*mpTasks)[mix];
-	if (queue->size() == 0) {
+	std::vector<double>& finish = mQueueTimes[mix].finish;
+	if (finish.size() == 0) {
 		return 0.0;
 	}
-	return (*queue)[queue->size()-1]->timeFinish.count() / 1000000000.0;
+	return finish.back();
 
 }
 
 
 double CScheduleExt::taskReadyTime(CTask* task) {
 
-	return mTaskReady[task->mId];
+	int tix = taskIndex(task);
+	if (tix == -1) {
+		return 0.0;
+	}
+	return mTaskReady[tix];
 }
 
 double CScheduleExt::taskReadyTime(int tix) {
-	return taskReadyTime(&((*mpOTasks)[tix]));
+	return mTaskReady[tix];
 }
 
 
 
 bool CScheduleExt::taskLastPartMapped(int tix) {
-	return taskLastPartMapped(&((*mpOTasks)[tix]));
+	return mTaskLastPart[tix];
 }
 
 bool CScheduleExt::taskLastPartMapped(CTask* task) {
-	return mTaskLastPart[task->mId];
+	int tix = taskIndex(task);
+	if (tix == -1) {
+		return false;
+	}
+	return mTaskLastPart[tix];
 }
 
 bool CScheduleExt::taskDependencySatisfied(CTask* task) {
-	return mTaskDep[task->mId];
+	int tix = taskIndex(task);
+	if (tix == -1) {
+		return false;
+	}
+	return mTaskDep[tix];
 }
 
 bool CScheduleExt::taskDependencySatisfied(int tix) {
 
-	return taskDependencySatisfied(&((*mpOTasks)[tix]));
+	return mTaskDep[tix];
 }
 
 
@@ -330,11 +388,11 @@ void CScheduleExt::copyEntries(CSchedule* old, int updated) {
 		for (unsigned int tix=0; tix<queue->size(); tix++) {
 			STaskEntry* entry = (*queue)[tix];
 
-			if (mTaskMap.count(entry->taskid) == 0) {
+			int taskix = taskIndexById(entry->taskid);
+			if (taskix == -1) {
 				// task already done
 				continue;
 			}
-			int taskix = mTaskMap[entry->taskid];
 			CTaskCopy* task = &((*mpOTasks)[taskix]);
 
 			unsigned int progress = task->mProgress;
@@ -342,7 +400,7 @@ void CScheduleExt::copyEntries(CSchedule* old, int updated) {
 				// this part is finished
 				continue;
 			}
-			STaskEntry* newentry = new STaskEntry();
+			STaskEntry* newentry = newEntry();
 			newentry->taskcopy = task;
 			newentry->taskid = task->mId;
 			newentry->startProgress = entry->startProgress;
@@ -357,83 +415,46 @@ void CScheduleExt::copyEntries(CSchedule* old, int updated) {
 
 int CScheduleExt::findSlot(int mix, double dur, double start, int startSlot, double* slotStartOut, double* slotStopOut){
 
-	std::vector<STaskEntry*>* queue = (*mpTasks)[mix];
+	SQueueTimes& times = mQueueTimes[mix];
 
-	if (queue->size() == 0) {
+	if (times.ready.size() == 0) {
 		// queue is empty
 		*slotStartOut = start;
 		*slotStopOut = start + dur;
 		return 0;
 	}
 
-	{
-		for(unsigned int qix=0; qix<queue->size(); qix++) {
-			STaskEntry* entry = (*queue)[qix];
-			double entryFinish = entry->timeFinish.count() / 1000000000.0;
-			double entryReady = entry->timeReady.count() / 1000000000.0;
-			CLogger::mainlog->debug("ScheduleExt: findSlot QUEUE ix %d entry taskid %d ready %lf finish %lf",qix, entry->taskid, entryReady, entryFinish);
-		}
+	CGapIndex& index = mGapIndex[mix];
+	if (index.built() == false) {
+		index.build(times.ready, times.finish);
+	}
+	if (index.negativeGaps() > 0 || CLogger::mainlog->isDebugEnabled()) {
+		// finish times are not ordered if entries overlap,
+		// debug output lists the whole queue anyway
+		return findSlotLinear(mix, dur, start, startSlot, slotStartOut, slotStopOut);
 	}
 
-	int slot = -1;
 	double slotStart = 0.0;
-	double slotStop = 0.0;
-	double lastFinish = 0.0;
-	if (startSlot > 0) {
-		STaskEntry* entry = (*queue)[startSlot - 1];
-		lastFinish = entry->timeFinish.count() / 1000000000.0;
-	}
-	for (unsigned int ix=startSlot; ix<queue->size(); ix++) {
-		STaskEntry* entry = (*queue)[ix];
-		double entryFinish = entry->timeFinish.count() / 1000000000.0;
-		double entryReady = entry->timeReady.count() / 1000000000.0;
-		//CLogger::mainlog->debug("ScheduleExt: findSlot ix %d start %lf stop %lf taskid %d", ix, entryReady, entryFinish, entry->taskid);
-		if (entryFinish < start) {
-			// entry ends before start time
-			// no slot before this entry
-			lastFinish = entryFinish;
-			continue;
-		}
-		if (ix == 0) {
-			// first entry
-			if (entryReady == 0.0) {
-				// no slot before first entry
-				lastFinish = entryFinish;
-				continue;
-			}
-			if (entryReady-start >= dur) {
-				// task fits before first slot
-				slot = 0;
-				slotStart = start;
-				slotStop = start + dur;
-				break;
-			}
-		} else {
-			// other entry
-			double newstart = lastFinish;
-			if (newstart < start) {
-				newstart = start;
-			}
-			if (entryReady-newstart >= dur) {
-				CLogger::mainlog->debug("ScheduleExt: slot ix %d lastFinish %lf entryReady %lf task start %lf task dur %lf", ix, lastFinish, entryReady, start, dur);
-				slotStart = newstart;
-				slotStop = slotStart + dur;
-				slot = ix;
-				break;
-			}
-		}
-		lastFinish = entryFinish;
-	}
-	if (slot == -1) {
-		// no slot before machine ready time
-		slot = queue->size();
-		slotStart = lastFinish;
-		if (slotStart < start) {
-			slotStart = start;
+	int slot = index.findSlot(times.ready, times.finish, dur, start, startSlot, &slotStart);
+	*slotStartOut = slotStart;
+	*slotStopOut = slotStart + dur;
+	return slot;
+}
+
+int CScheduleExt::findSlotLinear(int mix, double dur, double start, int startSlot, double* slotStartOut, double* slotStopOut){
+
+	SQueueTimes& times = mQueueTimes[mix];
+
+	if (CLogger::mainlog->isDebugEnabled()) {
+		for(unsigned int qix=0; qix<times.ready.size(); qix++) {
+			CLogger::mainlog->debug("ScheduleExt: findSlot QUEUE ix %d entry taskid %d ready %lf finish %lf",qix, times.taskid[qix], times.ready[qix], times.finish[qix]);
 		}
-		slotStop = slotStart + dur;
 	}
+
+	double slotStart = 0.0;
+	int slot = CGapIndex::findSlotLinear(times.ready, times.finish, dur, start, startSlot, &slotStart);
+	CLogger::mainlog->debug("ScheduleExt: slot ix %d slot start %lf task start %lf task dur %lf", slot, slotStart, start, dur);
 	*slotStartOut = slotStart;
-	*slotStopOut = slotStop;
+	*slotStopOut = slotStart + dur;
 	return slot;
 }
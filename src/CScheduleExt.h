@@ -4,22 +4,55 @@
 #ifndef __CSCHEDULEEXT_H__
 #define __CSCHEDULEEXT_H__
 #include <unordered_map>
+#include <vector>
 #include "CSchedule.h"
+#include "CGapIndex.h"
 
 namespace sched {
 namespace schedule {
 
+	/// @brief Timing data of one resource queue
+	/// Contiguous arrays with one element per queued entry, in queue order.
+	/// The arrays mirror the ready and finish times of the STaskEntry structs in seconds,
+	/// so slot searches do not have to dereference the entries.
+	struct SQueueTimes {
+		std::vector<double> ready; ///< Entry ready times
+		std::vector<double> finish; ///< Entry finish times
+		std::vector<int> taskid; ///< Entry task ids
+	};
+
 	/// @brief Extended schedule class
 	/// The extended schedule class contains additional structures to track task dependencies, task parts and task ready times.
 	class CScheduleExt : public CSchedule {
 
 		public:
 			std::unordered_map<int,int> mTaskMap; ///< global to local index map
-			std::unordered_map<int,bool> mTaskExist; ///< does the task exist in the schedule
-			std::unordered_map<int,bool> mTaskLastPart; ///< is the task's last part in the schedule ?
-			std::unordered_map<int,bool> mTaskDep; ///< are the task dependencies fullfilled?
-			std::unordered_map<int,double> mTaskReady; ///< max finish time of task's all predecessor tasks
-			std::unordered_multimap<int,STaskEntry*> mTaskParts; ///< task's entries in the schedule
+			std::vector<bool> mTaskExist; ///< does the task exist in the schedule, by local index
+			std::vector<bool> mTaskLastPart; ///< is the task's last part in the schedule ?, by local index
+			std::vector<bool> mTaskDep; ///< are the task dependencies fullfilled?, by local index
+			std::vector<double> mTaskReady; ///< max finish time of task's all predecessor tasks, by local index
+			std::vector<STaskEntry*> mTaskParts; ///< first of the task's entries in the schedule, by local index, linked by STaskEntry::nextPart
+
+		private:
+			std::vector<SQueueTimes> mQueueTimes; ///< timing data per resource queue
+			std::vector<CGapIndex> mGapIndex; ///< gap index per resource queue, built by the first findSlot() on the resource
+
+			/// @brief Returns the gap in front of a queued entry
+			inline double entryGap(SQueueTimes& times, int slot) {
+				return (slot == 0 ? 0.0 : times.ready[slot] - times.finish[slot-1]);
+			}
+
+			/// @brief Linear slot search, used if entries of the queue overlap
+			int findSlotLinear(int mix, double dur, double start, int startSlot, double* slotStartOut, double* slotStopOut);
+
+			/// @brief Rebuilds the timing data of all queues from the entries
+			void syncQueueTimes();
+
+			/// @brief Returns the local index of a task
+			/// Copies from the schedule's task list are resolved without lookup.
+			/// @param task Task
+			/// @return Local index or -1 if the task is not part of the schedule
+			int taskIndex(CTask* task);
 
 		public:
 			/// @param tasks
@@ -29,11 +62,35 @@ namespace schedule {
 
 			virtual ~CScheduleExt();
 
+			/// @brief Returns the local index of a task
+			/// @param taskid Task id
+			/// @return Local index or -1 if the task is not part of the schedule
+			int taskIndexById(int taskid);
+
 			/// @brief Returns number of queued entries for the given resource
 			/// @param mix
 			/// @return Number of queued entries
 			int resourceTasks(int mix);
 
+			/// @brief Returns ready time of a queued entry
+			/// @param mix Resource id
+			/// @param slot Entry index in the resource queue
+			/// @return Ready time in seconds
+			inline double entryReadyTime(int mix, int slot) {
+				return mQueueTimes[mix].ready[slot];
+			}
+
+			/// @brief Returns finish time of a queued entry
+			/// @param mix Resource id
+			/// @param slot Entry index in the resource queue
+			/// @return Finish time in seconds
+			inline double entryFinishTime(int mix, int slot) {
+				return mQueueTimes[mix].finish[slot];
+			}
+
+			/// @brief Update timing information in STaskEntry structs and the queue timing data
+			void computeTimes();
+
 			/// @brief Computes the ready task ready.
 			/// The method incorporates predecessors, resource ready time and if the task is already running.
 			/// Note: when using the result one has to keep in mind if the task is already running on the target resource using the taskRunningResource() method. This may influence the execution time of the task.
@@ -109,7 +166,9 @@ namespace schedule {
 			void copyEntries(CSchedule* old, int updated);
 
 			/// @brief Find the next slot that can fit the task
-			/// This method iterates over the queue of the given resource and checks if the break inbetween entries may fit the given task duration.
+			/// This method checks if the break inbetween entries of the given resource may fit the given task duration.
+			/// The first entry that finishes after the start time is found by binary search,
+			/// the following breaks are looked up in the gap index of the resource in O(log n).
 			/// @param mix Resource id
 			/// @param dur Duration of the new entry
 			/// @param start Ready time of the new entry, slot can't start before this time
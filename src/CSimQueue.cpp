@@ -16,16 +16,19 @@
 #include "CScheduleExecutorMain.h"
 #include "CSchedule.h"
 #include "CEstimation.h"
+#include "CEstimationFeedback.h"
 #include "CLogger.h"
 #include "CSimMain.h"
 #include "CConfig.h"
 using namespace sched::sim;
 using sched::schedule::CResource;
+using sched::algorithm::CEstimationFeedback;
 	const char* CSimEvent::eventTypeStrings[] = {
 				"SIMEVENT_NEWTASK",
 				"SIMEVENT_TASK_CHANGE",
 				"SIMEVENT_TIMER_END",
-				"SIMEVENT_ALGO_END"
+				"SIMEVENT_ALGO_END",
+				"SIMEVENT_BATCH_END"
 			};
 
 	const char* CSimTaskState::statusStrings[] = {
@@ -49,6 +52,8 @@ CSimQueue::CSimQueue(std::vector<CResource*>& rResources,CTaskDatabase& rTaskDat
 
 
 	mpEstimation = CEstimation::getEstimation();
+	// simulated tasks do not run in real time, their durations are no valid feedback
+	CEstimationFeedback::setObserve(0);
 
 	this->mSimulationThread = std::thread(&CSimQueue::runSimulation, this);
 }
@@ -62,6 +67,9 @@ int CSimQueue::init(){
 
 
 	mpScheduleComputer->setScheduleExecutor(this);
+	// update requests are batched in simulated time, not by the computer thread
+	mpScheduleComputer->setBatching(false);
+	mpBatchPolicy = &mpScheduleComputer->getBatchPolicy();
 
 	mpScheduleExecutor->setScheduleComputer(this);
 
@@ -900,6 +908,25 @@ void CSimQueue::computeNewSchedule(){
 
 }
 
+void CSimQueue::requestSchedule(){
+
+	if (mpBatchPolicy->enabled() == false) {
+		computeNewSchedule();
+		return;
+	}
+
+	// move the computation to the new due time
+	mpBatchPolicy->arrival(mCurrentTime);
+	removeEventsByType(&mQueue, ESimEventType::SIMEVENT_BATCH_END, true);
+	CSimBatchEndEvent* batchend_event = new CSimBatchEndEvent();
+	batchend_event->time = mpBatchPolicy->due();
+	if (batchend_event->time < mCurrentTime) {
+		batchend_event->time = mCurrentTime;
+	}
+	addEvent(batchend_event);
+
+}
+
 void CSimQueue::executeEvent(CSimEvent* event){
 	switch(event->type) {
 		case ESimEventType::SIMEVENT_NEWTASK:
@@ -940,7 +967,7 @@ void CSimQueue::executeEvent(CSimEvent* event){
 			
 			CLogger::mainlog->info("Simulation: Going to compute new schedule");
 
-			computeNewSchedule();
+			requestSchedule();
 
 		}
 		break;	
@@ -1053,6 +1080,17 @@ void CSimQueue::executeEvent(CSimEvent* event){
 		}
 		break;
 
+		case ESimEventType::SIMEVENT_BATCH_END:
+		{
+			CLogger::simlog->info("\"time\":\"%.9lf\", \"simevent\":\"SIMEVENT_BATCH_END\",\"event\":\"COMPUTER_BATCH\",\"arrivals\":%u,\"predicted\":%f",
+				timeToSec(mCurrentTime),
+				mpBatchPolicy->pending(),
+				mpBatchPolicy->predicted());
+			mpBatchPolicy->start();
+			computeNewSchedule();
+		}
+		break;
+
 		case ESimEventType::SIMEVENT_ALGO_END:
 		{
 			CSimAlgorithmEndEvent* algoend_event = (CSimAlgorithmEndEvent*) event;
@@ -1278,7 +1316,7 @@ void CSimQueue::executorSuspended() {
 
 void CSimQueue::computeSchedule() {
 	CLogger::simlog->info("\"time\":\"%.9lf\",\"simevent\":\"COMPUTER_UPDATE\",\"event\":\"COMPUTER_UPDATE\"", timeToSec(mCurrentTime));
-	computeNewSchedule();	
+	requestSchedule();
 }
 
 int CSimQueue::getRequiredApplicationCount() {
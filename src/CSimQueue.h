@@ -29,6 +29,7 @@ namespace schedule {
 	class CResource;
 	class CScheduleComputerMain;
 	class CSchedule;
+	class CBatchPolicy;
 } }
 
 namespace sched {
@@ -48,6 +49,7 @@ namespace sim {
 	using sched::schedule::CScheduleComputerMain;
 	using sched::schedule::CScheduleExecutorMain;
 	using sched::schedule::CSchedule;
+	using sched::schedule::CBatchPolicy;
 	using sched::schedule::CFeedback;
 	using sched::task::CTaskDatabase;
 	using sched::algorithm::CEstimation;
@@ -83,7 +85,8 @@ namespace sim {
 		SIMEVENT_NEWTASK,
 		SIMEVENT_TASK_CHANGE,
 		SIMEVENT_TIMER_END,
-		SIMEVENT_ALGO_END
+		SIMEVENT_ALGO_END,
+		SIMEVENT_BATCH_END
 	};
 
 	/// @brief Base class for events occuring during simulation
@@ -152,6 +155,16 @@ namespace sim {
 			virtual ~CSimAlgorithmEndEvent(){}
 	};
 
+	/// @brief Event that occurs when the computation for batched update requests is due
+	class CSimBatchEndEvent : public CSimEvent {
+
+		public:
+			CSimBatchEndEvent():
+				CSimEvent(ESimEventType::SIMEVENT_BATCH_END)
+				{}
+			virtual ~CSimBatchEndEvent(){}
+	};
+
 	/// @brief Central class for simulation management
 	class CSimQueue : public CComSchedClient, CScheduleComputer, CScheduleExecutor, CFeedback {
 
@@ -185,6 +198,9 @@ namespace sim {
 			CSchedule* mpNewSchedule;
 			bool mNewScheduleInterrupt;
 
+			// batching of update requests in simulated time
+			CBatchPolicy* mpBatchPolicy = 0; ///< Batch policy of the schedule computer
+
 		private:
 			void runSimulation();
 			void addEvent(CSimEvent* event);
@@ -192,6 +208,8 @@ namespace sim {
 			CSimTaskChangeEvent* findTaskChangeEvent(CTaskWrapper* task);
 			void executeEvent(CSimEvent* event);
 			void computeNewSchedule();
+			/// @brief Computes a new schedule, or delays the computation according to the batch policy
+			void requestSchedule();
 			double timeToSec(std::chrono::steady_clock::time_point time);
 			void getEventsByTime(double time, std::list<CSimQueue*>* events);
 			int countEventsByType(std::list<CSimEvent*>* events, ESimEventType type);
@@ -37,6 +37,7 @@ CTask& CTask::operator=(const CTask& other) {
 	mSize = other.mSize;
 	mCheckpoints = other.mCheckpoints;
 	mProgress = other.mProgress;
+	mExtrapolatedProgress = other.mExtrapolatedProgress;
 	mState = other.mState;
 	mTimes = other.mTimes;
 	mpPredecessorList = other.mpPredecessorList;
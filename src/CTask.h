@@ -48,6 +48,7 @@ namespace task {
 			long mSize = 0; ///< Size parameter
 			long mCheckpoints = 0; ///< Total number of checkpoints
 			long mProgress = 0; ///< Number of finished checkpoints
+			long mExtrapolatedProgress = -1; ///< Progress extrapolated for a late progress response, -1 if none
 			ETaskState mState = ETaskState::PRE; ///< Current task state
 			struct STaskTimes mTimes = {}; ///< Set of task timestamps
 			CResource* mpResource = 0; ///< Pointer to lastly assigned resource
@@ -42,6 +42,10 @@ CTaskCopy& CTaskCopy::operator=(CTask* other){
 		CTask* me = this;
 		*me = *other;
 		this->mpOriginal = other;
+		// schedule computations use the extrapolated progress until the task reports its progress
+		if (mExtrapolatedProgress > mProgress) {
+			mProgress = mExtrapolatedProgress;
+		}
 	}
 
 	return *this;
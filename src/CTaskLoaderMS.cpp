@@ -2,7 +2,12 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
 #include "CTaskLoaderMS.h"
 #include "CTask.h"
 #include "CConfig.h"
@@ -22,6 +27,38 @@ CTaskLoaderMS::CTaskLoaderMS(){
 	} else {
 		mpInfoDir = path_str->c_str();
 		CLogger::mainlog->info("TaskLoaderMS: path %s", mpInfoDir);
+
+		// binary result cache, only with an explicit path,
+		// the directory itself is no place for it, files in the directory would change its mtime
+		std::string* cache_str = 0;
+		res = config->conf->getString((char*)"taskloaderms_cache", &cache_str);
+		if (-1 == res) {
+			CLogger::mainlog->info("TaskLoaderMS: \"taskloaderms_cache\" not found in config, no cache");
+		} else
+		if (strcmp(cache_str->c_str(), "none") != 0) {
+			mCachePath = *cache_str;
+		}
+		if (mCachePath.empty() == false) {
+			CLogger::mainlog->info("TaskLoaderMS: cache %s", mCachePath.c_str());
+		}
+	}
+
+	// regression model for sizes without measurements
+	std::string* regression_str = 0;
+	res = config->conf->getString((char*)"taskloaderms_regression", &regression_str);
+	if (-1 == res) {
+		CLogger::mainlog->info("TaskLoaderMS: \"taskloaderms_regression\" not found in config, using default: piecewise");
+	} else
+	if (strcmp(regression_str->c_str(), "piecewise") == 0) {
+		mRegressionType = REGRESSION_PIECEWISE;
+	} else
+	if (strcmp(regression_str->c_str(), "powerlaw") == 0) {
+		mRegressionType = REGRESSION_POWERLAW;
+	} else
+	if (strcmp(regression_str->c_str(), "none") == 0) {
+		mRegression = 0;
+	} else {
+		CLogger::mainlog->warn("TaskLoaderMS: unknown regression \"%s\", using default: piecewise", regression_str->c_str());
 	}
 }
 
@@ -45,6 +82,13 @@ int CTaskLoaderMS::loadInfo(){
 		return -1;
 	}
 
+	if (loadCache(&dirstat) == 0) {
+		if (mRegression == 1) {
+			fitModels();
+		}
+		return 0;
+	}
+
 	// iterate over all directory entries
 	DIR* dir = opendir(mpInfoDir);
 	if (dir == 0) {
@@ -104,16 +148,188 @@ int CTaskLoaderMS::loadInfo(){
 		return -1;
 	}
 
-	
+	storeCache(&dirstat);
+
+	if (mRegression == 1) {
+		fitModels();
+	}
 
 	return 0;
 }
 
-void CTaskLoaderMS::addTaskInfo(double* info, char* name, int size, char* resource, char* type){
-	
+int CTaskLoaderMS::loadCache(struct stat* dirstat){
+
+	if (mCachePath.empty() == true) {
+		return -1;
+	}
+
+	int fd = open(mCachePath.c_str(), O_RDONLY);
+	if (fd == -1) {
+		CLogger::mainlog->info("TaskLoaderMS: no cache %s: %s", mCachePath.c_str(), strerror(errno));
+		return -1;
+	}
+	struct stat cachestat = {};
+	if (fstat(fd, &cachestat) != 0 || (size_t) cachestat.st_size < sizeof(SMSCacheHeader)) {
+		CLogger::mainlog->warn("TaskLoaderMS: invalid cache %s", mCachePath.c_str());
+		close(fd);
+		return -1;
+	}
+	size_t size = cachestat.st_size;
+	void* cache = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (cache == MAP_FAILED) {
+		CLogger::mainlog->warn("TaskLoaderMS: failed to map cache %s: %s", mCachePath.c_str(), strerror(errno));
+		return -1;
+	}
+
+	// validate cache
+	SMSCacheHeader* header = (SMSCacheHeader*) cache;
+	SMSCacheEntry* entries = (SMSCacheEntry*) (header + 1);
+	const char* strings = (const char*) (entries + header->entries);
+	if (memcmp(header->magic, MSCACHE_MAGIC, sizeof(header->magic)) != 0 ||
+		size != sizeof(SMSCacheHeader) + header->entries * sizeof(SMSCacheEntry) + header->strings ||
+		header->strings == 0 || strings[header->strings-1] != 0) {
+		CLogger::mainlog->warn("TaskLoaderMS: invalid cache %s", mCachePath.c_str());
+		munmap(cache, size);
+		return -1;
+	}
+	if (header->mtimeSec != dirstat->st_mtim.tv_sec ||
+		header->mtimeNsec != dirstat->st_mtim.tv_nsec) {
+		CLogger::mainlog->info("TaskLoaderMS: cache %s is outdated", mCachePath.c_str());
+		munmap(cache, size);
+		return -1;
+	}
+	for (unsigned int i=0; i<header->entries; i++) {
+		if (entries[i].name >= header->strings || entries[i].resource >= header->strings) {
+			CLogger::mainlog->warn("TaskLoaderMS: invalid cache %s", mCachePath.c_str());
+			munmap(cache, size);
+			return -1;
+		}
+	}
+
+	// results are used in place
+	for (unsigned int i=0; i<header->entries; i++) {
+		std::map<std::string, double*>* resmap = getResourceMap(&strings[entries[i].name], entries[i].size);
+		(*resmap)[std::string(&strings[entries[i].resource])] = entries[i].results;
+	}
+	mpCache = cache;
+	mCacheSize = size;
+
+	CLogger::mainlog->info("TaskLoaderMS: loaded %u results from cache %s", header->entries, mCachePath.c_str());
+	return 0;
+}
+
+void CTaskLoaderMS::storeCache(struct stat* dirstat){
+
+	if (mCachePath.empty() == true) {
+		return;
+	}
+
+	// collect entries and strings
+	std::vector<SMSCacheEntry> entries;
+	std::string strings;
+	std::map<std::string, uint32_t> offsets;
+	std::map<std::string, std::map<int, std::map<std::string, double*>*>*>::iterator itname = mInfo.begin();
+	for (; itname != mInfo.end(); itname++) {
+		if (offsets.find(itname->first) == offsets.end()) {
+			offsets[itname->first] = strings.size();
+			strings.append(itname->first.c_str(), itname->first.size() + 1);
+		}
+		std::map<int, std::map<std::string, double*>*>::iterator itsize = itname->second->begin();
+		for (; itsize != itname->second->end(); itsize++) {
+			std::map<std::string, double*>::iterator itres = itsize->second->begin();
+			for (; itres != itsize->second->end(); itres++) {
+				if (offsets.find(itres->first) == offsets.end()) {
+					offsets[itres->first] = strings.size();
+					strings.append(itres->first.c_str(), itres->first.size() + 1);
+				}
+				SMSCacheEntry entry = {};
+				entry.name = offsets[itname->first];
+				entry.resource = offsets[itres->first];
+				entry.size = itsize->first;
+				memcpy(entry.results, itres->second, sizeof(entry.results));
+				entries.push_back(entry);
+			}
+		}
+	}
+	if (strings.empty() == true) {
+		// keep the cache valid
+		strings.push_back(0);
+	}
+
+	SMSCacheHeader header = {};
+	memcpy(header.magic, MSCACHE_MAGIC, sizeof(header.magic));
+	header.entries = entries.size();
+	header.strings = strings.size();
+	header.mtimeSec = dirstat->st_mtim.tv_sec;
+	header.mtimeNsec = dirstat->st_mtim.tv_nsec;
+
+	// write to temporary file and rename, concurrent readers never see a partial cache
+	std::string tmppath = mCachePath + ".XXXXXX";
+	int fd = mkstemp(&tmppath[0]);
+	if (fd == -1) {
+		CLogger::mainlog->warn("TaskLoaderMS: failed to create cache %s: %s", tmppath.c_str(), strerror(errno));
+		return;
+	}
+	// mkstemp creates the file only readable by the owner
+	fchmod(fd, 0644);
+	FILE* file = fdopen(fd, "w");
+	if (file == 0) {
+		CLogger::mainlog->warn("TaskLoaderMS: failed to create cache %s: %s", tmppath.c_str(), strerror(errno));
+		close(fd);
+		unlink(tmppath.c_str());
+		return;
+	}
+	int error = 0;
+	if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+		(entries.empty() == false && fwrite(&entries[0], sizeof(SMSCacheEntry), entries.size(), file) != entries.size()) ||
+		fwrite(strings.data(), 1, strings.size(), file) != strings.size()) {
+		error = 1;
+	}
+	if (fclose(file) != 0) {
+		error = 1;
+	}
+	if (error == 0 && rename(tmppath.c_str(), mCachePath.c_str()) == 0) {
+		CLogger::mainlog->info("TaskLoaderMS: stored %lu results in cache %s", entries.size(), mCachePath.c_str());
+	} else {
+		CLogger::mainlog->warn("TaskLoaderMS: failed to store cache %s: %s", mCachePath.c_str(), strerror(errno));
+		unlink(tmppath.c_str());
+	}
+
+}
+
+void CTaskLoaderMS::fitModels(){
+
+	int models = 0;
+	std::map<std::string, std::map<int, std::map<std::string, double*>*>*>::iterator itname = mInfo.begin();
+	for (; itname != mInfo.end(); itname++) {
+
+		// collect measurements by resource
+		std::map<std::string, std::map<int, double*>> points;
+		std::map<int, std::map<std::string, double*>*>::iterator itsize = itname->second->begin();
+		for (; itsize != itname->second->end(); itsize++) {
+			std::map<std::string, double*>::iterator itres = itsize->second->begin();
+			for (; itres != itsize->second->end(); itres++) {
+				points[itres->first][itsize->first] = itres->second;
+			}
+		}
+
+		std::map<std::string, CRegressionModel*>* modelmap = new std::map<std::string, CRegressionModel*>();
+		mModels[itname->first] = modelmap;
+		std::map<std::string, std::map<int, double*>>::iterator itpoints = points.begin();
+		for (; itpoints != points.end(); itpoints++) {
+			(*modelmap)[itpoints->first] = new CRegressionModel(mRegressionType, itpoints->second);
+			models++;
+		}
+	}
+	CLogger::mainlog->info("TaskLoaderMS: fitted %d regression models", models);
+
+}
+
+std::map<std::string, double*>* CTaskLoaderMS::getResourceMap(const char* name, int size){
+
 	std::map<int, std::map<std::string, double*>*>* sizemap = 0;
 	std::map<std::string, double*>* resmap = 0;
-	double* arr = 0;
 
 	std::map<std::string, std::map<int, std::map<std::string, double*>*>*>::iterator itname = mInfo.find(std::string(name));
 	if (itname != mInfo.end()) {
@@ -132,6 +348,14 @@ void CTaskLoaderMS::addTaskInfo(double* info, char* name, int size, char* resour
 		(*sizemap)[size] = resmap;
 	}
 
+	return resmap;
+}
+
+void CTaskLoaderMS::addTaskInfo(double* info, char* name, int size, char* resource, char* type){
+	
+	std::map<std::string, double*>* resmap = getResourceMap(name, size);
+	double* arr = 0;
+
 	std::map<std::string, double*>::iterator itres = resmap->find(std::string(resource));
 	if (itres != resmap->end()) {
 		arr = itres->second;
@@ -253,8 +477,45 @@ double* CTaskLoaderMS::loadTaskInfo(char* fname){
 
 void CTaskLoaderMS::clearInfo(){
 
-	std::map<std::string, std::map<int, std::map<std::string, double*>*>*>::iterator itname = mInfo.begin();
-	for (;itname!=mInfo.end(); itname++) {
+	// results loaded from the cache are part of the mapping
+	clearInfoMap(mInfo, (mpCache == 0 ? 1 : 0));
+	clearInfoMap(mRegressionInfo, 1);
+	if (mpCache != 0) {
+		munmap(mpCache, mCacheSize);
+		mpCache = 0;
+		mCacheSize = 0;
+	}
+
+	std::map<std::string, std::map<int, std::map<std::string, SMSFeedback*>*>*>::iterator itfeedback = mFeedback.begin();
+	for (; itfeedback != mFeedback.end(); itfeedback++) {
+		std::map<int, std::map<std::string, SMSFeedback*>*>::iterator itsize = itfeedback->second->begin();
+		for (; itsize != itfeedback->second->end(); itsize++) {
+			std::map<std::string, SMSFeedback*>::iterator itres = itsize->second->begin();
+			for (; itres != itsize->second->end(); itres++) {
+				delete itres->second;
+			}
+			delete itsize->second;
+		}
+		delete itfeedback->second;
+	}
+	mFeedback.clear();
+
+	std::map<std::string, std::map<std::string, CRegressionModel*>*>::iterator itname = mModels.begin();
+	for (; itname != mModels.end(); itname++) {
+		std::map<std::string, CRegressionModel*>::iterator itres = itname->second->begin();
+		for (; itres != itname->second->end(); itres++) {
+			delete itres->second;
+		}
+		delete itname->second;
+	}
+	mModels.clear();
+
+}
+
+void CTaskLoaderMS::clearInfoMap(std::map<std::string, std::map<int, std::map<std::string, double*>*>*>& rInfo, int freeResults){
+
+	std::map<std::string, std::map<int, std::map<std::string, double*>*>*>::iterator itname = rInfo.begin();
+	for (;itname!=rInfo.end(); itname++) {
 
 	std::map<int, std::map<std::string, double*>*>* sizemap = itname->second;
 
@@ -266,7 +527,9 @@ void CTaskLoaderMS::clearInfo(){
 			std::map<std::string, double*>::iterator itres = resmap->begin();
 			for(;itres!=resmap->end(); itres++) {
 
-				delete[] itres->second;
+				if (freeResults == 1) {
+					delete[] itres->second;
+				}
 
 			}
 			resmap->clear();
@@ -276,10 +539,75 @@ void CTaskLoaderMS::clearInfo(){
 		delete sizemap;
 
 	}
-	mInfo.clear();
+	rInfo.clear();
 	
 }
 
+std::map<std::string, double*>* CTaskLoaderMS::getRegressionInfo(CTask* task){
+
+	std::map<std::string, std::map<std::string, CRegressionModel*>*>::iterator itmodel = mModels.find(*(task->mpName));
+	if (itmodel == mModels.end()) {
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lg(mInfoMutex);
+
+	std::map<int, std::map<std::string, double*>*>* sizemap = 0;
+	std::map<std::string, std::map<int, std::map<std::string, double*>*>*>::iterator itname = mRegressionInfo.find(*(task->mpName));
+	if (itname != mRegressionInfo.end()) {
+		sizemap = itname->second;
+	} else {
+		sizemap = new std::map<int, std::map<std::string, double*>*>();
+		mRegressionInfo[*(task->mpName)] = sizemap;
+	}
+
+	std::map<int, std::map<std::string, double*>*>::iterator itsize = sizemap->find(task->mSize);
+	if (itsize != sizemap->end()) {
+		return itsize->second;
+	}
+
+	// evaluate models once per size
+	std::map<std::string, double*>* resmap = new std::map<std::string, double*>();
+	std::map<std::string, CRegressionModel*>::iterator itres = itmodel->second->begin();
+	for (; itres != itmodel->second->end(); itres++) {
+		double* arr = new double[CRegressionModel::RESULTS];
+		itres->second->evaluate(task->mSize, arr);
+		(*resmap)[itres->first] = arr;
+	}
+	(*sizemap)[task->mSize] = resmap;
+
+	return resmap;
+}
+
+std::map<std::string, SMSFeedback*>* CTaskLoaderMS::getFeedbackInfo(CTask* task, std::map<std::string, double*>* resmap){
+
+	std::lock_guard<std::mutex> lg(mInfoMutex);
+
+	std::map<int, std::map<std::string, SMSFeedback*>*>* sizemap = 0;
+	std::map<std::string, std::map<int, std::map<std::string, SMSFeedback*>*>*>::iterator itname = mFeedback.find(*(task->mpName));
+	if (itname != mFeedback.end()) {
+		sizemap = itname->second;
+	} else {
+		sizemap = new std::map<int, std::map<std::string, SMSFeedback*>*>();
+		mFeedback[*(task->mpName)] = sizemap;
+	}
+
+	std::map<int, std::map<std::string, SMSFeedback*>*>::iterator itsize = sizemap->find(task->mSize);
+	if (itsize != sizemap->end()) {
+		return itsize->second;
+	}
+
+	// factors start without correction
+	std::map<std::string, SMSFeedback*>* factormap = new std::map<std::string, SMSFeedback*>();
+	std::map<std::string, double*>::iterator itres = resmap->begin();
+	for (; itres != resmap->end(); itres++) {
+		(*factormap)[itres->first] = new SMSFeedback();
+	}
+	(*sizemap)[task->mSize] = factormap;
+
+	return factormap;
+}
+
 void CTaskLoaderMS::getInfo(CTask* task){
 
 	std::map<int, std::map<std::string, double*>*>* sizemap = 0;
@@ -296,12 +624,20 @@ void CTaskLoaderMS::getInfo(CTask* task){
 
 	std::map<int, std::map<std::string, double*>*>::iterator itsize = sizemap->find(task->mSize);
 	if (itsize == sizemap->end()) {
-		CLogger::mainlog->error("TaskLoaderMS: no info for task %s with size %d", task->mpName->c_str(), task->mSize);
+		resmap = getRegressionInfo(task);
+		if (resmap == 0) {
+			CLogger::mainlog->error("TaskLoaderMS: no info for task %s with size %d", task->mpName->c_str(), task->mSize);
+			return;
+		}
+		CLogger::mainlog->warn("TaskLoaderMS: no info for task %s with size %d, using regression", task->mpName->c_str(), task->mSize);
+		(*task->mpAttributes)[std::string("msregression")] = resmap;
+		(*task->mpAttributes)[std::string("msfeedback")] = getFeedbackInfo(task, resmap);
 		return;
 	} else {
 		resmap = itsize->second;
 	}
 
 	(*task->mpAttributes)[std::string("msresults")] = resmap;
+	(*task->mpAttributes)[std::string("msfeedback")] = getFeedbackInfo(task, resmap);
 
 }
@@ -4,10 +4,45 @@
 #ifndef __CTASKLOADERMS_H__
 #define __CTASKLOADERMS_H__
 #include <map>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <sys/stat.h>
 #include "CTaskLoader.h"
+#include "CRegressionModel.h"
+#define MSCACHE_MAGIC "MSCACHE1"
 namespace sched {
 namespace task {
 
+	/// @brief Header of the binary result cache
+	///
+	/// The cache file consists of the header, the result entries and a string table.
+	struct SMSCacheHeader {
+		char magic[8]; ///< File identifier, MSCACHE_MAGIC
+		uint32_t entries; ///< Number of result entries
+		uint32_t strings; ///< Size of the string table in bytes
+		int64_t mtimeSec; ///< Modification time of the result directory, seconds
+		int64_t mtimeNsec; ///< Modification time of the result directory, nanoseconds
+	};
+
+	/// @brief Result entry of the binary result cache
+	struct SMSCacheEntry {
+		uint32_t name; ///< Offset of the task name in the string table
+		uint32_t resource; ///< Offset of the resource name in the string table
+		int64_t size; ///< Task size
+		double results[7]; ///< Averaged measurement results
+	};
+
+	/// @brief Correction of the feedback estimation for one task name, size and resource
+	struct SMSFeedback {
+		std::atomic<double> factor; ///< Correction used by estimations, changes only between schedule computations
+		std::atomic<double> observed; ///< Weighted ratio of observed to estimated duration, copied to factor when applied
+		std::atomic<unsigned int> generation; ///< Estimation generation of the last factor change
+		std::atomic<bool> pending; ///< Observed value is waiting to be applied
+		SMSFeedback() : factor(1.0), observed(1.0), generation(0), pending(false) {}
+	};
+
 	/// @brief Loads task information from CSV files stored by egysched tasks
 	class CTaskLoaderMS : public CTaskLoader {
 
@@ -15,10 +50,47 @@ namespace task {
 			//[name][size][resource]
 			std::map<std::string, std::map<int, std::map<std::string, double*>*>*> mInfo;
 			const char* mpInfoDir = 0;
+			std::string mCachePath; ///< Path of the binary result cache, empty if disabled
+			void* mpCache = 0; ///< Mapped result cache, owns the results in mInfo if set
+			size_t mCacheSize = 0; ///< Size of the mapped result cache
+
+			int mRegression = 1; ///< 1 if regression models are fitted
+			ERegressionType mRegressionType = REGRESSION_PIECEWISE;
+			//[name][resource]
+			std::map<std::string, std::map<std::string, CRegressionModel*>*> mModels;
+			//[name][size][resource], evaluated models for sizes without measurements
+			std::map<std::string, std::map<int, std::map<std::string, double*>*>*> mRegressionInfo;
+			//[name][size][resource], correction factors updated by CEstimationFeedback
+			std::map<std::string, std::map<int, std::map<std::string, SMSFeedback*>*>*> mFeedback;
+			std::mutex mInfoMutex; ///< Protects mRegressionInfo and mFeedback, getInfo may be called concurrently
 
 		private:
 			double* loadTaskInfo(char* fname);
 			void addTaskInfo(double* info, char* name, int size, char* resource, char* type);
+			/// @brief Returns the results by resource for the task name and size, creates missing maps
+			std::map<std::string, double*>* getResourceMap(const char* name, int size);
+			/// @brief Maps the binary result cache and fills mInfo
+			/// @param dirstat Status of the result directory
+			/// @return 0 if the cache is valid and was loaded, else -1
+			int loadCache(struct stat* dirstat);
+			/// @brief Writes mInfo to the binary result cache
+			/// @param dirstat Status of the result directory before loading the results
+			void storeCache(struct stat* dirstat);
+			/// @brief Fits regression models for all task and resource pairs in mInfo
+			void fitModels();
+			/// @brief Returns the evaluated regression models for the task's size
+			/// @param task The given task
+			/// @return Results by resource name or 0 if no models are available
+			std::map<std::string, double*>* getRegressionInfo(CTask* task);
+			/// @brief Returns the shared correction factors for the task's name and size
+			/// @param task The given task
+			/// @param resmap Results by resource name, a factor is created for each resource
+			/// @return Correction factors by resource name
+			std::map<std::string, SMSFeedback*>* getFeedbackInfo(CTask* task, std::map<std::string, double*>* resmap);
+			/// @brief Frees an info map
+			/// @param rInfo The info map
+			/// @param freeResults 1 if the result arrays are freed as well
+			static void clearInfoMap(std::map<std::string, std::map<int, std::map<std::string, double*>*>*>& rInfo, int freeResults);
 
 		public:
 			CTaskLoaderMS();
@@ -0,0 +1,163 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include "CTaskRank.h"
+#include "CTask.h"
+#include "CTaskCopy.h"
+#include "CResource.h"
+#include "CEstimationMatrix.h"
+#include "CScheduleExt.h"
+#include "CLogger.h"
+using namespace sched::algorithm;
+using sched::task::CTask;
+
+
+CTaskRank::CTaskRank(CScheduleExt* sched, std::vector<CResource*>& resources, std::vector<CTaskCopy>* pTasks, CEstimationMatrix* matrix)
+	: mrResources(resources)
+{
+	mpSchedule = sched;
+	mpTasks = pTasks;
+	mpMatrix = matrix;
+}
+
+double CTaskRank::duration(int tix, int mix) {
+
+	return mpMatrix->taskTimeInit(tix, mix) +
+		mpMatrix->taskTimeCompute(tix, mix) +
+		mpMatrix->taskTimeFini(tix, mix);
+
+}
+
+const std::vector<double>& CTaskRank::upwardRanks() {
+
+	int tasks = mpTasks->size();
+	int machines = mrResources.size();
+
+	// average execution costs
+	std::vector<double> w(tasks, 0.0);
+	for (int tix = 0; tix < tasks; tix++) {
+		double tix_w = 0.0;
+		CTask* task = &(*mpTasks)[tix];
+		int validmachines = 0;
+		for (int mix = 0; mix < machines; mix++) {
+			if (task->validResource(mrResources[mix]) == false) {
+				continue;
+			}
+			tix_w += duration(tix, mix);
+			validmachines++;
+		}
+		w[tix] = tix_w / validmachines;
+	}
+
+	// upward ranks
+	// successors follow their predecessors in the task list,
+	// so a backward pass usually computes all ranks at once
+	mUpward.assign(tasks, 0.0);
+	std::vector<bool> done(tasks, false);
+	int changed = 0;
+	do {
+		changed = 0;
+		for (int tix = tasks-1; tix >= 0; tix--) {
+			if (done[tix] == true) {
+				continue;
+			}
+			CTask* task = &(*mpTasks)[tix];
+			// check successors
+			bool unmarked = false;
+			double max_succ_rank = 0.0;
+			for (int succIx = 0; succIx < task->mSuccessorNum; succIx++) {
+				int ix = mpSchedule->taskIndexById(task->mpSuccessorList[succIx]);
+				if (ix == -1) {
+					continue;
+				}
+				if (done[ix] == false) {
+					unmarked = true;
+					break;
+				}
+				if (mUpward[ix] > max_succ_rank) {
+					max_succ_rank = mUpward[ix];
+				}
+			}
+			if (unmarked == true) {
+				continue;
+			}
+			mUpward[tix] = w[tix] + max_succ_rank;
+			done[tix] = true;
+			changed++;
+			CLogger::mainlog->debug("TaskRank: upward rank tix %d tid %d w %f max_succ_rank %f upward %f", tix, task->mId, w[tix], max_succ_rank, mUpward[tix]);
+		}
+	} while (changed > 0);
+
+	return mUpward;
+}
+
+const std::vector<double>& CTaskRank::optimisticCosts() {
+
+	int tasks = mpTasks->size();
+	int machines = mrResources.size();
+
+	mOptimistic.assign(tasks, 0.0);
+	std::vector<bool> done(tasks, false);
+	int changed = 0;
+	do {
+		changed = 0;
+		for (int tix = tasks-1; tix >= 0; tix--) {
+			if (done[tix] == true) {
+				continue;
+			}
+			CTask* task = &(*mpTasks)[tix];
+			bool unmarked = false;
+			double cost = 0.0;
+			for (int succIx = 0; succIx < task->mSuccessorNum; succIx++) {
+				int ix = mpSchedule->taskIndexById(task->mpSuccessorList[succIx]);
+				if (ix == -1) {
+					continue;
+				}
+				if (done[ix] == false) {
+					unmarked = true;
+					break;
+				}
+				// successor on its best resource
+				CTask* succ = &(*mpTasks)[ix];
+				double best = -1.0;
+				for (int mix = 0; mix < machines; mix++) {
+					if (succ->validResource(mrResources[mix]) == false) {
+						continue;
+					}
+					double succCost = mOptimistic[ix] + duration(ix, mix);
+					if (best < 0.0 || succCost < best) {
+						best = succCost;
+					}
+				}
+				if (best > cost) {
+					cost = best;
+				}
+			}
+			if (unmarked == true) {
+				continue;
+			}
+			mOptimistic[tix] = cost;
+			done[tix] = true;
+			changed++;
+			CLogger::mainlog->debug("TaskRank: optimistic cost tix %d tid %d cost %f", tix, task->mId, cost);
+		}
+	} while (changed > 0);
+
+	return mOptimistic;
+}
+
+void CTaskRank::order(const std::vector<double>& rank, std::vector<int>& order) {
+
+	int tasks = mpTasks->size();
+	order.resize(tasks);
+	for (int tix = 0; tix < tasks; tix++) {
+		order[tix] = tix;
+	}
+	std::stable_sort(order.begin(), order.end(),
+		[&rank](int i, int j) {
+			return rank[i] > rank[j];
+		}
+	);
+
+}
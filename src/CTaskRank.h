@@ -0,0 +1,71 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CTASKRANK_H__
+#define __CTASKRANK_H__
+#include <vector>
+namespace sched {
+namespace schedule {
+	class CResource;
+	class CScheduleExt;
+} }
+
+namespace sched {
+namespace task {
+	class CTaskCopy;
+} }
+
+namespace sched {
+namespace algorithm {
+
+	using sched::schedule::CResource;
+	using sched::schedule::CScheduleExt;
+	using sched::task::CTaskCopy;
+
+	class CEstimationMatrix;
+
+	/// @brief Task priorities for the list scheduling heuristics HEFT, Lookahead-HEFT and PEFT
+	///
+	/// The execution time of a task on a resource is the sum of init, compute and fini time.
+	/// Task dependencies carry no transfer costs, successors outside of the task list are ignored.
+	class CTaskRank {
+
+		private:
+			CScheduleExt* mpSchedule;
+			std::vector<CResource*>& mrResources; ///< List of resources
+			std::vector<CTaskCopy>* mpTasks; ///< List of tasks
+			CEstimationMatrix* mpMatrix;
+
+			std::vector<double> mUpward; ///< Upward rank, by task index
+			std::vector<double> mOptimistic; ///< Optimistic cost, by task index
+
+		public:
+			CTaskRank(CScheduleExt* sched, std::vector<CResource*>& resources, std::vector<CTaskCopy>* pTasks, CEstimationMatrix* matrix);
+
+			/// @brief Returns the execution time of a task on a resource
+			/// @param tix Task index
+			/// @param mix Resource index
+			double duration(int tix, int mix);
+
+			/// @brief Computes the upward ranks (HEFT)
+			/// The upward rank is the average execution time over the valid resources
+			/// plus the largest upward rank of the successors.
+			/// @return Upward rank by task index
+			const std::vector<double>& upwardRanks();
+
+			/// @brief Computes the optimistic cost table (PEFT)
+			/// The optimistic cost of a task is the longest path over its successors,
+			/// where each successor runs on its fastest valid resource.
+			/// The table row of a task does not depend on the resource of the task, since dependencies carry no transfer costs.
+			/// @return Optimistic cost by task index
+			const std::vector<double>& optimisticCosts();
+
+			/// @brief Returns the task indices ordered by decreasing rank
+			/// Equal ranks keep the task list order, so predecessors come first.
+			/// @param rank Rank by task index
+			/// @param[out] order Task indices
+			void order(const std::vector<double>& rank, std::vector<int>& order);
+	};
+
+} }
+#endif
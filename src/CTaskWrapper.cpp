@@ -160,6 +160,7 @@ void CTaskWrapper::gotProgress(int progress) {
 	}
 
 	mProgress = progress;
+	mExtrapolatedProgress = -1;
 	CLogger::eventlog->info("\"event\":\"TASK_GOTPROGRESS\",\"id\":%d,\"progress\":%d", mId, progress);
 
 }
@@ -203,6 +204,7 @@ void CTaskWrapper::suspended(int progress){
 
 	mState = ETaskState::SUSPENDED;
 	mProgress = progress;
+	mExtrapolatedProgress = -1;
 	CLogger::eventlog->info("\"event\":\"TASK_SUSPENDED\",\"id\":%d,\"progress\":%d", mId, progress);
 }
 
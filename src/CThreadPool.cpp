@@ -0,0 +1,157 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "CThreadPool.h"
+using namespace sched::algorithm;
+
+// index of the current thread while it runs a loop body, else -1
+static thread_local int tPoolThread = -1;
+
+
+CThreadPool::CThreadPool(unsigned int threads) {
+
+	if (threads == 0) {
+		threads = std::thread::hardware_concurrency();
+	}
+	if (threads == 0) {
+		threads = 1;
+	}
+	mThreads = threads;
+	mPending = 0;
+
+	for (unsigned int tix=0; tix<mThreads; tix++) {
+		mQueues.push_back(new SQueue());
+	}
+	// thread index 0 is the calling thread
+	for (unsigned int tix=1; tix<mThreads; tix++) {
+		mWorkers.push_back(std::thread(&CThreadPool::work, this, tix));
+	}
+}
+
+CThreadPool::~CThreadPool() {
+
+	{
+		std::lock_guard<std::mutex> lg(mWakeMutex);
+		mStop = true;
+	}
+	mWakeCondVar.notify_all();
+	for (unsigned int wix=0; wix<mWorkers.size(); wix++) {
+		mWorkers[wix].join();
+	}
+	for (unsigned int qix=0; qix<mQueues.size(); qix++) {
+		delete mQueues[qix];
+	}
+}
+
+unsigned int CThreadPool::getThreads() {
+	return mThreads;
+}
+
+void CThreadPool::parallelFor(int num, std::function<void(int, unsigned int)> function) {
+
+	if (num <= 0) {
+		return;
+	}
+
+	// nested loops, single threads and single indices run on the current thread
+	if (tPoolThread != -1 || mThreads < 2 || num == 1) {
+		unsigned int thread = tPoolThread != -1 ? tPoolThread : 0;
+		for (int ix=0; ix<num; ix++) {
+			function(ix, thread);
+		}
+		return;
+	}
+
+	std::lock_guard<std::mutex> lg(mLoopMutex);
+
+	// several chunks per thread leave room for stealing
+	int chunkSize = num / (mThreads * 4);
+	if (chunkSize < 1) {
+		chunkSize = 1;
+	}
+	mFunction = function;
+	mPending = (num + chunkSize - 1) / chunkSize;
+
+	int qix = 0;
+	for (int begin=0; begin<num; begin+=chunkSize) {
+		SChunk chunk;
+		chunk.begin = begin;
+		chunk.end = begin + chunkSize < num ? begin + chunkSize : num;
+		SQueue* queue = mQueues[qix];
+		{
+			std::lock_guard<std::mutex> qlg(queue->mutex);
+			queue->chunks.push_back(chunk);
+		}
+		qix = (qix + 1) % mThreads;
+	}
+
+	{
+		std::lock_guard<std::mutex> wlg(mWakeMutex);
+		mLoop++;
+	}
+	mWakeCondVar.notify_all();
+
+	tPoolThread = 0;
+	runChunks(0);
+	tPoolThread = -1;
+
+	// wait for chunks still running on workers
+	std::unique_lock<std::mutex> ul(mWakeMutex);
+	mDoneCondVar.wait(ul, [this]{ return mPending == 0; });
+}
+
+void CThreadPool::work(unsigned int thread) {
+
+	tPoolThread = thread;
+	unsigned long seen = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> ul(mWakeMutex);
+			mWakeCondVar.wait(ul, [this, &seen]{ return mStop == true || mLoop != seen; });
+			if (mStop == true) {
+				return;
+			}
+			seen = mLoop;
+		}
+		runChunks(thread);
+	}
+}
+
+void CThreadPool::runChunks(unsigned int thread) {
+
+	SChunk chunk;
+	while (takeChunk(thread, &chunk) == true) {
+		for (int ix=chunk.begin; ix<chunk.end; ix++) {
+			mFunction(ix, thread);
+		}
+		if (--mPending == 0) {
+			std::lock_guard<std::mutex> lg(mWakeMutex);
+			mDoneCondVar.notify_all();
+		}
+	}
+}
+
+bool CThreadPool::takeChunk(unsigned int thread, SChunk* chunk) {
+
+	// own queue first
+	SQueue* own = mQueues[thread];
+	{
+		std::lock_guard<std::mutex> lg(own->mutex);
+		if (own->chunks.empty() == false) {
+			*chunk = own->chunks.front();
+			own->chunks.pop_front();
+			return true;
+		}
+	}
+	// steal from the other end of other queues
+	for (unsigned int off=1; off<mThreads; off++) {
+		SQueue* victim = mQueues[(thread + off) % mThreads];
+		std::lock_guard<std::mutex> lg(victim->mutex);
+		if (victim->chunks.empty() == false) {
+			*chunk = victim->chunks.back();
+			victim->chunks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
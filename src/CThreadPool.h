@@ -0,0 +1,85 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef __CTHREADPOOL_H__
+#define __CTHREADPOOL_H__
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace sched {
+namespace algorithm {
+
+	/// @brief Work-stealing thread pool for data-parallel loops of scheduling algorithms
+	///
+	/// The calling thread takes part in every loop, so a pool with n threads starts n-1 worker threads.
+	/// A loop is split into chunks that are distributed over per-thread queues.
+	/// Threads take chunks from the front of their own queue and steal from the back of other queues once their queue is empty.
+	/// Each thread has a fixed index, which can be used to select per-thread scratch buffers.
+	/// Loops started from inside a loop body run serially on the current thread.
+	class CThreadPool {
+
+		private:
+			/// @brief Range of loop indices
+			struct SChunk {
+				int begin;
+				int end;
+			};
+
+			/// @brief Chunk queue of one thread
+			struct SQueue {
+				std::mutex mutex;
+				std::deque<SChunk> chunks;
+			};
+
+			unsigned int mThreads; ///< Number of threads including the calling thread
+			std::vector<std::thread> mWorkers;
+			std::vector<SQueue*> mQueues; ///< Chunk queue per thread
+
+			std::mutex mLoopMutex; ///< Serializes loops started from different threads
+			std::function<void(int, unsigned int)> mFunction; ///< Body of the current loop
+			std::atomic<int> mPending; ///< Chunks of the current loop that are not finished
+
+			std::mutex mWakeMutex;
+			std::condition_variable mWakeCondVar; ///< Signals a new loop or shutdown to the workers
+			std::condition_variable mDoneCondVar; ///< Signals the end of the current loop
+			unsigned long mLoop = 0; ///< Number of started loops
+			bool mStop = false;
+
+			/// @brief Worker thread main loop
+			/// @param thread Thread index
+			void work(unsigned int thread);
+
+			/// @brief Runs chunks of the current loop until no chunk is left
+			/// @param thread Thread index
+			void runChunks(unsigned int thread);
+
+			/// @brief Takes a chunk from the own queue or steals one from another queue
+			/// @param thread Thread index
+			/// @param[out] chunk Taken chunk
+			/// @return True if a chunk was taken, false if all queues are empty
+			bool takeChunk(unsigned int thread, SChunk* chunk);
+
+		public:
+			/// @param threads Number of threads including the calling thread, 0 uses one thread per core
+			CThreadPool(unsigned int threads);
+			~CThreadPool();
+
+			CThreadPool(const CThreadPool&) = delete;
+			CThreadPool& operator=(const CThreadPool&) = delete;
+
+			/// @brief Returns the number of threads including the calling thread
+			unsigned int getThreads();
+
+			/// @brief Calls the function for all indices in [0,num) and returns once all calls are finished
+			/// The order of the calls is undefined.
+			/// @param num Number of indices
+			/// @param function Loop body, called with the loop index and the index of the executing thread
+			void parallelFor(int num, std::function<void(int, unsigned int)> function);
+	};
+
+} }
+#endif
@@ -0,0 +1,83 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "CGapIndex.h"
+using sched::schedule::CGapIndex;
+
+namespace {
+
+	/// @brief Returns the gap in front of a queued entry, as CScheduleExt
+	double entryGap(std::vector<double>& ready, std::vector<double>& finish, int slot) {
+		return (slot == 0 ? 0.0 : ready[slot] - finish[slot-1]);
+	}
+
+	/// @brief Compares the indexed and the linear slot search for one query
+	/// @return 0 if both agree, else 1
+	int check(CGapIndex& index, std::vector<double>& ready, std::vector<double>& finish, double dur, double start, int startSlot, const char* what) {
+		double indexStart = 0.0;
+		double linearStart = 0.0;
+		int indexSlot = index.findSlot(ready, finish, dur, start, startSlot, &indexStart);
+		int linearSlot = CGapIndex::findSlotLinear(ready, finish, dur, start, startSlot, &linearStart);
+		if (indexSlot != linearSlot || indexStart != linearStart) {
+			printf("FAIL %s: entries %u dur %f start %f startSlot %d: findSlot %d at %f, findSlotLinear %d at %f\n",
+				what, (unsigned int)ready.size(), dur, start, startSlot, indexSlot, indexStart, linearSlot, linearStart);
+			return 1;
+		}
+		return 0;
+	}
+
+}
+
+int main() {
+
+	int failed = 0;
+	int queries = 0;
+	std::mt19937 rng(123456);
+	// durations and times on a coarse grid, so gaps of exactly the task duration and empty gaps are frequent
+	std::uniform_int_distribution<int> durDist(0, 8);
+	std::uniform_int_distribution<int> startDist(0, 120);
+
+	for (int queue = 0; queue < 50 && failed == 0; queue++) {
+		std::vector<double> ready;
+		std::vector<double> finish;
+		CGapIndex index;
+		index.build(ready, finish);
+
+		for (int step = 0; step < 60 && failed == 0; step++) {
+			// queries against the incrementally updated index and a rebuilt one
+			CGapIndex rebuilt;
+			rebuilt.build(ready, finish);
+			for (int q = 0; q < 20; q++) {
+				double dur = durDist(rng) * 0.5;
+				double start = startDist(rng) * 0.5;
+				int startSlot = (ready.size() == 0 ? 0 : rng() % (ready.size() + 1));
+				failed += check(index, ready, finish, dur, start, startSlot, "incremental");
+				failed += check(rebuilt, ready, finish, dur, start, startSlot, "rebuilt");
+				queries++;
+			}
+
+			// insert an entry like the list schedulers do, updating the index like CScheduleExt::addEntry
+			double dur = durDist(rng) * 0.5;
+			double start = startDist(rng) * 0.5;
+			double slotStart = 0.0;
+			int slot = CGapIndex::findSlotLinear(ready, finish, dur, start, 0, &slotStart);
+			ready.insert(ready.begin() + slot, slotStart);
+			finish.insert(finish.begin() + slot, slotStart + dur);
+			index.insert(slot, entryGap(ready, finish, slot));
+			if (slot + 1 < (int) ready.size()) {
+				index.set(slot + 1, entryGap(ready, finish, slot + 1));
+			}
+			if (index.negativeGaps() != 0) {
+				printf("FAIL insert: negative gaps in non-overlapping queue\n");
+				failed++;
+			}
+		}
+	}
+
+	printf("%d queries, %d failed\n", queries, failed);
+	return (failed == 0 ? 0 : 1);
+
+}
@@ -0,0 +1,73 @@
+// Copyright 2019, Alex Wiens <awiens@mail.upb.de>, Achim Lösch <achim.loesch@upb.de>
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include "CLPSolver.h"
+using sched::algorithm::CLPSolver;
+
+namespace {
+
+	/// @brief Model with expected solver result
+	struct SCase {
+		const char* name;
+		const char* model;
+		int status;
+		double objective; ///< Only compared for optimal results
+	};
+
+	const SCase sCases[] = {
+		// bounded, variables with artificial bounds end on their real bounds
+		{"bounded_upper_at_zero", "max: 3x+2y; c1: x+y<=3; x<=3;", CLPSolver::LP_OPTIMAL, 9.0},
+		{"bounded_interior", "max: 2x + 3y; c1: x + y <= 4; c2: x + 3y <= 6; x <= 3;", CLPSolver::LP_OPTIMAL, 9.0},
+		{"bounded_lower_at_zero", "min: -x - y; c1: x <= 2; c2: x + y <= 2;", CLPSolver::LP_OPTIMAL, -2.0},
+		{"bounded_free", "min: x + y; c1: x + y >= 2; c2: x - y <= 1; x >= -1e30; y >= -1e30;", CLPSolver::LP_OPTIMAL, 2.0},
+		{"bounded_free_negative", "max: x; c1: x <= -4; x >= -1e30;", CLPSolver::LP_OPTIMAL, -4.0},
+		{"bounded_range", "min: x + 2y + 3; c1: 2 <= x + y <= 6; c2: x <= 1;", CLPSolver::LP_OPTIMAL, 6.0},
+		// unbounded
+		{"unbounded_max", "max: x + y; c1: x - y <= 1;", CLPSolver::LP_UNBOUNDED, 0.0},
+		{"unbounded_free", "min: x; c1: x + y >= 1; x >= -1e30;", CLPSolver::LP_UNBOUNDED, 0.0},
+		// infeasible
+		{"infeasible_rows", "min: x; c1: x + y >= 5; c2: x + y <= 3;", CLPSolver::LP_INFEASIBLE, 0.0},
+		{"infeasible_bounds", "min: x; x >= 5; x <= 3;", CLPSolver::LP_INFEASIBLE, 0.0},
+		{"infeasible_integer", "max: x; c1: 2x = 3; int x;", CLPSolver::LP_INFEASIBLE, 0.0},
+		// integer
+		{"integer", "max: 5x + 4y; c1: 6x + 4y <= 24; c2: x + 2y <= 6; int x, y;", CLPSolver::LP_OPTIMAL, 20.0},
+		{"integer_binary", "max: 10a + 13b + 7c; c1: 4a + 6b + 3c <= 10; bin a, b, c;", CLPSolver::LP_OPTIMAL, 23.0},
+		{"integer_mixed", "min: -x - 2y; c1: x + y <= 3.5; c2: y <= 2.5; int y;", CLPSolver::LP_OPTIMAL, -5.5},
+	};
+
+}
+
+int main() {
+
+	int failed = 0;
+	int count = sizeof(sCases) / sizeof(sCases[0]);
+	CLPSolver solver;
+	for (int i = 0; i < count; i++) {
+		const SCase& c = sCases[i];
+		std::istringstream in(c.model);
+		if (solver.read(in) == -1) {
+			printf("FAIL %s: syntax error\n", c.name);
+			failed++;
+			continue;
+		}
+		solver.setTimeout(0);
+		int status = solver.solve();
+		if (status != c.status) {
+			printf("FAIL %s: status %d, expected %d\n", c.name, status, c.status);
+			failed++;
+			continue;
+		}
+		if (status == CLPSolver::LP_OPTIMAL && std::fabs(solver.getObjective() - c.objective) > 1e-6*(1.0+std::fabs(c.objective))) {
+			printf("FAIL %s: objective %f, expected %f\n", c.name, solver.getObjective(), c.objective);
+			failed++;
+			continue;
+		}
+		printf("ok %s\n", c.name);
+	}
+	printf("%d / %d\n", count-failed, count);
+	return (failed == 0 ? 0 : 1);
+
+}